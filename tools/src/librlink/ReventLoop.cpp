@@ -1,9 +1,12 @@
 // $Id: ReventLoop.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.5.1  EpollUpdate(): fds refused with EPERM handled by poll()
+// 2026-10-18  1220   1.5    time poll handlers with RcallProf (CallHandler())
+// 2026-10-18  1212   1.4    add epoll backend with incremental registration
 // 2019-05-17  1150   1.3    BUGFIX: don't call handler when fUpdatePoll true
 // 2018-12-19  1090   1.2.6  use RosPrintf(bool)
 // 2018-12-18  1089   1.2.5  use c++ style casts
@@ -25,14 +28,18 @@
 
 #include <string.h>
 #include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
 #include <errno.h>
 
 #include <mutex>
+#include <algorithm>
 
 #include "librtools/Rexception.hpp"
 #include "librtools/RosPrintf.hpp"
 #include "librtools/RosFill.hpp"
 #include "librtools/RlogMsg.hpp"
+#include "librtools/Rtime.hpp"
 
 #include "ReventLoop.hpp"
 
@@ -41,6 +48,19 @@ using namespace std;
 /*!
   \class Retro::ReventLoop
   \brief FIXME_docs
+
+  Two backends are available and selected at construction:
+  - kBackendPoll: the handler list is converted into a pollfd list whenever
+    it changed, and after each poll() all entries are scanned.
+  - kBackendEpoll: handlers are registered and removed incrementally with
+    epoll_ctl(), only the ready descriptors are dispatched. In this case
+    fPollFd holds only the epoll fd itself, so derived event loops can
+    still use fPollFd.size() to detect an empty handler list.
+
+  When epoll is not available the poll backend is used as fallback. Some
+  descriptors, e.g. regular files, can't be registered with epoll_ctl(),
+  it fails with EPERM. Those are kept in fEpollPollFd and polled together
+  with the epoll fd.
 */
 
 // all method definitions in namespace Retro
@@ -49,22 +69,40 @@ namespace Retro {
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
-ReventLoop::ReventLoop()
+ReventLoop::ReventLoop(backend be)
   : fStopPending(false),
     fUpdatePoll(false),
     fPollDscMutex(),
     fPollDsc(),
     fPollFd(),
     fPollHdl(),
+    fPollProf(),
+    fBackend(be),
+    fEpollFd(-1),
+    fEpollEvt(),
+    fEpollNEvt(0),
+    fEpollPfd(),
+    fEpollPollFd(),
     fTraceLevel(0),
     fspLog()
-{}
+{
+  if (fBackend == kBackendEpoll) {
+    fEpollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (fEpollFd < 0) {
+      fBackend = kBackendPoll;              // fallback to poll()
+    } else {
+      fEpollEvt.resize(64);
+    }
+  }
+}
 
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
 ReventLoop::~ReventLoop()
-{}
+{
+  if (fEpollFd >= 0) ::close(fEpollFd);
+}
 
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
@@ -72,7 +110,8 @@ ReventLoop::~ReventLoop()
 // by default handlers should start with: 
 //     if (pfd.revents & (~pfd.events)) return -1;
 
-void ReventLoop::AddPollHandler(pollhdl_t&& pollhdl, int fd, short events)
+void ReventLoop::AddPollHandler(pollhdl_t&& pollhdl, int fd, short events,
+                                RcallProf* pprof)
 {
   lock_guard<mutex> lock(fPollDscMutex);
   
@@ -84,8 +123,9 @@ void ReventLoop::AddPollHandler(pollhdl_t&& pollhdl, int fd, short events)
     }
   }
 
-  fPollDsc.emplace_back(move(pollhdl),fd,events);
+  fPollDsc.emplace_back(move(pollhdl),fd,events,pprof);
   fUpdatePoll = true;
+  if (fBackend == kBackendEpoll) EpollUpdate(fd);
 
   if (fspLog && fTraceLevel >= 1) {
     RlogMsg lmsg(*fspLog, 'I');
@@ -107,6 +147,7 @@ void ReventLoop::RemovePollHandler(int fd, short events, bool nothrow)
         fPollDsc[i].fEvents == events) {
       fPollDsc.erase(fPollDsc.begin()+i);
       fUpdatePoll = true;
+      if (fBackend == kBackendEpoll) EpollUpdate(fd);
       if (fspLog && fTraceLevel >= 1) {
         RlogMsg lmsg(*fspLog, 'I');
         lmsg << "eloop: remove handler: " << fd << "," << RosPrintf(events,"x");
@@ -148,6 +189,7 @@ void ReventLoop::RemovePollHandler(int fd)
       i--;                                  // re-probe this index
     }
   }
+  if (fBackend == kBackendEpoll) EpollUpdate(fd);
   return;
 }
 
@@ -185,6 +227,10 @@ void ReventLoop::Dump(std::ostream& os, int ind, const char* text,
   os << bl << (text?text:"--") << "ReventLoop @ " << this << endl;
   os << bl << "  fStopPending:    " << RosPrintf(fStopPending) << endl;
   os << bl << "  fUpdatePoll:     " << RosPrintf(fUpdatePoll) << endl;
+  os << bl << "  fBackend:        " 
+     << (fBackend==kBackendEpoll ? "epoll" : "poll") << endl;
+  os << bl << "  fEpollFd:        " << fEpollFd << endl;
+  os << bl << "  fEpollPollFd:    " << fEpollPollFd.size() << endl;
   {
     lock_guard<mutex> lock(const_cast<ReventLoop*>(this)->fPollDscMutex);
     os << bl << "  fPollDsc.size:   " << fPollDsc.size() << endl;
@@ -209,6 +255,8 @@ void ReventLoop::Dump(std::ostream& os, int ind, const char* text,
 
 int ReventLoop::DoPoll(int timeout)
 {
+  if (fBackend == kBackendEpoll) return DoEpoll(timeout);
+
   int irc = 0;
   do {
     if (fUpdatePoll) {
@@ -216,11 +264,13 @@ int ReventLoop::DoPoll(int timeout)
     
       fPollFd.resize(fPollDsc.size());
       fPollHdl.resize(fPollDsc.size());
+      fPollProf.resize(fPollDsc.size());
       for (size_t i=0; i<fPollDsc.size(); i++) {
         fPollFd[i].fd      = fPollDsc[i].fFd;
         fPollFd[i].events  = fPollDsc[i].fEvents;
         fPollFd[i].revents = 0;
         fPollHdl[i] = fPollDsc[i].fHandler;
+        fPollProf[i] = fPollDsc[i].fpProf;
       }
       fUpdatePoll = false;
       
@@ -258,10 +308,15 @@ int ReventLoop::DoPoll(int timeout)
 
 void ReventLoop::DoCall(void)
 {
+  if (fBackend == kBackendEpoll) {
+    DoEpollCall();
+    return;
+  }
+
   for (size_t i=0; i<fPollFd.size(); i++) {
     if (fUpdatePoll) break;
     if (fPollFd[i].revents) {      
-      int irc = fPollHdl[i](fPollFd[i]);
+      int irc = CallHandler(fPollHdl[i], fPollProf[i], fPollFd[i]);
       // remove handler on negative return (nothrow=true to prevent remove race)
       if (irc < 0) {
         if (fspLog && fTraceLevel >= 1) {
@@ -278,4 +333,198 @@ void ReventLoop::DoCall(void)
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Call poll handler \a hdl, account call time in \a pprof if given
+
+int ReventLoop::CallHandler(const pollhdl_t& hdl, RcallProf* pprof,
+                            const pollfd& pfd)
+{
+  if (!pprof) return hdl(pfd);
+  Rtime tbeg(CLOCK_MONOTONIC);
+  int irc = hdl(pfd);
+  pprof->Add(double(Rtime(CLOCK_MONOTONIC) - tbeg));
+  return irc;
+}
+
+//------------------------------------------+-----------------------------------
+//! Wait for events with epoll_wait().
+/*!
+  fPollFd holds the epoll fd, followed by the descriptors in fEpollPollFd.
+  It is only updated when the handler list changed and is empty when no
+  handler is registered. When fEpollPollFd isn't empty poll() waits for
+  all of them and epoll_wait() only collects the events of the epoll set.
+ */
+
+int ReventLoop::DoEpoll(int timeout)
+{
+  if (fUpdatePoll) {
+    lock_guard<mutex> lock(fPollDscMutex);
+    fPollFd.clear();
+    if (!fPollDsc.empty()) {
+      fPollFd.push_back(pollfd{fEpollFd, POLLIN, 0});
+      for (auto fd: fEpollPollFd) {
+        short events = 0;
+        for (auto& o: fPollDsc) {
+          if (o.fFd == fd) events |= o.fEvents;
+        }
+        fPollFd.push_back(pollfd{fd, events, 0});
+      }
+    }
+    fUpdatePoll = false;
+  }
+  
+  fEpollNEvt = 0;
+  if (fPollFd.size() == 0) return 0;
+  for (auto& o: fPollFd) o.revents = 0;
+
+  int npoll = 0;
+  if (fPollFd.size() > 1) {                 // poll() handled fds present
+    npoll = poll(fPollFd.data(), fPollFd.size(), timeout);
+    if (npoll < 0 && errno == EINTR) return 0;
+    if (npoll < 0) 
+      throw Rexception("ReventLoop::EventLoop()", "poll() failed: ", errno);
+    if (fPollFd[0].revents == 0) return npoll; // epoll set not ready
+    npoll -= 1;
+    timeout = 0;
+  }
+
+  int irc = ::epoll_wait(fEpollFd, fEpollEvt.data(), int(fEpollEvt.size()),
+                         timeout);
+  if (irc < 0 && errno == EINTR) return npoll;
+  if (irc < 0) 
+    throw Rexception("ReventLoop::EventLoop()", "epoll_wait() failed: ",
+                     errno);
+
+  fEpollNEvt = irc;
+  fPollFd[0].revents = (irc > 0) ? POLLIN : 0;
+  irc += npoll;
+
+  if (fspLog && fTraceLevel >= 2) {
+    RlogMsg lmsg(*fspLog, 'I');
+    lmsg << "eloop: epoll_wait(): rc=" << irc;
+    for (int i=0; i<fEpollNEvt; i++) {
+      lmsg << " (" << fEpollEvt[i].data.fd
+           << "," << RosPrintf(fEpollEvt[i].events,"x") << ")";
+    }
+  }
+
+  return irc;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call the handlers of the descriptors reported ready by DoEpoll().
+/*!
+  As with poll(), the dispatch stops when the handler list changed; epoll
+  is level-triggered, so not yet handled events are reported again.
+ */
+
+void ReventLoop::DoEpollCall(void)
+{
+  for (int i=0; i<fEpollNEvt; i++) {
+    if (fUpdatePoll) break;
+    EpollDispatch(fEpollEvt[i].data.fd, short(fEpollEvt[i].events));
+  }
+  for (size_t i=1; i<fPollFd.size(); i++) {
+    if (fUpdatePoll) break;
+    if (fPollFd[i].revents) EpollDispatch(fPollFd[i].fd, fPollFd[i].revents);
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call the handlers of \a fd for events \a revents.
+/*!
+  The handlers are looked up when the event is dispatched, so a handler
+  removed after epoll_wait() is not called. Each handler sees \c revents
+  restricted to its \c events plus the error conditions, just like with
+  poll().
+ */
+
+void ReventLoop::EpollDispatch(int fd, short revents)
+{
+  fPollHdl.clear();
+  fPollProf.clear();
+  fEpollPfd.clear();
+  {
+    lock_guard<mutex> lock(fPollDscMutex);
+    for (auto& o: fPollDsc) {
+      if (o.fFd != fd) continue;
+      short rmask = o.fEvents | POLLERR | POLLHUP | POLLNVAL;
+      if ((revents & rmask) == 0) continue;
+      fPollHdl.push_back(o.fHandler);
+      fPollProf.push_back(o.fpProf);
+      fEpollPfd.push_back(pollfd{fd, o.fEvents, short(revents & rmask)});
+    }
+  }
+
+  for (size_t j=0; j<fPollHdl.size(); j++) {
+    const pollfd& pfd = fEpollPfd[j];
+    int irc = CallHandler(fPollHdl[j], fPollProf[j], pfd);
+    // remove handler on negative return (nothrow=true to prevent remove race)
+    if (irc < 0) {
+      if (fspLog && fTraceLevel >= 1) {
+        RlogMsg lmsg(*fspLog, 'I');
+        lmsg << "eloop: handler(" << pfd.fd 
+             << "," << RosPrintf(pfd.events,"x")
+             << ") got " << RosPrintf(pfd.revents,"x")
+             << " and requested removal";
+      }
+      RemovePollHandler(pfd.fd, pfd.events, true);
+    }
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Update the epoll registration of \a fd, fPollDscMutex must be held.
+/*!
+  The events of all handlers of \a fd are or'ed, poll and epoll use the
+  same bit values for POLLIN/EPOLLIN and friends. The fd is removed from
+  the epoll set when no handler is left. When epoll_ctl() refuses the fd
+  with EPERM it is added to fEpollPollFd and handled by poll().
+ */
+
+void ReventLoop::EpollUpdate(int fd)
+{
+  uint32_t events = 0;
+  bool     found  = false;
+  for (auto& o: fPollDsc) {
+    if (o.fFd != fd) continue;
+    events |= uint16_t(o.fEvents);
+    found   = true;
+  }
+
+  epoll_event evt;
+  ::memset(&evt, 0, sizeof(evt));
+  evt.events  = events;
+  evt.data.fd = fd;
+
+  auto it = find(fEpollPollFd.begin(), fEpollPollFd.end(), fd);
+  bool inpoll = it != fEpollPollFd.end();
+
+  if (!found) {                             // no handler left -> remove
+    if (inpoll) {
+      fEpollPollFd.erase(it);
+      return;
+    }
+    // fd might be already closed, which implicitly removed it, so ignore
+    ::epoll_ctl(fEpollFd, EPOLL_CTL_DEL, fd, &evt);
+    return;
+  }
+  if (inpoll) return;                       // events taken by DoEpoll()
+  
+  int irc = ::epoll_ctl(fEpollFd, EPOLL_CTL_MOD, fd, &evt);
+  if (irc < 0 && errno == ENOENT) {         // not yet registered -> add
+    irc = ::epoll_ctl(fEpollFd, EPOLL_CTL_ADD, fd, &evt);
+  }
+  if (irc < 0 && errno == EPERM) {          // not supported (regular file)
+    fEpollPollFd.push_back(fd);             // -> use poll() for this fd
+    return;
+  }
+  if (irc < 0) 
+    throw Rexception("ReventLoop::EpollUpdate()", "epoll_ctl() failed: ",
+                     errno);
+  return;
+}
+
 } // end namespace Retro
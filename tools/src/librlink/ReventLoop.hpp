@@ -1,9 +1,12 @@
 // $Id: ReventLoop.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.3.1  add EpollDispatch(),fEpollPollFd
+// 2026-10-18  1220   1.4    AddPollHandler(): add optional call profile
+// 2026-10-18  1212   1.3    add epoll backend, Backend()
 // 2018-12-17  1085   1.2.6  use std::mutex instead of boost
 // 2018-12-16  1084   1.2.5  use =delete for noncopyable instead of boost
 // 2018-12-15  1083   1.2.4  AddPollHandler(): use rval ref and move
@@ -25,6 +28,7 @@
 #define included_Retro_ReventLoop 1
 
 #include <poll.h>
+#include <sys/epoll.h>
 
 #include <cstdint>
 #include <vector>
@@ -33,6 +37,7 @@
 #include <mutex>
 
 #include "librtools/RlogFile.hpp"
+#include "librtools/RcallProf.hpp"
 
 namespace Retro {
 
@@ -40,14 +45,20 @@ namespace Retro {
     public:
       typedef std::function<int(const pollfd&)> pollhdl_t;
 
-                    ReventLoop();
+      enum backend {
+        kBackendPoll = 0,                   //!< use poll()
+        kBackendEpoll                       //!< use epoll (default)
+      };
+
+      explicit      ReventLoop(backend be=kBackendEpoll);
       virtual      ~ReventLoop();
 
                     ReventLoop(const ReventLoop&) = delete; // noncopyable 
       ReventLoop&   operator=(const ReventLoop&) = delete;  // noncopyable
  
       void          AddPollHandler(pollhdl_t&& pollhdl,
-                               int fd, short events=POLLIN);
+                               int fd, short events=POLLIN,
+                               RcallProf* pprof=nullptr);
       bool          TestPollHandler(int fd, short events=POLLIN);
       void          RemovePollHandler(int fd, short events, bool nothrow=false);
       void          RemovePollHandler(int fd);
@@ -55,6 +66,7 @@ namespace Retro {
       void          SetLogFile(const std::shared_ptr<RlogFile>& splog);
       void          SetTraceLevel(uint32_t level);
       uint32_t      TraceLevel() const;
+      backend       Backend() const;
 
       void          Stop();
       void          UnStop();
@@ -68,6 +80,12 @@ namespace Retro {
 
       int           DoPoll(int timeout=-1);
       void          DoCall(void);
+      int           CallHandler(const pollhdl_t& hdl, RcallProf* pprof,
+                                const pollfd& pfd);
+      int           DoEpoll(int timeout);
+      void          DoEpollCall(void);
+      void          EpollDispatch(int fd, short revents);
+      void          EpollUpdate(int fd);
 
     protected: 
 
@@ -75,8 +93,9 @@ namespace Retro {
         pollhdl_t   fHandler;
         int         fFd;
         short       fEvents;
-        PollDsc(pollhdl_t hdl,int fd,short evts) :
-          fHandler(hdl),fFd(fd),fEvents(evts)  {}
+        RcallProf*  fpProf;                 //!< call profile (or nullptr)
+        PollDsc(pollhdl_t hdl,int fd,short evts,RcallProf* pprof) :
+          fHandler(hdl),fFd(fd),fEvents(evts),fpProf(pprof)  {}
       };
 
       bool          fStopPending;
@@ -85,6 +104,13 @@ namespace Retro {
       std::vector<PollDsc>   fPollDsc;
       std::vector<pollfd>    fPollFd;
       std::vector<pollhdl_t> fPollHdl;
+      std::vector<RcallProf*> fPollProf;    //!< call profiles for fPollHdl
+      backend       fBackend;               //!< poll or epoll backend
+      int           fEpollFd;               //!< epoll fd (-1 if poll backend)
+      std::vector<epoll_event> fEpollEvt;   //!< epoll: ready events
+      int           fEpollNEvt;             //!< epoll: number of ready events
+      std::vector<pollfd> fEpollPfd;        //!< epoll: pollfd's for handlers
+      std::vector<int> fEpollPollFd;        //!< epoll: fds handled by poll()
       uint32_t      fTraceLevel;            //!< trace level
       std::shared_ptr<RlogFile>  fspLog;    //!< log file ptr
 };
@@ -4,6 +4,7 @@
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1212   1.3    add Backend()
 // 2018-12-07  1078   1.2.1  use std::shared_ptr instead of boost
 // 2015-04-04   662   1.2    BUGFIX: fix race in Stop(), add UnStop,StopPending
 // 2013-05-01   513   1.1.1  fTraceLevel now uint32_t
@@ -70,5 +71,13 @@ inline uint32_t ReventLoop::TraceLevel() const
   return fTraceLevel;
 }
 
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline ReventLoop::backend ReventLoop::Backend() const
+{
+  return fBackend;
+}
+
 } // end namespace Retro
 
@@ -1,9 +1,10 @@
 // $Id: RlinkCommand.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1211   1.5    add Reset()
 // 2019-03-10  1121   1.4.3  Print(): use BlockDone() as length for rblk data
 // 2018-12-23  1091   1.4.2  CmdWblk(),SetBlockWrite(): add move version
 // 2018-12-19  1090   1.4.1  use RosPrintf(bool)
@@ -126,6 +127,32 @@ RlinkCommand::RlinkCommand(const RlinkCommand& rhs)
 RlinkCommand::~RlinkCommand()
 {}
 
+//------------------------------------------+-----------------------------------
+//! Reset to the state after default construction.
+/*!
+  The capacity of the internal data vector is kept, so a command can be
+  re-used without heap allocations, see RlinkCommandList::Clear().
+ */
+
+void RlinkCommand::Reset()
+{
+  fRequest         = 0;
+  fAddress         = 0;
+  fData            = 0;
+  fBlock.clear();
+  fpBlockExt       = nullptr;
+  fBlockExtSize    = 0;
+  fBlockDone       = 0;
+  fStatus          = 0;
+  fFlags           = 0;
+  fRcvSize         = 0;
+  fExpectStatusSet = false;
+  fExpectStatusVal = 0;
+  fExpectStatusMsk = 0x0;
+  fupExpect.reset();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -1,9 +1,10 @@
 // $Id: RlinkCommand.hpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1211   1.5    add Reset()
 // 2019-03-10  1121   1.4.3  add BlockDoneAll()
 // 2018-12-24  1092   1.4.2  rename IsBlockExt -> HasBlockExt
 // 2018-12-23  1091   1.4.1  CmdWblk(),SetBlockWrite(): add move version
@@ -52,6 +53,7 @@ namespace Retro {
                     RlinkCommand(const RlinkCommand& rhs);
                    ~RlinkCommand();
  
+      void          Reset();
       void          CmdRreg(uint16_t addr);
       void          CmdRblk(uint16_t addr, size_t size);
       void          CmdRblk(uint16_t addr, uint16_t* pblock, size_t size);
@@ -1,9 +1,11 @@
 // $Id: RlinkCommandList.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1211   1.5    keep commands in deque, re-used after Clear();
+//                           add NextCommand()
 // 2018-12-23  1091   1.4.2  AddWblk(): add move version
 // 2018-12-07  1077   1.4.1  SetLastExpectBlock: add move versions
 // 2018-12-01  1076   1.4    use unique_ptr
@@ -25,6 +27,7 @@
  */
 
 #include <string>
+#include <stdexcept>
 
 #include "RlinkCommandList.hpp"
 
@@ -37,6 +40,12 @@ using namespace std;
 /*!
   \class Retro::RlinkCommandList
   \brief FIXME_docs
+
+  The commands are kept in a deque owned by the list. Clear() only resets
+  the size, the command objects and their data vectors are re-used by the
+  next Add...() calls. A list which is cleared and re-filled, e.g. in a
+  handler called for each attention, thus runs without heap allocations
+  once the list has reached its working size.
 */
 
 // all method definitions in namespace Retro
@@ -47,16 +56,16 @@ namespace Retro {
 
 RlinkCommandList::RlinkCommandList()
   : fList(),
+    fSize(0),
     fLaboIndex(-1)
-{
-  fList.reserve(16);                        // should prevent most re-alloc's
-}
+{}
 
 //------------------------------------------+-----------------------------------
 //! Copy constructor
 
 RlinkCommandList::RlinkCommandList(const RlinkCommandList& rhs)
   : fList(),
+    fSize(0),
     fLaboIndex(-1)
 {
   operator=(rhs);
@@ -73,9 +82,8 @@ RlinkCommandList::~RlinkCommandList()
 
 size_t RlinkCommandList::AddCommand(cmd_uptr_t&& upcmd)
 {
-  size_t ind = fList.size();
-  fList.push_back(move(upcmd));
-  return ind;
+  NextCommand() = *upcmd;
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -83,7 +91,8 @@ size_t RlinkCommandList::AddCommand(cmd_uptr_t&& upcmd)
 
 size_t RlinkCommandList::AddCommand(const RlinkCommand& cmd)
 {
-  return AddCommand(cmd_uptr_t(new RlinkCommand(cmd)));
+  NextCommand() = cmd;
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -91,8 +100,9 @@ size_t RlinkCommandList::AddCommand(const RlinkCommand& cmd)
 
 size_t RlinkCommandList::AddCommand(const RlinkCommandList& clist)
 {
-  size_t ind = fList.size();
-  for (auto& upcmd: clist.fList) AddCommand(*upcmd);
+  size_t ind  = fSize;
+  size_t size = clist.fSize;                // clist can be *this
+  for (size_t i=0; i<size; i++) AddCommand(clist.fList[i]);
   return ind;
 }
 
@@ -101,9 +111,8 @@ size_t RlinkCommandList::AddCommand(const RlinkCommandList& clist)
 
 size_t RlinkCommandList::AddRreg(uint16_t addr)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdRreg(addr);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdRreg(addr);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -111,9 +120,8 @@ size_t RlinkCommandList::AddRreg(uint16_t addr)
 
 size_t RlinkCommandList::AddRblk(uint16_t addr, size_t size)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdRblk(addr, size);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdRblk(addr, size);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -121,9 +129,8 @@ size_t RlinkCommandList::AddRblk(uint16_t addr, size_t size)
 
 size_t RlinkCommandList::AddRblk(uint16_t addr, uint16_t* block, size_t size)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdRblk(addr, block, size);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdRblk(addr, block, size);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -131,9 +138,8 @@ size_t RlinkCommandList::AddRblk(uint16_t addr, uint16_t* block, size_t size)
 
 size_t RlinkCommandList::AddWreg(uint16_t addr, uint16_t data)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdWreg(addr, data);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdWreg(addr, data);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -142,9 +148,8 @@ size_t RlinkCommandList::AddWreg(uint16_t addr, uint16_t data)
 size_t RlinkCommandList::AddWblk(uint16_t addr,
                                  const std::vector<uint16_t>& block)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdWblk(addr, block);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdWblk(addr, block);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -152,9 +157,8 @@ size_t RlinkCommandList::AddWblk(uint16_t addr,
 
 size_t RlinkCommandList::AddWblk(uint16_t addr, std::vector<uint16_t>&& block)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdWblk(addr, move(block));
-  return AddCommand(move(upcmd));
+  NextCommand().CmdWblk(addr, move(block));
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -163,9 +167,8 @@ size_t RlinkCommandList::AddWblk(uint16_t addr, std::vector<uint16_t>&& block)
 size_t RlinkCommandList::AddWblk(uint16_t addr, const uint16_t* block,
                                  size_t size)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdWblk(addr, block, size);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdWblk(addr, block, size);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -173,9 +176,8 @@ size_t RlinkCommandList::AddWblk(uint16_t addr, const uint16_t* block,
 
 size_t RlinkCommandList::AddLabo()
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdLabo();
-  return AddCommand(move(upcmd));
+  NextCommand().CmdLabo();
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -183,9 +185,8 @@ size_t RlinkCommandList::AddLabo()
 
 size_t RlinkCommandList::AddAttn()
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdAttn();
-  return AddCommand(move(upcmd));
+  NextCommand().CmdAttn();
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -193,9 +194,8 @@ size_t RlinkCommandList::AddAttn()
 
 size_t RlinkCommandList::AddInit(uint16_t addr, uint16_t data)
 {
-  cmd_uptr_t upcmd(new RlinkCommand());
-  upcmd->CmdInit(addr, data);
-  return AddCommand(move(upcmd));
+  NextCommand().CmdInit(addr, data);
+  return fSize++;
 }
 
 //------------------------------------------+-----------------------------------
@@ -203,10 +203,10 @@ size_t RlinkCommandList::AddInit(uint16_t addr, uint16_t data)
 
 void RlinkCommandList::SetLastExpectStatus(uint8_t stat, uint8_t statmsk)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectStatus()",
                      "Bad state: list empty");
-  fList.back()->SetExpectStatus(stat, statmsk);
+  fList[fSize-1].SetExpectStatus(stat, statmsk);
   return;
 }
 
@@ -215,10 +215,10 @@ void RlinkCommandList::SetLastExpectStatus(uint8_t stat, uint8_t statmsk)
 
 void RlinkCommandList::SetLastExpectData(uint16_t data, uint16_t datamsk)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectData()",
                      "Bad state: list empty");
-  RlinkCommand& cmd = *fList.back();
+  RlinkCommand& cmd = fList[fSize-1];
   cmd.EnsureExpect().SetData(data, datamsk);
   return;
 }
@@ -228,10 +228,10 @@ void RlinkCommandList::SetLastExpectData(uint16_t data, uint16_t datamsk)
 
 void RlinkCommandList::SetLastExpectDone(uint16_t done)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectDone()",
                      "Bad state: list empty");
-  RlinkCommand& cmd = *fList.back();
+  RlinkCommand& cmd = fList[fSize-1];
   cmd.EnsureExpect().SetDone(done);
   return;
 }
@@ -241,10 +241,10 @@ void RlinkCommandList::SetLastExpectDone(uint16_t done)
 
 void RlinkCommandList::SetLastExpectBlock(const std::vector<uint16_t>& block)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectBlock()",
                      "Bad state: list empty");
-  RlinkCommand& cmd = *fList.back();
+  RlinkCommand& cmd = fList[fSize-1];
   cmd.EnsureExpect().SetBlock(block);
   return;
 }
@@ -254,10 +254,10 @@ void RlinkCommandList::SetLastExpectBlock(const std::vector<uint16_t>& block)
 
 void RlinkCommandList::SetLastExpectBlock(std::vector<uint16_t>&& block)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectBlock()",
                      "Bad state: list empty");
-  RlinkCommand& cmd = *fList.back();
+  RlinkCommand& cmd = fList[fSize-1];
   cmd.EnsureExpect().SetBlock(move(block));
   return;
 }
@@ -268,10 +268,10 @@ void RlinkCommandList::SetLastExpectBlock(std::vector<uint16_t>&& block)
 void RlinkCommandList::SetLastExpectBlock(const std::vector<uint16_t>& block,
                                           const std::vector<uint16_t>& blockmsk)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectBlock()",
                      "Bad state: list empty");
-  RlinkCommand& cmd = *fList.back();
+  RlinkCommand& cmd = fList[fSize-1];
   cmd.EnsureExpect().SetBlock(block, blockmsk);
   return;
 }
@@ -282,10 +282,10 @@ void RlinkCommandList::SetLastExpectBlock(const std::vector<uint16_t>& block,
 void RlinkCommandList::SetLastExpectBlock(std::vector<uint16_t>&& block,
                                           std::vector<uint16_t>&& blockmsk)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpectBlock()",
                      "Bad state: list empty");
-  RlinkCommand& cmd = *fList.back();
+  RlinkCommand& cmd = fList[fSize-1];
   cmd.EnsureExpect().SetBlock(move(block), move(blockmsk));
   return;
 }
@@ -295,10 +295,10 @@ void RlinkCommandList::SetLastExpectBlock(std::vector<uint16_t>&& block,
 
 void RlinkCommandList::SetLastExpect(exp_uptr_t&& upexp)
 {
-  if (fList.empty())
+  if (fSize == 0)
     throw Rexception("RlinkCommandList::SetLastExpect()",
                      "Bad state: list empty");
-  fList.back()->SetExpect(move(upexp));
+  fList[fSize-1].SetExpect(move(upexp));
   return;
 }
 
@@ -307,7 +307,7 @@ void RlinkCommandList::SetLastExpect(exp_uptr_t&& upexp)
 
 void RlinkCommandList::Clear()
 {
-  fList.clear();
+  fSize      = 0;                           // keep commands for re-use
   fLaboIndex = -1;
   return;
 }
@@ -319,7 +319,9 @@ void RlinkCommandList::Print(std::ostream& os,
                              const RlinkAddrMap* pamap, size_t abase, 
                              size_t dbase, size_t sbase) const
 {
-  for (auto& upcmd: fList) upcmd->Print(os, pamap, abase, dbase, sbase);
+  for (size_t i=0; i<fSize; i++) {
+    fList[i].Print(os, pamap, abase, dbase, sbase);
+  }
   return;
 }
 
@@ -337,10 +339,10 @@ void RlinkCommandList::Dump(std::ostream& os, int ind, const char* text,
     if (detail >= 0) {                      // full dump
       string pref("fList[");
       pref << RosPrintf(i) << RosPrintf("]: ");
-      fList[i]->Dump(os, ind+2, pref.c_str());
+      fList[i].Dump(os, ind+2, pref.c_str());
     } else {                                // compact dump
       os << bl << "  [" << RosPrintf(i,"d",2) << "]: " 
-         << fList[i]->CommandInfo() << endl;
+         << fList[i].CommandInfo() << endl;
     }
   }
   
@@ -355,8 +357,8 @@ RlinkCommandList&
 {
   if (&rhs == this) return *this;
 
-  fList.clear();
-  for (auto& upcmd: rhs.fList) AddCommand(*upcmd);
+  Clear();
+  for (size_t i=0; i<rhs.fSize; i++) AddCommand(rhs.fList[i]);
   fLaboIndex = rhs.fLaboIndex;
   return *this;
 }
@@ -366,7 +368,8 @@ RlinkCommandList&
 
 Retro::RlinkCommand& Retro::RlinkCommandList::operator[](size_t ind)
 {
-  return *fList.at(ind);
+  if (ind >= fSize) throw out_of_range("RlinkCommandList::operator[]");
+  return fList[ind];
 }
 
 //------------------------------------------+-----------------------------------
@@ -374,7 +377,26 @@ Retro::RlinkCommand& Retro::RlinkCommandList::operator[](size_t ind)
 
 const Retro::RlinkCommand& Retro::RlinkCommandList::operator[](size_t ind) const
 {
-  return *fList.at(ind);
+  if (ind >= fSize) throw out_of_range("RlinkCommandList::operator[]");
+  return fList[ind];
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns the command slot after the end of the list, in reset state.
+/*!
+  An existing command object is re-used if available, otherwise a new one
+  is created. The list size is not changed, the caller increments fSize
+  after the command was successfully setup.
+ */
+
+RlinkCommand& RlinkCommandList::NextCommand()
+{
+  if (fSize == fList.size()) {
+    fList.emplace_back();
+  } else {
+    fList[fSize].Reset();
+  }
+  return fList[fSize];
 }
 
 } // end namespace Retro
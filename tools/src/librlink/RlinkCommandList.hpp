@@ -1,9 +1,10 @@
 // $Id: RlinkCommandList.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1211   1.5    keep commands in deque, re-used after Clear()
 // 2018-12-23  1091   1.4.2  AddWblk(): add move version
 // 2018-12-07  1077   1.4.1  SetLastExpectBlock: add move versions
 // 2018-12-01  1076   1.4    use unique_ptr
@@ -27,6 +28,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include <deque>
 #include <iostream>
 #include <memory>
 
@@ -90,8 +92,12 @@ namespace Retro {
       RlinkCommand& operator[](size_t ind);
       const RlinkCommand& operator[](size_t ind) const;
 
+    protected:
+      RlinkCommand& NextCommand();
+
     protected: 
-      std::vector<cmd_uptr_t> fList;        //!< vector of commands
+      std::deque<RlinkCommand> fList;       //!< command store (size >= fSize)
+      size_t        fSize;                  //!< number of commands in list
       int           fLaboIndex;             //!< index of active labo (-1 if no)
   };
 
@@ -1,9 +1,10 @@
 // $Id: RlinkCommandList.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2014 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1211   1.3    use fSize
 // 2014-11-23   606   1.2    new rlink v4 iface
 // 2013-05-06   495   1.0.1  add RlinkContext to Print() args; drop oper<<()
 // 2011-03-05   366   1.0    Initial version
@@ -57,7 +58,7 @@ inline bool RlinkCommandList::LaboActive() const
 
 inline size_t RlinkCommandList::Size() const
 {
-  return fList.size();
+  return fSize;
 }
 
 } // end namespace Retro
@@ -1,9 +1,23 @@
 // $Id: RlinkConnect.cpp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   2.20   per packet class rtt and size histograms
+// 2026-10-18  1227   2.19   re-arm async timer in SetServer(), cancel when idle
+// 2026-10-18  1227   2.18   use Rstats::DefineLogHist()
+// 2026-10-18  1227   2.17   add server timer enforcing ExecAsync() timeout
+// 2026-10-18  1219   2.16   LogOpen(): share log files via RlogFileCatalog
+// 2026-10-18  1218   2.15   add busy-poll: SetSpinTime(), spin= url option
+// 2026-10-18  1210   2.14   receive rblk data streamed into BlockPointer()
+// 2026-10-18  1209   2.13   EncodeRequest(): send wblk data zero-copy
+// 2026-10-18  1208   2.12   add adaptive block size, BlockSizeAuto() and co
+// 2026-10-18  1207   2.11   add histograms for rtt, packet and block sizes
+// 2026-10-18  1205   2.10   add ExecAsync(),ExecAsyncWait(); factor out
+//                           ExecSetup(),ExecFinish() from Exec()
+// 2026-10-18  1202   2.9    add windowed Exec: ExecSplit(), (Set)ExecWindow();
+//                           ReadResponse(): process pending data first
 // 2019-07-27  1198   2.8.6  add Nak handling
 // 2019-03-10  1121   2.8.5  DecodeResponse(): rblk expect check over BlockDone
 // 2018-12-22  1091   2.8.4  Open():  (-Wpessimizing-move fix); add BadPort()
@@ -53,6 +67,7 @@
 #include "librtools/Rtools.hpp"
 #include "librtools/Rexception.hpp"
 #include "librtools/RlogMsg.hpp"
+#include "librtools/RlogFileCatalog.hpp"
 #include "RlinkServer.hpp"
 
 #include "RlinkConnect.hpp"
@@ -93,6 +108,10 @@ const uint16_t RlinkConnect::kSBCNTL_V_RBMON;
 
 const uint16_t RlinkConnect::kRbufBlkDelta;
 const uint16_t RlinkConnect::kRbufPrudentDelta;
+const size_t   RlinkConnect::kExecWindowMax;
+const size_t   RlinkConnect::kBlockSizeAutoMin;
+const size_t   RlinkConnect::kBlockSizeAutoNLvl;
+const size_t   RlinkConnect::kBlockSizeAutoInit;
 
 //------------------------------------------+-----------------------------------
 //! Default constructor
@@ -108,6 +127,8 @@ RlinkConnect::RlinkConnect()
     fContext(),
     fAddrMap(),
     fStats(),
+    fHistStats(),
+    fHistPkt(),
     fLogBaseAddr(16),                       // addr default radix: hex
     fLogBaseData(16),                       // data default radix: hex
     fLogBaseStat(16),                       // stat default radix: hex
@@ -115,13 +136,21 @@ RlinkConnect::RlinkConnect()
     fDumpLevel(0),                          // default dump: no
     fTraceLevel(0),                         // default trace: no
     fTimeout(10.),                          // default timeout: 10 sec
+    fExecWindow(1),                         // default: one packet per Exec
+    fSpinTime(0),
+    fAsyncList(),
+    fAsyncNSnd(0),
+    fAsyncTimer(0),
     fspLog(new RlogFile(&cout)),
+    fLogShared(false),
     fConnectMutex(),
     fAttnNotiPatt(0),
     fTsLastAttnNoti(),
     fSysId(0xffffffff),
     fUsrAcc(0x00000000),
     fRbufSize(2048),
+    fBsAutoLvl(kBlockSizeAutoInit),
+    fBsAutoRate{},
     fHasRbmon(false)
 {
   fContext.SetStatus(0, RlinkCommand::kStat_M_RbTout |
@@ -131,6 +160,11 @@ RlinkConnect::RlinkConnect()
   // Statistic setup
   fStats.Define(kStatNExec,     "NExec",     "Exec() calls");
   fStats.Define(kStatNExecPart, "NExecPart", "ExecPart() calls");
+  fStats.Define(kStatNExecSplit,    "NExecSplit",    "ExecSplit() calls");
+  fStats.Define(kStatNExecSplitPkt, "NExecSplitPkt", "ExecSplit() packets send");
+  fStats.Define(kStatNExecAsync,    "NExecAsync",    "ExecAsync() calls");
+  fStats.Define(kStatNExecAsyncDrain,"NExecAsyncDrain","ExecAsync() lists drained");
+  fStats.Define(kStatNExecAsyncTout,"NExecAsyncTout","ExecAsync() response timeouts");
   fStats.Define(kStatNCmd,      "NCmd",      "commands executed");
   fStats.Define(kStatNRreg,     "NRreg",     "rreg commands");
   fStats.Define(kStatNRblk,     "NRblk",     "rblk commands");
@@ -154,6 +188,35 @@ RlinkConnect::RlinkConnect()
   fStats.Define(kStatNErrLen,   "NErrLen",   "decode: length mismatch");
   fStats.Define(kStatNErrCrc,   "NErrCrc",   "decode: crc mismatch");
   fStats.Define(kStatNErrNak,   "NErrNak",   "decode: nak seen");
+  fStats.Define(kStatNBsAutoGrow,  "NBsAutoGrow",  "auto block size increased");
+  fStats.Define(kStatNBsAutoShrink,"NBsAutoShrink","auto block size decreased");
+
+  // Histogram setup
+  fHistStats.DefineLogHist(kHistRtt,      "HRtt",     "pkt rtt",
+                           "usec", 0x3f, 0x3ffff);
+  fHistStats.DefineLogHist(kHistSndByte,  "HSndByte", "pkt snd size",
+                           "byte", 0x0f, 0xffff);
+  fHistStats.DefineLogHist(kHistRcvByte,  "HRcvByte", "pkt rcv size",
+                           "byte", 0x0f, 0xffff);
+  fHistStats.DefineLogHist(kHistPktCmd,   "HPktCmd",  "pkt commands",
+                           "cmd",  0x01, 0xff);
+  fHistStats.DefineLogHist(kHistRblkWord, "HRblk",    "rblk size",
+                           "word", 0x0f, 0xffff);
+  fHistStats.DefineLogHist(kHistWblkWord, "HWblk",    "wblk size",
+                           "word", 0x0f, 0xffff);
+  // per packet class: packets with only one command type, or mixed
+  static const char* clsname[kNHistCls] = {"Rreg","Rblk","Wreg","Wblk",
+                                           "Labo","Attn","Mix"};
+  for (size_t i=0; i<kNHistCls; i++) {
+    size_t ind = kHistCls + i*kDimHistCls;
+    string cls = clsname[i];
+    string txt = string("pkt ") + (i==kHistClsMix ? "mixed" : 
+                                   RlinkCommand::CommandName(uint8_t(i)));
+    fHistStats.DefineLogHist(ind+kHistClsRtt,  "HRtt"+cls,  txt+" rtt",
+                             "usec", 0x3f, 0x3ffff);
+    fHistStats.DefineLogHist(ind+kHistClsByte, "HByte"+cls, txt+" size",
+                             "byte", 0x0f, 0xffff);
+  }
 }
 
 //------------------------------------------+-----------------------------------
@@ -179,6 +242,17 @@ bool RlinkConnect::Open(const std::string& name, RerrMsg& emsg)
   Port().SetLogFile(fspLog);
   Port().SetTraceLevel(fTraceLevel);
 
+  string spin;                              // handle spin=usec option
+  if (Port().Url().FindOpt("spin", spin)) {
+    unsigned long usec;
+    if (!Rtools::String2Long(spin, usec, emsg)) {
+      Close();
+      return false;
+    }
+    fSpinTime = uint32_t(usec);
+  }
+  Port().SetSpinTime(fSpinTime);
+
   fLinkInitDone = false;
   fRbufSize = 2048;                         // use minimum (2kB) as startup
   fSysId    = 0xffffffff;
@@ -208,6 +282,19 @@ void RlinkConnect::Close()
     fSndPkt.SndKeep(Port(), emsg);
   }
 
+  if (!fAsyncList.empty()) {
+    RlogMsg lmsg(*fspLog, 'W');
+    lmsg << "Close: " << fAsyncList.size() << " ExecAsync() lists discarded";
+    fAsyncList.clear();
+    fAsyncNSnd = 0;
+  }
+  if (fAsyncTimer != 0) {
+    if (fpServ) fpServ->CancelTimer(fAsyncTimer);
+    fAsyncTimer = 0;
+  }
+  fHistPkt.clear();
+  fRcvPkt.ClearBlocks();
+
   fupPort.reset();
     
   return;
@@ -249,6 +336,8 @@ bool RlinkConnect::LinkInit(RerrMsg& emsg)
   uint16_t rlid0  = clist[iid0].Data();
 
   fRbufSize = size_t(1) << (10 + (rlstat & kRLSTAT_M_RBSize));
+  fBsAutoLvl = kBlockSizeAutoInit;          // restart block size tuning
+  for (auto& o: fBsAutoRate) o = 0.;
   fSysId    = uint32_t(rlid1)<<16 | uint32_t(rlid0);
 
   // handle rlink optional registers: USR_ACCESS and rbus monitor probe
@@ -273,6 +362,24 @@ bool RlinkConnect::LinkInit(RerrMsg& emsg)
   return true;
 }
   
+//------------------------------------------+-----------------------------------
+//! Set or clear the server attached to this connection.
+/*!
+  A pending ExecAsync() deadline timer belongs to the timer wheel of the
+  previous server, it is cancelled and re-armed with the new server.
+ */
+
+void RlinkConnect::SetServer(RlinkServer* pserv)
+{
+  if (fAsyncTimer != 0) {
+    if (fpServ) fpServ->CancelTimer(fAsyncTimer);
+    fAsyncTimer = 0;
+  }
+  fpServ = pserv;
+  AsyncTimerArm();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! Indicates whether server is active.
 /*!
@@ -349,87 +456,20 @@ bool RlinkConnect::Exec(RlinkCommandList& clist, RlinkContext& cntx,
 
   fStats.Inc(kStatNExec);
 
-  clist.ClearLaboIndex();
-
-  uint8_t defstatval = cntx.StatusValue();
-  uint8_t defstatmsk = cntx.StatusMask();
-  size_t size = clist.Size();
+  ExecSetup(clist, cntx);
 
-  for (size_t i=0; i<size; i++) {
-    RlinkCommand& cmd = clist[i];
-   if (!cmd.TestFlagAny(RlinkCommand::kFlagInit))
-     throw Rexception("RlinkConnect::Exec()", 
-                      "BugCheck: command not initialized");
-    if (cmd.Command() > RlinkCommand::kCmdInit)
-      throw Rexception("RlinkConnect::Exec()", 
-                       "BugCheck: invalid command code");
-    // trap attn command when server running and outside server thread
-    if (cmd.Command() == RlinkCommand::kCmdAttn && ServerActiveOutside())
-      throw Rexception("RlinkConnect::Exec()", 
-                       "attn command not allowed outside active server");
-    
-    cmd.ClearFlagBit(RlinkCommand::kFlagSend   | 
-                     RlinkCommand::kFlagDone   |
-                     RlinkCommand::kFlagLabo   |
-                     RlinkCommand::kFlagPktBeg | 
-                     RlinkCommand::kFlagPktEnd |
-                     RlinkCommand::kFlagErrNak | 
-                     RlinkCommand::kFlagErrDec);
-    
-    // setup default status check unless explicit check defined
-    if (!cmd.ExpectStatusSet()) {
-      cmd.SetExpectStatusDefault(defstatval, defstatmsk);
-    }
-  }
-  
-  // old split volative logic. Currently dormant
-  // may be later used for rtbuf size prot
-#ifdef NEVER
-  while (ibeg < size) {
-    size_t iend = ibeg;
-    for (size_t i=ibeg; i<size; i++) {
-      iend = i;
-      if (clist[i].TestFlagAll(RlinkCommand::kFlagVol)) {
-        fStats.Inc(kStatNSplitVol);
-        break;
-      }
-    }
-    bool rc = ExecPart(clist, ibeg, iend, emsg);
-    if (!rc) return rc;
-    ibeg = iend+1;
-  }
-#endif
+  // complete all outstanding ExecAsync() lists first, keeps request order
+  if (!fAsyncList.empty() && !AsyncDrain(emsg)) return false;
 
-  bool rc = ExecPart(clist, 0, size-1, emsg);
+  // if a send window is enabled, the list is split into packets which fit
+  // into the rbuf and several of them are kept in flight; otherwise the
+  // whole list is send as one packet, caller must ensure that it fits.
+  size_t size = clist.Size();
+  bool rc = (fExecWindow > 1) ? ExecSplit(clist, emsg) :
+                                ExecPart(clist, 0, size-1, emsg);
   if (!rc) return rc;
 
-  bool checkseen = false;
-  bool errorseen = false;
-
-  for (size_t i=0; i<size; i++) {
-    RlinkCommand& cmd = clist[i];
-    
-    bool checkfound = cmd.TestFlagAny(RlinkCommand::kFlagChkStat | 
-                                      RlinkCommand::kFlagChkData |
-                                      RlinkCommand::kFlagChkDone);
-    bool errorfound = cmd.TestFlagAny(RlinkCommand::kFlagErrNak | 
-                                      RlinkCommand::kFlagErrDec);
-    checkseen |= checkfound;
-    errorseen |= errorfound;
-    if (checkfound | errorfound) cntx.IncErrorCount();
-  }
-
-  size_t loglevel = 3;
-  if (checkseen) loglevel = 2;
-  if (errorseen) loglevel = 1;
-  if (loglevel <= fPrintLevel) {
-    RlogMsg lmsg(*fspLog);
-    clist.Print(lmsg(), &AddrMap(), fLogBaseAddr, fLogBaseData, fLogBaseStat);
-  }
-  if (loglevel <= fDumpLevel) {
-    RlogMsg lmsg(*fspLog);
-    clist.Dump(lmsg(), 0);
-  }
+  ExecFinish(clist, cntx);
   
   return true;
 }
@@ -452,6 +492,86 @@ void RlinkConnect::Exec(RlinkCommandList& clist, RlinkContext& cntx)
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Queue a command list for asynchronous execution.
+/*!
+  The command list is encoded and send immediately when less than
+  ExecWindow() lists are in flight, otherwise it is queued and send when
+  an earlier list completes. The method returns without waiting for the
+  response. The list must fit into a single packet, see RbufUsage().
+
+  When the response is received and decoded the completion handler
+  \a exechdl is called with the command list and a \c bool which is
+  \c false in case of a transmission error or timeout. When the server is
+  active the handler is always called on the server thread, responses are
+  picked up by the server via HandleUnsolicitedData(), and a server timer
+  enforces the Timeout() for each list in flight, see AsyncTimeout().
+  Without active server responses are processed by ExecAsyncWait() or the
+  next Exec().
+
+  A synchronous Exec() first completes all outstanding lists, so the order
+  of requests is always preserved.
+
+  \param clist    command list, must stay valid till \a exechdl was called
+  \param cntx     context, must stay valid till \a exechdl was called
+  \param exechdl  completion handler (can be empty)
+  \param emsg     contains error description (mainly from port layer)
+
+  \returns \c true on success, \c false if the send failed
+ */
+
+bool RlinkConnect::ExecAsync(RlinkCommandList& clist, RlinkContext& cntx, 
+                             exechdl_t&& exechdl, RerrMsg& emsg)
+{
+  if (clist.Size() == 0)
+    throw Rexception("RlinkConnect::ExecAsync()", "Bad state: clist empty");
+  if (! IsOpen())
+    throw Rexception("RlinkConnect::ExecAsync()", "Bad state: port not open");
+
+  lock_guard<RlinkConnect> lock(*this);
+
+  fStats.Inc(kStatNExecAsync);
+
+  ExecSetup(clist, cntx);
+
+  size_t rbuse = 0;
+  for (size_t i=0; i<clist.Size(); i++) rbuse += RbufUsage(clist[i]);
+  if (rbuse > fRbufSize)
+    throw Rexception("RlinkConnect::ExecAsync()", 
+                     "Bad args: clist does not fit into rbuf");
+
+  fAsyncList.push_back(AsyncDsc{&clist, &cntx, move(exechdl), Rtime()});
+  return AsyncSend(emsg);
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void RlinkConnect::ExecAsync(RlinkCommandList& clist, RlinkContext& cntx,
+                             exechdl_t&& exechdl)
+{
+  RerrMsg emsg;
+  if (!ExecAsync(clist, cntx, move(exechdl), emsg))
+    throw Rexception("RlinkConnect::ExecAsync", "ExecAsync() failed: ", emsg);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Wait till all ExecAsync() lists are completed.
+/*!
+  \param emsg  contains error description (mainly from port layer)
+  \returns \c true on success, \c false if a send or receive failed. In
+           that case all outstanding lists are completed with error status.
+ */
+
+bool RlinkConnect::ExecAsyncWait(RerrMsg& emsg)
+{
+  lock_guard<RlinkConnect> lock(*this);
+  if (fAsyncList.empty()) return true;
+  if (!IsOpen()) BadPort("RlinkConnect::ExecAsyncWait");
+  return AsyncDrain(emsg);
+}
+
 //------------------------------------------+-----------------------------------
 //! Wait for an attention notify.
 /*!
@@ -635,14 +755,147 @@ void RlinkConnect::SetTimeout(const Rtime& timeout)
 }
   
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Set the maximal number of request packets in flight in Exec().
+/*!
+  A value of 1 restores the default behavior, each Exec() sends the whole
+  command list as one packet. For larger values Exec() splits command lists
+  which don't fit into the rbuf into several packets and keeps up to
+  \a nwin of them in flight, see ExecSplit().
+
+  \param nwin  maximal number of outstanding packets, 1 to kExecWindowMax
+ */
+
+void RlinkConnect::SetExecWindow(size_t nwin)
+{
+  if (nwin < 1 || nwin > kExecWindowMax)
+    throw Rexception("RlinkConnect::SetExecWindow()",
+                     "Bad args: nwin < 1 or > kExecWindowMax");
+  fExecWindow = nwin;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Set busy-poll budget of port.
+/*!
+  \param usec  time in usec the port spins on non-blocking polls before it
+               falls back to a blocking poll() when waiting for responses,
+               0 disables busy-poll. Also set with url option \c spin=usec.
+
+  Busy-poll trades CPU time for lower response latency, see
+  RlinkPort::SpinRead(). The setting is kept over Close() and Open().
+ */
+
+void RlinkConnect::SetSpinTime(uint32_t usec)
+{
+  fSpinTime = usec;
+  if (HasPort()) Port().SetSpinTime(usec);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns the current adaptive block size.
+/*!
+  The adaptive block size is tuned by BlockSizeAutoUpdate() and
+  BlockSizeAutoShrink() based on the measured transfer rate of the link.
+  It is kBlockSizeAutoMin times a power of 2, but at most BlockSizePrudent().
+ */
+
+size_t RlinkConnect::BlockSizeAuto() const
+{
+  size_t bsize = kBlockSizeAutoMin << fBsAutoLvl;
+  size_t bmax  = BlockSizePrudent();
+  return (bsize < bmax) ? bsize : bmax;
+}
+
+//------------------------------------------+-----------------------------------
+//! Update the adaptive block size with a transfer measurement.
+/*!
+  Uses a hill climbing scheme with a transfer rate estimate for each block
+  size. The block size is doubled when the next larger size was not yet
+  tried or has a rate better by more than 5%, and halved when the next
+  smaller size has a rate better by more than 5%. The symmetric criterion
+  avoids oscillations between two sizes.
+
+  Only measurements for blocks of full BlockSizeAuto() size are used.
+
+  \param nword  number of words transfered
+  \param dt     time needed for the transfer
+ */
+
+void RlinkConnect::BlockSizeAutoUpdate(size_t nword, const Rtime& dt)
+{
+  lock_guard<RlinkConnect> lock(*this);
+  size_t bsize = BlockSizeAuto();
+  double tsec  = double(dt);
+  if (nword < bsize || tsec <= 0.) return;
+
+  double  rate = double(nword) / tsec;
+  double& rcur = fBsAutoRate[fBsAutoLvl];
+  rcur = (rcur == 0.) ? rate : 0.75*rcur + 0.25*rate;
+
+  if (bsize < BlockSizePrudent() && fBsAutoLvl+1 < kBlockSizeAutoNLvl) {
+    double rnext = fBsAutoRate[fBsAutoLvl+1];
+    if (rnext == 0. || rnext > 1.05*rcur) { // untried or better -> grow
+      fStats.Inc(kStatNBsAutoGrow);
+      fBsAutoLvl += 1;
+      return;
+    }
+  }
+  if (fBsAutoLvl > 0 && fBsAutoRate[fBsAutoLvl-1] > 1.05*rcur) {
+    fStats.Inc(kStatNBsAutoShrink);         // smaller is better -> shrink
+    fBsAutoLvl -= 1;
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Shrink the adaptive block size.
+/*!
+  Called by users of BlockSizeAuto() when latency sensitive work, like
+  pending attentions of other devices, is waiting. The block size is
+  halved and the rate estimates of the larger sizes are cleared, so
+  BlockSizeAutoUpdate() will probe and grow again once the link is idle.
+ */
+
+void RlinkConnect::BlockSizeAutoShrink()
+{
+  lock_guard<RlinkConnect> lock(*this);
+  if (fBsAutoLvl > 0) {
+    fStats.Inc(kStatNBsAutoShrink);
+    fBsAutoLvl -= 1;
+  }
+  for (size_t i=fBsAutoLvl+1; i<kBlockSizeAutoNLvl; i++) fBsAutoRate[i] = 0.;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Open log file \a name
+/*!
+  Log files are taken from RlogFileCatalog, so all connects which use the
+  same file name share one RlogFile and write into one log, like in a
+  process serving several boards. The buildin streams (\c -, \c <cout>,
+  \c <cerr> and \c <clog>) are handled by a private RlogFile.
+
+  Should be called while the server is not active.
+ */
 
 bool RlinkConnect::LogOpen(const std::string& name, RerrMsg& emsg)
 {
-  if (!fspLog->Open(name, emsg)) {
+  if (name == "-" || name == "<cout>" || name == "<cerr>" ||
+      name == "<clog>") {
+    if (fLogShared) LogSetFile(make_shared<RlogFile>(&cout), false);
+    return fspLog->Open(name, emsg);
+  }
+
+  RlogFileCatalog& cat = RlogFileCatalog::Obj();
+  shared_ptr<RlogFile> splog = cat.FindOrCreate(name);
+  if (splog->IsNew() && !splog->Open(name, emsg)) {
+    cat.Delete(name);
+    if (fLogShared) LogSetFile(make_shared<RlogFile>(&cout), false);
     fspLog->UseStream(&cout);
     return false;
   }
+  LogSetFile(splog, true);
   return true;
 }
 
@@ -651,10 +904,24 @@ bool RlinkConnect::LogOpen(const std::string& name, RerrMsg& emsg)
 
 void RlinkConnect::LogUseStream(std::ostream* pstr, const std::string& name)
 {
+  if (fLogShared) LogSetFile(make_shared<RlogFile>(pstr, name), false);
   fspLog->UseStream(pstr, name);
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Switch to RlogFile \a splog, also for port and server
+
+void RlinkConnect::LogSetFile(const std::shared_ptr<RlogFile>& splog,
+                              bool shared)
+{
+  fspLog     = splog;
+  fLogShared = shared;
+  if (HasPort()) Port().SetLogFile(fspLog);
+  if (fpServ) fpServ->SyncLogFile();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -705,18 +972,29 @@ void RlinkConnect::Dump(std::ostream& os, int ind, const char* text,
   fContext.Dump(os, ind+2, "fContext: ", detail);
   fAddrMap.Dump(os, ind+2, "fAddrMap: ", detail-1);
   fStats.Dump(os, ind+2, "fStats: ", detail-1);
+  fHistStats.Dump(os, ind+2, "fHistStats: ", detail-1);
   os << bl << "  fLogBaseAddr:     " << fLogBaseAddr << endl;
   os << bl << "  fLogBaseData:     " << fLogBaseData << endl;
   os << bl << "  fLogBaseStat:     " << fLogBaseStat << endl;
   os << bl << "  fPrintLevel:      " << fPrintLevel << endl;
   os << bl << "  fDumpLevel        " << fDumpLevel << endl;
   os << bl << "  fTraceLevel       " << fTraceLevel << endl;
+  os << bl << "  fTimeout:         " << fTimeout << endl;
+  os << bl << "  fExecWindow:      " << fExecWindow << endl;
+  os << bl << "  fSpinTime:        " << fSpinTime << endl;
+  os << bl << "  fAsyncList.size:  " << fAsyncList.size() << endl;
+  os << bl << "  fAsyncNSnd:       " << fAsyncNSnd << endl;
+  os << bl << "  fAsyncTimer:      " << fAsyncTimer << endl;
+  os << bl << "  fHistPkt.size:    " << fHistPkt.size() << endl;
   fspLog->Dump(os, ind+2, "fspLog: ");
+  os << bl << "  fLogShared:       " << RosPrintf(fLogShared) << endl;
   os << bl << "  fAttnNotiPatt:    " << RosPrintBvi(fAttnNotiPatt,16) << endl;
   os << bl << "  fTsLastAttnNoti:  " << fTsLastAttnNoti << endl;
   os << bl << "  fSysId:           " << RosPrintBvi(fSysId,16) << endl;
   os << bl << "  fUsrAcc:          " << RosPrintBvi(fUsrAcc,16) << endl;
   os << bl << "  fRbufSize:        " << RosPrintf(fRbufSize,"d",6) << endl;
+  os << bl << "  fBsAutoLvl:       " << fBsAutoLvl
+     << "  BlockSizeAuto: " << BlockSizeAuto() << endl;
 
   return;
 }
@@ -747,7 +1025,94 @@ void RlinkConnect::HandleUnsolicitedData()
     RlogMsg lmsg(*fspLog, 'E');
     lmsg << "HandleUnsolicitedData: IO error: " << emsg;
   }
-  ProcessUnsolicitedData();
+  if (fAsyncNSnd > 0) {
+    ProcessAsyncData();
+  } else {
+    ProcessUnsolicitedData();
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Setup command list for execution.
+/*!
+  Checks all commands, clears the execution flags, and sets up the default
+  status check from context \a cntx unless an explicit check is defined.
+ */
+
+void RlinkConnect::ExecSetup(RlinkCommandList& clist, RlinkContext& cntx)
+{
+  clist.ClearLaboIndex();
+
+  uint8_t defstatval = cntx.StatusValue();
+  uint8_t defstatmsk = cntx.StatusMask();
+  size_t size = clist.Size();
+
+  for (size_t i=0; i<size; i++) {
+    RlinkCommand& cmd = clist[i];
+   if (!cmd.TestFlagAny(RlinkCommand::kFlagInit))
+     throw Rexception("RlinkConnect::Exec()", 
+                      "BugCheck: command not initialized");
+    if (cmd.Command() > RlinkCommand::kCmdInit)
+      throw Rexception("RlinkConnect::Exec()", 
+                       "BugCheck: invalid command code");
+    // trap attn command when server running and outside server thread
+    if (cmd.Command() == RlinkCommand::kCmdAttn && ServerActiveOutside())
+      throw Rexception("RlinkConnect::Exec()", 
+                       "attn command not allowed outside active server");
+    
+    cmd.ClearFlagBit(RlinkCommand::kFlagSend   | 
+                     RlinkCommand::kFlagDone   |
+                     RlinkCommand::kFlagLabo   |
+                     RlinkCommand::kFlagPktBeg | 
+                     RlinkCommand::kFlagPktEnd |
+                     RlinkCommand::kFlagErrNak | 
+                     RlinkCommand::kFlagErrDec);
+    
+    // setup default status check unless explicit check defined
+    if (!cmd.ExpectStatusSet()) {
+      cmd.SetExpectStatusDefault(defstatval, defstatmsk);
+    }
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Post-process an executed command list.
+/*!
+  Updates the error count of context \a cntx and prints or dumps the list
+  according to print and dump level.
+ */
+
+void RlinkConnect::ExecFinish(RlinkCommandList& clist, RlinkContext& cntx)
+{
+  bool checkseen = false;
+  bool errorseen = false;
+
+  for (size_t i=0; i<clist.Size(); i++) {
+    RlinkCommand& cmd = clist[i];
+    
+    bool checkfound = cmd.TestFlagAny(RlinkCommand::kFlagChkStat | 
+                                      RlinkCommand::kFlagChkData |
+                                      RlinkCommand::kFlagChkDone);
+    bool errorfound = cmd.TestFlagAny(RlinkCommand::kFlagErrNak | 
+                                      RlinkCommand::kFlagErrDec);
+    checkseen |= checkfound;
+    errorseen |= errorfound;
+    if (checkfound | errorfound) cntx.IncErrorCount();
+  }
+
+  size_t loglevel = 3;
+  if (checkseen) loglevel = 2;
+  if (errorseen) loglevel = 1;
+  if (loglevel <= fPrintLevel) {
+    RlogMsg lmsg(*fspLog);
+    clist.Print(lmsg(), &AddrMap(), fLogBaseAddr, fLogBaseData, fLogBaseStat);
+  }
+  if (loglevel <= fDumpLevel) {
+    RlogMsg lmsg(*fspLog);
+    clist.Dump(lmsg(), 0);
+  }
   return;
 }
 
@@ -764,6 +1129,8 @@ bool RlinkConnect::ExecPart(RlinkCommandList& clist, size_t ibeg, size_t iend,
     throw Rexception("RlinkConnect::ExecPart()","Bad state: port not open");
 
   fStats.Inc(kStatNExecPart);
+  fHistPkt.clear();                         // nothing in flight
+  fRcvPkt.ClearBlocks();
   EncodeRequest(clist, ibeg, iend);
 
   // FIXME_code: handle send fail properly;
@@ -776,6 +1143,7 @@ bool RlinkConnect::ExecPart(RlinkCommandList& clist, size_t ibeg, size_t iend,
 
   int ncmd = DecodeResponse(clist, ibeg, iend);
   if (ncmd != int(iend-ibeg+1)) {
+    fRcvPkt.ClearBlocks();
     clist.Dump(cout);
     throw Rexception("RlinkConnect::ExecPart()","incomplete response");
   }
@@ -785,6 +1153,300 @@ bool RlinkConnect::ExecPart(RlinkCommandList& clist, size_t ibeg, size_t iend,
   return true;
 }
 
+//------------------------------------------+-----------------------------------
+//! Execute a command list split into several packets with a send window.
+/*!
+  The command list is split into packets such that the response and the
+  \c wblk data of each packet fits into the rbuf, see RbufUsage(). Up to
+  ExecWindow() packets are send before the response of the oldest packet
+  is read, so the link round trip time is overlapped with the transfer of
+  the next packets. Responses are decoded in order, the sequence number
+  embedded in the command byte ensures that each response is matched to
+  the proper request.
+
+  Since a \c labo command only aborts the remainder of its own packet, a
+  packet containing a \c labo is always the last one in flight. If the
+  \c labo was active, all commands of the not yet send packets are marked
+  as done and aborted, exactly as if the list would have been send as
+  single packet.
+
+  \param clist  command list
+  \param emsg   contains error description (mainly from port layer)
+  \returns \c true on success
+ */
+
+bool RlinkConnect::ExecSplit(RlinkCommandList& clist, RerrMsg& emsg)
+{
+  fStats.Inc(kStatNExecSplit);
+  fHistPkt.clear();                         // nothing in flight
+  fRcvPkt.ClearBlocks();
+
+  // determine packet boundaries, stored as index of first command
+  vector<size_t> pbeg;
+  size_t size  = clist.Size();
+  size_t rbuse = 0;
+  for (size_t i=0; i<size; i++) {
+    size_t nuse = RbufUsage(clist[i]);
+    if (i == 0 || rbuse+nuse > fRbufSize) {
+      pbeg.push_back(i);
+      rbuse = 0;
+    }
+    rbuse += nuse;
+  }
+  size_t npkt = pbeg.size();
+  pbeg.push_back(size);
+
+  size_t nsnd = 0;                          // packets send
+  size_t nrcv = 0;                          // packets received
+  bool   labo = false;                      // labo in flight
+
+  while (nrcv < npkt) {
+    // send packets till window full or a labo is in flight
+    while (nsnd < npkt && nsnd-nrcv < fExecWindow && !labo) {
+      size_t ibeg = pbeg[nsnd];
+      size_t iend = pbeg[nsnd+1]-1;
+      fStats.Inc(kStatNExecPart);
+      fStats.Inc(kStatNExecSplitPkt);
+      EncodeRequest(clist, ibeg, iend);
+      if (!fSndPkt.SndPacket(Port(), emsg)) {
+        fRcvPkt.ClearBlocks();
+        return false;
+      }
+      for (size_t i=ibeg; i<=iend; i++) {
+        if (clist[i].Command() == RlinkCommand::kCmdLabo) labo = true;
+      }
+      nsnd += 1;
+    }
+
+    // read and decode response of oldest packet
+    size_t ibeg = pbeg[nrcv];
+    size_t iend = pbeg[nrcv+1]-1;
+    if (!ReadResponse(fTimeout, emsg)) {
+      fRcvPkt.ClearBlocks();
+      throw Rexception("RlinkConnect::ExecSplit()","faulty response");
+    }
+    int ncmd = DecodeResponse(clist, ibeg, iend);
+    if (ncmd != int(iend-ibeg+1)) {
+      fRcvPkt.ClearBlocks();
+      clist.Dump(cout);
+      throw Rexception("RlinkConnect::ExecSplit()","incomplete response");
+    }
+    fRcvPkt.AcceptPacket();                 // keep buffered data of next pkt
+    nrcv += 1;
+    if (nrcv == nsnd) labo = false;         // window drained, labo resolved
+
+    // if labo was active, mark commands of all unsend packets as aborted
+    if (clist.LaboActive()) {
+      fRcvPkt.ClearBlocks();
+      for (size_t i=pbeg[nsnd]; i<size; i++) {
+        clist[i].SetFlagBit(RlinkCommand::kFlagDone|RlinkCommand::kFlagLabo);
+      }
+      break;
+    }
+  }
+
+  ProcessUnsolicitedData();
+
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns the rbuf space used by a command.
+/*!
+  The rbuf holds the response of a packet, and in addition the data of a
+  \c wblk until the data crc is checked.
+
+  \param cmd  command
+  \returns  number of rbuf bytes needed by \a cmd
+ */
+
+size_t RlinkConnect::RbufUsage(const RlinkCommand& cmd) const
+{
+  size_t ndata = cmd.BlockSize();
+  switch (cmd.Command()) {
+    case RlinkCommand::kCmdRreg: return 1+2+1+2;           // cmd+data+stat+crc
+    case RlinkCommand::kCmdRblk: return 1+2+2*ndata+2+1+2; // +cnt+data+dcnt
+    case RlinkCommand::kCmdWreg: return 1+1+2;             // cmd+stat+crc
+    case RlinkCommand::kCmdWblk: return 1+2+1+2 + 2*ndata+2; // +data+dcrc
+    case RlinkCommand::kCmdLabo: return 1+1+1+2;           // cmd+babo+stat+crc
+    case RlinkCommand::kCmdAttn: return 1+2+1+2;           // cmd+data+stat+crc
+    default:                     return 1+1+2;             // cmd+stat+crc
+  }
+}
+
+//------------------------------------------+-----------------------------------
+//! Send queued ExecAsync() lists till the send window is full.
+
+bool RlinkConnect::AsyncSend(RerrMsg& emsg)
+{
+  while (fAsyncNSnd < fAsyncList.size() && fAsyncNSnd < fExecWindow) {
+    RlinkCommandList& clist = *fAsyncList[fAsyncNSnd].fpClist;
+    fStats.Inc(kStatNExecPart);
+    EncodeRequest(clist, 0, clist.Size()-1);
+    if (!fSndPkt.SndPacket(Port(), emsg)) return false;
+    fAsyncList[fAsyncNSnd].fDeadline = Rtime(CLOCK_MONOTONIC) + fTimeout;
+    fAsyncNSnd += 1;
+  }
+  AsyncTimerArm();
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Decode a received response for the oldest ExecAsync() list in flight.
+
+void RlinkConnect::AsyncDecode()
+{
+  RlinkCommandList& clist = *fAsyncList.front().fpClist;
+  int ncmd = DecodeResponse(clist, 0, clist.Size()-1);
+  fRcvPkt.AcceptPacket();
+  bool ok = ncmd == int(clist.Size());
+  if (!ok) {
+    fRcvPkt.ClearBlocks();
+    RlogMsg lmsg(*fspLog, 'E');
+    lmsg << "ExecAsync: incomplete response" << endl;
+    clist.Dump(lmsg(), 0);
+  }
+  AsyncDone(ok);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Complete the oldest ExecAsync() list and call its handler.
+/*!
+  The handler is called directly when on the server thread or no server
+  is active. When called outside an active server, e.g. when an Exec()
+  from another thread drains the outstanding lists, the handler call is
+  queued as server action, so handlers always run on the server thread.
+ */
+
+void RlinkConnect::AsyncDone(bool ok)
+{
+  AsyncDsc dsc = move(fAsyncList.front());
+  fAsyncList.pop_front();
+  if (fAsyncNSnd > 0) fAsyncNSnd -= 1;
+  if (fAsyncNSnd == 0 && fAsyncTimer != 0) { // nothing in flight -> cancel
+    if (fpServ) fpServ->CancelTimer(fAsyncTimer); // timer, next list arms
+    fAsyncTimer = 0;                              // one with its deadline
+  }
+
+  if (ok) ExecFinish(*dsc.fpClist, *dsc.fpCntx);
+  if (!dsc.fHandler) return;
+
+  if (ServerActiveOutside()) {
+    RlinkCommandList* pclist = dsc.fpClist;
+    exechdl_t         hdl    = move(dsc.fHandler);
+    fpServ->QueueAction([pclist, ok, hdl](){ hdl(*pclist, ok); return 0; });
+  } else {
+    dsc.fHandler(*dsc.fpClist, ok);
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Send and receive all outstanding ExecAsync() lists.
+
+bool RlinkConnect::AsyncDrain(RerrMsg& emsg)
+{
+  bool ok = true;
+  while (ok && !fAsyncList.empty()) {
+    fStats.Inc(kStatNExecAsyncDrain);
+    ok = AsyncSend(emsg);
+    if (ok) {
+      ok = ReadResponse(fTimeout, emsg);
+      if (ok) {
+        AsyncDecode();
+      } else if (emsg.Text().empty()) {
+        emsg.Init("RlinkConnect::AsyncDrain()", "no response for ExecAsync()");
+      }
+    }
+  }
+  
+  if (!ok) fRcvPkt.ClearBlocks();
+  while (!fAsyncList.empty()) AsyncDone(false); // on error complete all
+  return ok;
+}
+
+//------------------------------------------+-----------------------------------
+//! Process input data while ExecAsync() lists are in flight.
+/*!
+  Decodes all complete responses, sends further queued lists, and finally
+  processes remaining data with ProcessUnsolicitedData().
+ */
+
+void RlinkConnect::ProcessAsyncData()
+{
+  while (fAsyncNSnd > 0 && fRcvPkt.ProcessData()) {
+    int irc = fRcvPkt.PacketState();
+    if (irc == RlinkPacketBufRcv::kPktPend) break;
+    if (irc == RlinkPacketBufRcv::kPktAttn) {
+      ProcessAttnNotify();
+    } else if (irc == RlinkPacketBufRcv::kPktResp) {
+      AsyncDecode();
+    } else {
+      fRcvPkt.AcceptPacket();
+      RlogMsg lmsg(*fspLog, 'E');
+      lmsg << "ProcessAsyncData: dropped spurious packet";
+    }
+  }
+
+  RerrMsg emsg;
+  if (!AsyncSend(emsg)) {
+    RlogMsg lmsg(*fspLog, 'E');
+    lmsg << "ProcessAsyncData: send failed: " << emsg;
+    fRcvPkt.ClearBlocks();
+    while (!fAsyncList.empty()) AsyncDone(false);
+  }
+  
+  ProcessUnsolicitedData();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Arm a server timer for the deadline of the oldest ExecAsync() list.
+/*!
+  Only done when the server is active and lists are in flight. At most one
+  timer is pending, AsyncTimeout() re-arms it for later deadlines. Also
+  called by RlinkServer when started or resumed, so lists sent while no
+  server was active get their deadline too.
+ */
+
+void RlinkConnect::AsyncTimerArm()
+{
+  if (fAsyncTimer != 0 || fAsyncNSnd == 0 || !ServerActive()) return;
+  fAsyncTimer = fpServ->AddTimer(fAsyncList.front().fDeadline,
+                                 [this](){ AsyncTimeout(); });
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Server timer handler for ExecAsync() response timeouts.
+/*!
+  When the oldest list in flight passed its deadline the response is
+  considered lost. Because responses arrive in order all outstanding lists
+  are then completed with error status. Otherwise the timer is re-armed
+  for the deadline of the oldest list.
+ */
+
+void RlinkConnect::AsyncTimeout()
+{
+  lock_guard<RlinkConnect> lock(*this);
+  fAsyncTimer = 0;
+  if (fAsyncNSnd == 0) return;
+
+  if (Rtime(CLOCK_MONOTONIC) < fAsyncList.front().fDeadline) {
+    AsyncTimerArm();
+    return;
+  }
+
+  fStats.Inc(kStatNExecAsyncTout);
+  RlogMsg lmsg(*fspLog, 'E');
+  lmsg << "ExecAsync: no response after " << fTimeout.ToDouble() << " sec, "
+       << fAsyncList.size() << " lists aborted";
+  fRcvPkt.ClearBlocks();
+  while (!fAsyncList.empty()) AsyncDone(false);
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -792,6 +1454,7 @@ void RlinkConnect::EncodeRequest(RlinkCommandList& clist, size_t ibeg,
                                  size_t iend)
 {
   fSndPkt.Init();
+  size_t rcvoff = 0;                        // offset of cmd in response
 
   for (size_t i=ibeg; i<=iend; i++) {
     RlinkCommand& cmd = clist[i];
@@ -816,9 +1479,11 @@ void RlinkConnect::EncodeRequest(RlinkCommandList& clist, size_t ibeg,
       case RlinkCommand::kCmdRblk:          // rblk command ---------------
         fStats.Inc(kStatNRblk);
         fStats.Inc(kStatNRblkWord, double(ndata));
+        fHistStats.IncLogHist(kHistRblkWord, 0x0f, 0xffff, ndata);
         cmd.SetRcvSize(1+2+2*ndata+2+1+2); // rcv: cmd+cnt+n*data+dcnt+stat+crc
         fSndPkt.PutWithCrc(cmd.Address());
         fSndPkt.PutWithCrc(uint16_t(ndata));
+        fRcvPkt.AddBlock(rcvoff+1+2, pdata, ndata); // data after cmd+cnt
         break;
 
       case RlinkCommand::kCmdWreg:          // wreg command ---------------
@@ -831,11 +1496,12 @@ void RlinkConnect::EncodeRequest(RlinkCommandList& clist, size_t ibeg,
       case RlinkCommand::kCmdWblk:          // wblk command ---------------
         fStats.Inc(kStatNWblk);
         fStats.Inc(kStatNWblkWord, double(ndata));
+        fHistStats.IncLogHist(kHistWblkWord, 0x0f, 0xffff, ndata);
         cmd.SetRcvSize(1+2+1+2);              // rcv: cmd+dcnt+stat+crc
         fSndPkt.PutWithCrc(cmd.Address());
         fSndPkt.PutWithCrc(uint16_t(ndata));
         fSndPkt.PutCrc();
-        fSndPkt.PutWithCrc(pdata, ndata);
+        fSndPkt.PutBlock(pdata, ndata);     // data must be valid until send
         break;
 
       case RlinkCommand::kCmdLabo:          // labo command ---------------
@@ -860,12 +1526,26 @@ void RlinkConnect::EncodeRequest(RlinkCommandList& clist, size_t ibeg,
 
     fSndPkt.PutCrc();
     cmd.SetFlagBit(RlinkCommand::kFlagSend);
+    rcvoff += cmd.RcvSize();
+    fRcvPkt.AddCrcField(rcvoff-2);
   } // for (size_t i=ibeg; i<=iend; i++)
 
   // FIXME_code: do we still need kFlagPktBeg,kFlagPktEnd ?
   clist[ibeg].SetFlagBit(RlinkCommand::kFlagPktBeg);
   clist[iend].SetFlagBit(RlinkCommand::kFlagPktEnd);
 
+  // packet class: command code if all commands are of same type, else mixed
+  size_t cls = clist[ibeg].Command();
+  for (size_t i=ibeg+1; i<=iend; i++) {
+    if (clist[i].Command() != cls) cls = kHistClsMix;
+  }
+  if (cls > kHistClsMix) cls = kHistClsMix; // init counted as mixed
+
+  fHistStats.IncLogHist(kHistSndByte, 0x0f, 0xffff, fSndPkt.PktSize());
+  fHistStats.IncLogHist(kHistPktCmd,  0x01, 0xff,   iend-ibeg+1);
+  fHistPkt.push_back(HistPkt{Rtime(CLOCK_MONOTONIC), fSndPkt.PktSize(), cls});
+  fRcvPkt.QueueBlocks();
+
   return;
 }
   
@@ -877,6 +1557,18 @@ int RlinkConnect::DecodeResponse(RlinkCommandList& clist, size_t ibeg,
 {
   size_t ncmd = 0;
 
+  fHistStats.IncLogHist(kHistRcvByte, 0x0f, 0xffff, fRcvPkt.PktSize());
+  if (!fHistPkt.empty()) {
+    const HistPkt& pkt = fHistPkt.front();
+    size_t trtt = size_t(1.e6*double(Rtime(CLOCK_MONOTONIC) - pkt.fTsSnd));
+    size_t ind  = kHistCls + pkt.fCls*kDimHistCls;
+    fHistStats.IncLogHist(kHistRtt, 0x3f, 0x3ffff, trtt);
+    fHistStats.IncLogHist(ind+kHistClsRtt,  0x3f, 0x3ffff, trtt);
+    fHistStats.IncLogHist(ind+kHistClsByte, 0x0f, 0xffff,
+                          pkt.fSndByte + fRcvPkt.PktSize());
+    fHistPkt.pop_front();
+  }
+
   for (size_t i=ibeg; i<=iend; i++) {
     RlinkCommand& cmd = clist[i];
     uint8_t   ccode = cmd.Command();
@@ -941,7 +1633,7 @@ int RlinkConnect::DecodeResponse(RlinkCommandList& clist, size_t ibeg,
           lmsg << "DecodeResponse: rblk length mismatch";
           return -1;
         }
-        fRcvPkt.GetWithCrc(cmd.BlockPointer(), cmd.BlockSize());
+        fRcvPkt.GetBlockWithCrc(cmd.BlockPointer(), cmd.BlockSize());
         fRcvPkt.GetWithCrc(rdata);
         cmd.SetBlockDone(rdata);
        break;
@@ -1101,17 +1793,11 @@ bool RlinkConnect::ReadResponse(const Rtime& timeout, RerrMsg& emsg)
   Rtime tnow(CLOCK_MONOTONIC);
   Rtime tend = tnow + timeout;
 
-  while (tnow < tend) {
-    if (!IsOpen()) BadPort("RlinkConnect::ReadResponse");
-    int irc = fRcvPkt.ReadData(Port(), tend-tnow, emsg);
-    if (irc <= 0) {
-      RlogMsg lmsg(*fspLog, 'E');
-      lmsg << "ReadResponse: IO error or timeout: " << emsg;
-      return false;
-    }
-
+  while (true) {
+    // process still buffered data first, in windowed Exec the input buffer
+    // can hold the beginning of the response of the next packet
     while (fRcvPkt.ProcessData()) {
-      irc = fRcvPkt.PacketState();
+      int irc = fRcvPkt.PacketState();
       if (irc == RlinkPacketBufRcv::kPktPend) break;
       if (irc == RlinkPacketBufRcv::kPktAttn) {
         ProcessAttnNotify();
@@ -1124,9 +1810,19 @@ bool RlinkConnect::ReadResponse(const Rtime& timeout, RerrMsg& emsg)
       }
     } //while (fRcvPkt.ProcessData())
 
+    if (!(tnow < tend)) break;
+
+    if (!IsOpen()) BadPort("RlinkConnect::ReadResponse");
+    int irc = fRcvPkt.ReadData(Port(), tend-tnow, emsg);
+    if (irc <= 0) {
+      RlogMsg lmsg(*fspLog, 'E');
+      lmsg << "ReadResponse: IO error or timeout: " << emsg;
+      return false;
+    }
+
     tnow.GetClock(CLOCK_MONOTONIC);
 
-  } // while (tnow < tend)
+  } // while (true)
 
   { 
     RlogMsg lmsg(*fspLog, 'E');
@@ -1,9 +1,18 @@
 // $Id: RlinkConnect.hpp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   2.15.2 add HistPkt, fHistPkt; per class histograms
+// 2026-10-18  1227   2.15.1 AsyncTimerArm() now public
+// 2026-10-18  1227   2.15   add AsyncTimerArm(),AsyncTimeout(),fAsyncTimer
+// 2026-10-18  1219   2.14   add LogSetFile(), fLogShared
+// 2026-10-18  1218   2.13   add SetSpinTime(),SpinTime()
+// 2026-10-18  1208   2.12   add BlockSizeAuto(),BlockSizeAutoUpdate(),..Shrink()
+// 2026-10-18  1207   2.11   add HistStats(), histogram counters
+// 2026-10-18  1205   2.10   add ExecAsync(), ExecAsyncWait(), exechdl_t
+// 2026-10-18  1202   2.9    add windowed Exec: ExecSplit(), (Set)ExecWindow()
 // 2019-07-27  1198   2.8.5  add Nak handling
 // 2019-06-07  1160   2.8.4  *Stats() not longer const
 // 2018-12-23  1091   2.8.3  add BadPort()
@@ -50,9 +59,11 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <deque>
 #include <memory>
 #include <ostream>
 #include <mutex>
+#include <functional>
 
 #include "librtools/RerrMsg.hpp"
 #include "librtools/Rtime.hpp"
@@ -75,6 +86,7 @@ namespace Retro {
 
   class RlinkConnect : public Rbits {
     public:
+      typedef std::function<void(RlinkCommandList&,bool)> exechdl_t;
 
                     RlinkConnect();
                    ~RlinkConnect();
@@ -111,6 +123,14 @@ namespace Retro {
       void          Exec(RlinkCommandList& clist);
       void          Exec(RlinkCommandList& clist, RlinkContext& cntx);
 
+      bool          ExecAsync(RlinkCommandList& clist, RlinkContext& cntx,
+                              exechdl_t&& exechdl, RerrMsg& emsg);
+      void          ExecAsync(RlinkCommandList& clist, RlinkContext& cntx,
+                              exechdl_t&& exechdl);
+      bool          ExecAsyncWait(RerrMsg& emsg);
+      size_t        ExecAsyncPending() const;
+      void          AsyncTimerArm();
+
       int           WaitAttn(const Rtime& timeout, Rtime& twait, uint16_t& apat, 
                              RerrMsg& emsg);
       bool          SndOob(uint16_t addr, uint16_t data, RerrMsg& emsg);
@@ -121,8 +141,12 @@ namespace Retro {
       size_t        RbufSize() const;
       size_t        BlockSizeMax() const;
       size_t        BlockSizePrudent() const;
+      size_t        BlockSizeAuto() const;
       bool          HasRbmon() const;
 
+      void          BlockSizeAutoUpdate(size_t nword, const Rtime& dt);
+      void          BlockSizeAutoShrink();
+
       bool          AddrMapInsert(const std::string& name, uint16_t addr);
       bool          AddrMapErase(const std::string& name);
       bool          AddrMapErase(uint16_t addr);
@@ -132,6 +156,7 @@ namespace Retro {
       Rstats&       Stats();
       Rstats&       SndStats();
       Rstats&       RcvStats();
+      Rstats&       HistStats();
 
       void          SetLogBaseAddr(uint32_t base);
       void          SetLogBaseData(uint32_t base);
@@ -140,6 +165,8 @@ namespace Retro {
       void          SetDumpLevel(uint32_t lvl);
       void          SetTraceLevel(uint32_t lvl);
       void          SetTimeout(const Rtime& timeout);
+      void          SetExecWindow(size_t nwin);
+      void          SetSpinTime(uint32_t usec);
 
       uint32_t      LogBaseAddr() const;
       uint32_t      LogBaseData() const;
@@ -148,6 +175,8 @@ namespace Retro {
       uint32_t      DumpLevel() const;
       uint32_t      TraceLevel() const;
       const Rtime&  Timeout() const;
+      size_t        ExecWindow() const;
+      uint32_t      SpinTime() const;
 
       bool          LogOpen(const std::string& name, RerrMsg& emsg);
       void          LogUseStream(std::ostream* pstr, 
@@ -191,11 +220,22 @@ namespace Retro {
       static const uint16_t kRbufBlkDelta=16; //!< rbuf needed for rblk or wblk
       // 512 byte are enough space for a prudent amount of non-blk commands
       static const uint16_t kRbufPrudentDelta=512; //!< Rbuf space reserve
+      // maximal number of packets in flight in windowed Exec
+      static const size_t kExecWindowMax=16; //!< max value for ExecWindow
+      // adaptive block size is kBlockSizeAutoMin<<level, see BlockSizeAuto()
+      static const size_t kBlockSizeAutoMin=32;   //!< min adaptive block size
+      static const size_t kBlockSizeAutoNLvl=12;  //!< number of size levels
+      static const size_t kBlockSizeAutoInit=3;   //!< initial level (256 wrd)
 
     // statistics counter indices
       enum stats {
         kStatNExec = 0,                     //!< Exec() calls
         kStatNExecPart,                     //!< ExecPart() calls
+        kStatNExecSplit,                    //!< ExecSplit() calls
+        kStatNExecSplitPkt,                 //!< ExecSplit() packets send
+        kStatNExecAsync,                    //!< ExecAsync() calls
+        kStatNExecAsyncDrain,               //!< ExecAsync() lists drained
+        kStatNExecAsyncTout,                //!< ExecAsync() response timeouts
         kStatNCmd,                          //!< commands executed
         kStatNRreg,                         //!< rreg commands
         kStatNRblk,                         //!< rblk commands
@@ -219,12 +259,54 @@ namespace Retro {
         kStatNErrLen,                       //!< decode: length mismatch
         kStatNErrCrc,                       //!< decode: crc mismatch
         kStatNErrNak,                       //!< decode: nak seen
+        kStatNBsAutoGrow,                   //!< auto block size increased
+        kStatNBsAutoShrink,                 //!< auto block size decreased
         kDimStat
       };
 
+    // histogram counter indices (log2 binned, see HistStats())
+      enum histstats {
+        kHistRtt      = 0,                  //!< packet round trip time (usec)
+        kHistSndByte  = kHistRtt      + 13, //!< bytes per request packet
+        kHistRcvByte  = kHistSndByte  + 13, //!< bytes per response packet
+        kHistPktCmd   = kHistRcvByte  + 13, //!< commands per packet
+        kHistRblkWord = kHistPktCmd   +  8, //!< words per rblk
+        kHistWblkWord = kHistRblkWord + 13, //!< words per wblk
+        kHistCls      = kHistWblkWord + 13, //!< per packet class histograms
+        kHistClsRtt   = 0,                  //!< class: round trip time (usec)
+        kHistClsByte  = kHistClsRtt   + 13, //!< class: request+response bytes
+        kDimHistCls   = kHistClsByte  + 13, //!< class: number of counters
+        kHistClsMix   = 6,                  //!< class of mixed/init packets
+        kNHistCls     = kHistClsMix   +  1, //!< number of packet classes
+        kDimHist      = kHistCls + kNHistCls*kDimHistCls
+      };
+
     protected: 
+      struct HistPkt {
+        Rtime         fTsSnd;               //!< send time
+        size_t        fSndByte;             //!< request packet size
+        size_t        fCls;                 //!< packet class
+      };
+
+      struct AsyncDsc {
+        RlinkCommandList* fpClist;          //!< command list
+        RlinkContext* fpCntx;               //!< context
+        exechdl_t     fHandler;             //!< completion handler
+        Rtime         fDeadline;            //!< response deadline when send
+      };
+
+      void          ExecSetup(RlinkCommandList& clist, RlinkContext& cntx);
+      void          ExecFinish(RlinkCommandList& clist, RlinkContext& cntx);
       bool          ExecPart(RlinkCommandList& clist, size_t ibeg, size_t iend, 
                              RerrMsg& emsg);
+      bool          ExecSplit(RlinkCommandList& clist, RerrMsg& emsg);
+      size_t        RbufUsage(const RlinkCommand& cmd) const;
+      bool          AsyncSend(RerrMsg& emsg);
+      void          AsyncDecode();
+      void          AsyncDone(bool ok);
+      bool          AsyncDrain(RerrMsg& emsg);
+      void          ProcessAsyncData();
+      void          AsyncTimeout();
 
       void          EncodeRequest(RlinkCommandList& clist, size_t ibeg, 
                                   size_t iend);
@@ -235,6 +317,8 @@ namespace Retro {
       void          AcceptResponse();
       void          ProcessUnsolicitedData();
       void          ProcessAttnNotify();
+      void          LogSetFile(const std::shared_ptr<RlogFile>& splog,
+                               bool shared);
       [[noreturn]] void BadPort(const char* meth);
 
     protected: 
@@ -248,6 +332,8 @@ namespace Retro {
       RlinkContext  fContext;               //!< default context
       RlinkAddrMap  fAddrMap;               //!< name<->address mapping
       Rstats        fStats;                 //!< statistics
+      Rstats        fHistStats;             //!< histograms
+      std::deque<HistPkt> fHistPkt;         //!< send info of pkts in flight
       uint32_t      fLogBaseAddr;           //!< log: base for addr
       uint32_t      fLogBaseData;           //!< log: base for data
       uint32_t      fLogBaseStat;           //!< log: base for stat
@@ -255,13 +341,21 @@ namespace Retro {
       uint32_t      fDumpLevel;             //!< dump  0=off,1=err,2=chk,3=all
       uint32_t      fTraceLevel;            //!< trace 0=off,1=buf,2=char
       Rtime         fTimeout;               //!< response timeout
+      size_t        fExecWindow;            //!< max packets in flight in Exec
+      uint32_t      fSpinTime;              //!< port busy-poll budget in usec
+      std::deque<AsyncDsc> fAsyncList;      //!< queued ExecAsync() lists
+      size_t        fAsyncNSnd;             //!< fAsyncList entries send
+      uint64_t      fAsyncTimer;            //!< server timer id (0 if none)
       std::shared_ptr<RlogFile> fspLog;     //!< log file ptr
+      bool          fLogShared;             //!< fspLog from RlogFileCatalog
       std::recursive_mutex fConnectMutex;   //!< mutex to lock whole connect
       uint16_t      fAttnNotiPatt;          //!< attn notifier pattern
       Rtime         fTsLastAttnNoti;        //!< time stamp last attn notify
       uint32_t      fSysId;                 //!< SYSID of connected device
       uint32_t      fUsrAcc;                //!< USR_ACCESS of connected device
       size_t        fRbufSize;              //!< Rbuf size (in bytes)
+      size_t        fBsAutoLvl;             //!< adaptive block size level
+      double        fBsAutoRate[kBlockSizeAutoNLvl]; //!< rate per level (w/s)
       bool          fHasRbmon;              //!< has rbd_rbmon (rbus monitor)
   };
   
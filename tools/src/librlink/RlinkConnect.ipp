@@ -1,9 +1,14 @@
 // $Id: RlinkConnect.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   2.9.1  SetServer() moved to .cpp
+// 2026-10-18  1218   2.11   add SpinTime()
+// 2026-10-18  1207   2.10   add HistStats()
+// 2026-10-18  1205   2.9    add ExecAsyncPending()
+// 2026-10-18  1202   2.8    add ExecWindow()
 // 2019-06-07  1160   2.7.1  Stats() not longer const
 // 2018-12-08  1079   2.7    add HasPort; return ref for Port()
 // 2018-12-07  1078   2.6.1  use std::shared_ptr instead of boost
@@ -82,15 +87,6 @@ inline RlinkContext& RlinkConnect::Context()
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
-inline void RlinkConnect::SetServer(RlinkServer* pserv)
-{
-  fpServ = pserv;
-  return;
-}
-
-//------------------------------------------+-----------------------------------
-//! FIXME_docs
-
 inline RlinkServer* RlinkConnect::Server() const
 {
   return fpServ;
@@ -220,6 +216,14 @@ inline Rstats& RlinkConnect::RcvStats()
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline Rstats& RlinkConnect::HistStats()
+{
+  return fHistStats;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline uint32_t RlinkConnect::LogBaseAddr() const
 {
   return fLogBaseAddr;
@@ -276,6 +280,30 @@ inline const Rtime& RlinkConnect::Timeout() const
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline size_t RlinkConnect::ExecWindow() const
+{
+  return fExecWindow;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns busy-poll budget of port in usec, see SetSpinTime()
+
+inline uint32_t RlinkConnect::SpinTime() const
+{
+  return fSpinTime;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of ExecAsync() lists not yet completed.
+
+inline size_t RlinkConnect::ExecAsyncPending() const
+{
+  return fAsyncList.size();
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline RlogFile& RlinkConnect::LogFile() const
 {
   return *fspLog;
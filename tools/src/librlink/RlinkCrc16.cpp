@@ -4,6 +4,7 @@
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1203   1.1    add AddData(const uint8_t*,size_t) (slice-by-8)
 // 2014-11-08   602   1.0    Initial version
 // ---------------------------------------------------------------------------
 
@@ -11,6 +12,8 @@
   \brief   Implemenation of class RlinkCrc16.
  */
 
+#include "librtools/Rexception.hpp"
+
 #include "RlinkCrc16.hpp"
 
 using namespace std;
@@ -24,7 +27,82 @@ using namespace std;
 namespace Retro {
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+// slice-by-8 tables, fTab[k][b] is the crc of byte b followed by k zero bytes
+
+namespace {
+  struct Crc16SliceTable {
+    uint16_t        fTab[8][256];
+    explicit        Crc16SliceTable(const uint16_t* ptab);
+    uint16_t        Crc8(uint16_t crc, const uint8_t*& pdata, 
+                         size_t& count) const;
+  };
+
+  Crc16SliceTable::Crc16SliceTable(const uint16_t* ptab)
+  {
+    for (size_t b=0; b<256; b++) fTab[0][b] = ptab[b];
+    for (size_t k=1; k<8; k++) {
+      for (size_t b=0; b<256; b++) {
+        uint16_t crc = fTab[k-1][b];
+        fTab[k][b] = uint16_t(crc<<8) ^ ptab[crc>>8];
+      }
+    }
+  }
+
+  // process all complete 8 byte chunks, advances pdata and count
+  uint16_t Crc16SliceTable::Crc8(uint16_t crc, const uint8_t*& pdata,
+                                 size_t& count) const
+  {
+    const uint8_t* p = pdata;
+    const uint8_t* pend = p + (count & ~size_t(7));
+    while (p < pend) {
+      crc = fTab[7][p[0]^(crc>>8)] ^ fTab[6][p[1]^(crc&0xff)] ^
+            fTab[5][p[2]] ^ fTab[4][p[3]] ^ fTab[3][p[4]] ^
+            fTab[2][p[5]] ^ fTab[1][p[6]] ^ fTab[0][p[7]];
+      p += 8;
+    }
+    count -= p - pdata;
+    pdata  = p;
+    return crc;
+  }
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a block of data to the crc.
+/*!
+  Equivalent to calling AddData(uint8_t) for each byte, but processes 8 bytes
+  per iteration with a slice-by-8 algorithm. The slice tables are derived
+  from fCrc16Table on first use and verified against the byte-wise algorithm.
+
+  \param pdata  pointer to data
+  \param count  number of bytes
+ */
+
+void RlinkCrc16::AddData(const uint8_t* pdata, size_t count)
+{
+  static const Crc16SliceTable stab(fCrc16Table);
+  static const bool selfcheck = [](){
+    uint8_t data[61];                       // odd length, tests tail handling
+    for (size_t i=0; i<sizeof(data); i++) data[i] = uint8_t(37*i+11);
+    RlinkCrc16 crcref;
+    for (auto& o: data) crcref.AddData(o);
+    const uint8_t* p = data;
+    size_t n = sizeof(data);
+    RlinkCrc16 crcblk;
+    crcblk.fCrc = stab.Crc8(crcblk.fCrc, p, n);
+    while (n--) crcblk.AddData(*p++);
+    return crcref.Crc() == crcblk.Crc();
+  }();
+  if (!selfcheck)
+    throw Rexception("RlinkCrc16::AddData()", 
+                     "BugCheck: slice-by-8 self-check failed");
+
+  fCrc = stab.Crc8(fCrc, pdata, count);
+  while (count--) AddData(*pdata++);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! crc16 lookup table for polynomial 0x1021 (CCITT, msb first)
 
 const uint16_t RlinkCrc16::fCrc16Table[256] =
 { 
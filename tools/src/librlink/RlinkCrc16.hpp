@@ -4,6 +4,7 @@
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1203   1.1    add AddData(const uint8_t*,size_t) (slice-by-8)
 // 2018-12-22  1091   1.0.1  Drop empty dtors for pod-only classes
 // 2014-11-08   602   1.0    Initial version
 // ---------------------------------------------------------------------------
@@ -16,6 +17,7 @@
 #ifndef included_Retro_RlinkCrc16
 #define included_Retro_RlinkCrc16 1
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -27,6 +29,7 @@ namespace Retro {
 
       void          Clear();
       void          AddData(uint8_t data);
+      void          AddData(const uint8_t* pdata, size_t count);
       uint16_t      Crc() const;    
 
     protected: 
@@ -1,9 +1,10 @@
 // $Id: RlinkPacketBuf.cpp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2017 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1204   2.1    add FindEsc() (sse2/avx2 with scalar fallback)
 // 2019-07-27  1198   2.0.4  add kNc* definitions
 // 2017-04-07   868   2.0.1  Dump(): add detail arg
 // 2014-11-23   606   2.0    re-organize for rlink v4
@@ -19,6 +20,12 @@
   \brief   Implemenation of class RlinkPacketBuf.
  */
 
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "RlinkPacketBuf.hpp"
 
 #include "librtools/RosFill.hpp"
@@ -110,4 +117,72 @@ void RlinkPacketBuf::Dump(std::ostream& os, int ind, const char* text,
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Find first byte which must be escaped.
+/*!
+  Scans the range [pbeg,pend) for kSymEsc, and when \a xon is \c true also
+  for kSymXon and kSymXoff. Used by the framing engines of the send and
+  receive side to locate the end of a run of plain data, which can then be
+  block-copied. With AVX2 or SSE2 available 32 or 16 bytes are tested per
+  step, otherwise a byte-wise scan (or memchr) is used.
+
+  \param pbeg  begin of range
+  \param pend  end of range
+  \param xon   if \c true also stop at xon and xoff
+  \returns pointer to first byte to be escaped, or \a pend if none found
+ */
+
+const uint8_t* RlinkPacketBuf::FindEsc(const uint8_t* pbeg, 
+                                       const uint8_t* pend, bool xon)
+{
+  const uint8_t* p = pbeg;
+
+#if defined(__AVX2__)
+  {
+    const __m256i vesc  = _mm256_set1_epi8(char(kSymEsc));
+    const __m256i vxon  = _mm256_set1_epi8(char(kSymXon));
+    const __m256i vxoff = _mm256_set1_epi8(char(kSymXoff));
+    while (pend - p >= 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      __m256i m = _mm256_cmpeq_epi8(v, vesc);
+      if (xon) m = _mm256_or_si256(m,
+                     _mm256_or_si256(_mm256_cmpeq_epi8(v, vxon),
+                                     _mm256_cmpeq_epi8(v, vxoff)));
+      uint32_t mask = uint32_t(_mm256_movemask_epi8(m));
+      if (mask) return p + __builtin_ctz(mask);
+      p += 32;
+    }
+  }
+#endif
+
+#if defined(__SSE2__)
+  {
+    const __m128i vesc  = _mm_set1_epi8(char(kSymEsc));
+    const __m128i vxon  = _mm_set1_epi8(char(kSymXon));
+    const __m128i vxoff = _mm_set1_epi8(char(kSymXoff));
+    while (pend - p >= 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      __m128i m = _mm_cmpeq_epi8(v, vesc);
+      if (xon) m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, vxon),
+                                                _mm_cmpeq_epi8(v, vxoff)));
+      uint32_t mask = uint32_t(_mm_movemask_epi8(m));
+      if (mask) return p + __builtin_ctz(mask);
+      p += 16;
+    }
+  }
+#else
+  if (!xon) {                               // single symbol: use memchr
+    const void* pesc = memchr(p, kSymEsc, size_t(pend-p));
+    return pesc ? static_cast<const uint8_t*>(pesc) : pend;
+  }
+#endif
+
+  while (p < pend) {                        // tail (or generic fallback)
+    uint8_t c = *p;
+    if (c == kSymEsc || (xon && (c == kSymXon || c == kSymXoff))) break;
+    p += 1;
+  }
+  return p;
+}
+
 } // end namespace Retro
@@ -1,9 +1,10 @@
 // $Id: RlinkPacketBuf.hpp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1204   2.1    add FindEsc()
 // 2019-07-27  1198   2.0.4  add kNc* definitions
 // 2019-06-07  1160   2.0.3  Stats() not longer const
 // 2018-12-16  1084   2.0.2  use =delete for noncopyable instead of boost
@@ -90,6 +91,9 @@ namespace Retro {
       void          SetFlagBit(uint32_t mask);
       void          ClearFlagBit(uint32_t mask);
 
+      static const uint8_t* FindEsc(const uint8_t* pbeg, const uint8_t* pend,
+                                    bool xon);
+
     protected: 
       std::vector<uint8_t> fPktBuf;         //!< packet buffer
       RlinkCrc16    fCrc;                   //!< crc accumulator
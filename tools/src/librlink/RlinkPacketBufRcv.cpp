@@ -1,9 +1,14 @@
 // $Id: RlinkPacketBufRcv.cpp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1210   1.4    add streamed receive of blocks directly into
+//                           destination buffers: AddBlock(),QueueBlocks(),
+//                           ClearBlocks(),GetBlockWithCrc(),PutData()
+// 2026-10-18  1204   1.3    ProcessDataFill(): use FindEsc(), block-copy
+// 2026-10-18  1203   1.2.4  GetWithCrc(uint16_t*,..): use bulk crc AddData()
 // 2019-07-27  1198   1.2.3  add Nak handling
 // 2019-06-14  1163   1.2.2  ReadData(): coverity fixup (logically dead code)
 // 2018-12-23  1091   1.2.1  ReadData(): remove port open check, done at caller
@@ -20,6 +25,7 @@
  */
 
 #include <sys/time.h>
+#include <string.h>
 
 #include <iostream>
 
@@ -51,7 +57,18 @@ RlinkPacketBufRcv::RlinkPacketBufRcv()
     fEscSeen(false),
     fNakIndex(-1),
     fNakCode(0),
-    fDropData()
+    fDropData(),
+    fBlkSetup(),
+    fBlkQueue(),
+    fBlkList(),
+    fCrcPos(),
+    fCrcIdx(0),
+    fBlkRcv(0),
+    fBlkNRcvd(0),
+    fBlkGet(0),
+    fBlkNGet(0),
+    fRxCrc(),
+    fRxCrcDone(0)
 {
   // Statistic setup
   fStats.Define(kStatNRxPktByt,    "NRxPktByt",    "Rx packet bytes rcvd");
@@ -71,6 +88,8 @@ RlinkPacketBufRcv::RlinkPacketBufRcv()
   fStats.Define(kStatNRxNakRtOvlf, "NRxNakRtOvlf", "Rx NAK RtOvlf seen");
   fStats.Define(kStatNRxNakRtWblk, "NRxNakRtWblk", "Rx NAK RtWblk seen");
   fStats.Define(kStatNRxNakInval,  "NRxNakInval",  "Rx NAK invalid seen");
+  fStats.Define(kStatNRxBlk,       "NRxBlk",       "Rx blocks rcvd streamed");
+  fStats.Define(kStatNRxBlkByt,    "NRxBlkByt",    "Rx block bytes streamed");
 }
 
 //------------------------------------------+-----------------------------------
@@ -149,6 +168,15 @@ void RlinkPacketBufRcv::AcceptPacket()
   fNakIndex = -1;
   fNakCode  =  0;
   fDropData.clear();
+  fBlkList.clear();
+  fCrcPos.clear();
+  fCrcIdx    = 0;
+  fBlkRcv    = 0;
+  fBlkNRcvd  = 0;
+  fBlkGet    = 0;
+  fBlkNGet   = 0;
+  fRxCrc.Clear();
+  fRxCrcDone = 0;
   return;
 }
   
@@ -163,6 +191,79 @@ void RlinkPacketBufRcv::FlushRaw()
   return;
 }
   
+//------------------------------------------+-----------------------------------
+//! Add a block to be received streamed for the packet in setup.
+/*!
+  The data of the block will be written directly into \a pdata while the
+  response packet is received, instead of being kept in the packet buffer.
+  \a pdata must stay valid until the response is processed or the block
+  setup is discarded with ClearBlocks(). Only done on little-endian hosts,
+  where the byte order on the link is the memory layout of the words, and
+  for blocks of at least kBlkMinWord words. Otherwise the data is copied
+  by GetBlockWithCrc() as usual.
+
+  \param offset  position of the block in the response packet
+  \param pdata   pointer to destination buffer
+  \param count   number of words
+ */
+
+void RlinkPacketBufRcv::AddBlock(size_t offset, uint16_t* pdata, size_t count)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  if (count >= kBlkMinWord) {
+    fBlkSetup.fBlk.push_back(BlkDsc{offset, reinterpret_cast<uint8_t*>(pdata),
+                               2*count, 0, RlinkCrc16()});
+  }
+#endif
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a crc field for the packet in setup.
+/*!
+  The crc fields are not part of the packet crc, their position must be
+  known to calculate the crc of streamed blocks on the fly.
+
+  \param offset  position of the crc field in the response packet
+ */
+
+void RlinkPacketBufRcv::AddCrcField(size_t offset)
+{
+  fBlkSetup.fCrcPos.push_back(offset);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Queue the blocks of the packet in setup.
+/*!
+  Must be called for each request packet send, the queued block lists are
+  attached in order to the received response packets.
+ */
+
+void RlinkPacketBufRcv::QueueBlocks()
+{
+  if (fBlkSetup.fBlk.empty()) fBlkSetup.fCrcPos.clear(); // crc not needed
+  fBlkQueue.push_back(move(fBlkSetup));
+  fBlkSetup.fBlk.clear();
+  fBlkSetup.fCrcPos.clear();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Discard all queued block lists.
+/*!
+  Must be called when responses are lost, and before the destination buffers
+  of queued blocks become invalid. The current packet is not affected.
+ */
+
+void RlinkPacketBufRcv::ClearBlocks()
+{
+  fBlkSetup.fBlk.clear();
+  fBlkSetup.fCrcPos.clear();
+  fBlkQueue.clear();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -178,8 +279,43 @@ RlinkPacketBufRcv::pkt_state RlinkPacketBufRcv::PacketState()
 
 void RlinkPacketBufRcv::GetWithCrc(uint16_t* pdata, size_t count)
 {
+  const uint8_t* pi = fPktBuf.data() + fNDone;
+  fCrc.AddData(pi, 2*count);
+  fNDone += 2*count;
   uint16_t* pend = pdata + count;
-  while (pdata < pend) GetWithCrc(*pdata++);
+  while (pdata < pend) {
+    *pdata++ = uint16_t(pi[0]) | (uint16_t(pi[1]) << 8);
+    pi += 2;
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Get a data block, either already streamed or from the packet buffer.
+/*!
+  Blocks registered with AddBlock() are already in the destination buffer,
+  in this case only the crc is updated. \a pdata must be the buffer given
+  to AddBlock().
+
+  \param pdata  pointer to data
+  \param count  number of words
+ */
+
+void RlinkPacketBufRcv::GetBlockWithCrc(uint16_t* pdata, size_t count)
+{
+  if (fBlkGet < fBlkList.size() && 
+      fBlkList[fBlkGet].fOffset == fNDone+fBlkNGet) {
+    BlkDsc& blk = fBlkList[fBlkGet];
+    if (blk.fpData != reinterpret_cast<uint8_t*>(pdata) ||
+        blk.fSize != 2*count || blk.fNRcvd != blk.fSize)
+      throw Rexception("RlinkPacketBufRcv::GetBlockWithCrc()", 
+                       "BugCheck: block mismatch");
+    fCrc      = blk.fCrc;
+    fBlkGet  += 1;
+    fBlkNGet += blk.fSize;
+    return;
+  }
+  GetWithCrc(pdata, count);
   return;
 }
 
@@ -202,6 +338,11 @@ void RlinkPacketBufRcv::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fEscSeen:      " << RosPrintf(fEscSeen) << endl;
   os << bl << "  fNakIndex:     " << RosPrintf(fNakIndex,"d",4) << endl;
   os << bl << "  fNakCode:      " << RosPrintf(fNakCode,"d",4) << endl;
+  os << bl << "  fBlkQueue.size:" << RosPrintf(fBlkQueue.size(),"d",4) << endl;
+  os << bl << "  fBlkList.size: " << RosPrintf(fBlkList.size(),"d",4) << endl;
+  os << bl << "  fBlkRcv:       " << RosPrintf(fBlkRcv,"d",4) << endl;
+  os << bl << "  fBlkNRcvd:     " << RosPrintf(fBlkNRcvd,"d",4) << endl;
+  os << bl << "  fBlkGet:       " << RosPrintf(fBlkGet,"d",4) << endl;
 
   os << bl << "  fDropData.size:" << RosPrintf(fDropData.size(),"d",4);
   size_t ncol  = max(1, (80-ind-4-6)/(2+1));
@@ -231,6 +372,11 @@ void RlinkPacketBufRcv::ProcessDataIdle()
       case kEcSop:
         SetFlagBit(kFlagSopSeen);
         fRcvState = kRcvFill;
+        if (!fBlkQueue.empty()) {           // attach blocks of oldest request
+          fBlkList = move(fBlkQueue.front().fBlk);
+          fCrcPos  = move(fBlkQueue.front().fCrcPos);
+          fBlkQueue.pop_front();
+        }
         return;
         
       case kEcAttn:
@@ -318,10 +464,10 @@ void RlinkPacketBufRcv::ProcessDataFill()
         break;
         
       // data escapes seen: add escaped char and continue
-      case kEcXon:   fPktBuf.push_back(kSymXon);  break;
-      case kEcXoff:  fPktBuf.push_back(kSymXoff); break;
-      case kEcFill:  fPktBuf.push_back(kSymFill); break;
-      case kEcEsc:   fPktBuf.push_back(kSymEsc);  break;
+      case kEcXon:   PutData(kSymXon);  break;
+      case kEcXoff:  PutData(kSymXoff); break;
+      case kEcFill:  PutData(kSymFill); break;
+      case kEcEsc:   PutData(kSymEsc);  break;
         
       case kEcClobber:                      // Clobber(ed) escape seen
         SetFlagBit(kFlagErrClobber);        // -> set clobber error and return
@@ -336,24 +482,73 @@ void RlinkPacketBufRcv::ProcessDataFill()
     } // if (fEscSeen)
 
     // handle plain data (till next escape)
-    uint8_t* pi   = fRawBuf+fRawBufDone;
-    uint8_t* pend = fRawBuf+fRawBufSize;
+    const uint8_t* pi   = fRawBuf+fRawBufDone;
+    const uint8_t* pend = fRawBuf+fRawBufSize;
+    const uint8_t* pesc = FindEsc(pi, pend, false);
     
-    while (pi < pend) {
-      uint8_t c = *pi++;
-      if (c == kSymEsc) {
-        fEscSeen = true;
-        break;
-      }
-      fPktBuf.push_back(c);
+    PutData(pi, pesc);                      // copy run of plain data
+    if (pesc < pend) {
+      fEscSeen = true;
+      pesc += 1;
     }
-    fRawBufDone = pi - fRawBuf;
+    fRawBufDone = pesc - fRawBuf;
 
   } // while (fRawBufDone < fRawBufSize)
   
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Store unescaped packet data.
+/*!
+  Data is appended to the packet buffer, except for the parts which belong
+  to a streamed block of the current packet, those are written directly
+  into the destination buffer. The crc of the data up to the end of each
+  block is calculated on the fly and kept with the block.
+ */
+
+void RlinkPacketBufRcv::PutData(const uint8_t* pbeg, const uint8_t* pend)
+{
+  while (pbeg < pend) {
+    if (fBlkRcv == fBlkList.size()) {       // no block pending
+      fPktBuf.insert(fPktBuf.end(), pbeg, pend);
+      return;
+    }
+
+    BlkDsc& blk = fBlkList[fBlkRcv];
+    size_t npos = fPktBuf.size() + fBlkNRcvd;
+    if (npos < blk.fOffset) {               // data before block
+      size_t nbyte = min(size_t(pend-pbeg), blk.fOffset-npos);
+      fPktBuf.insert(fPktBuf.end(), pbeg, pbeg+nbyte);
+      pbeg += nbyte;
+      continue;
+    }
+
+    if (blk.fNRcvd == 0) {                  // block start: update crc
+      while (fCrcIdx < fCrcPos.size() && fCrcPos[fCrcIdx] < blk.fOffset) {
+        size_t icrc = fCrcPos[fCrcIdx++] - fBlkNRcvd;  // skip crc fields
+        fRxCrc.AddData(fPktBuf.data()+fRxCrcDone, icrc-fRxCrcDone);
+        fRxCrcDone = icrc+2;
+      }
+      fRxCrc.AddData(fPktBuf.data()+fRxCrcDone, fPktBuf.size()-fRxCrcDone);
+      fRxCrcDone = fPktBuf.size();
+    }
+    size_t nbyte = min(size_t(pend-pbeg), blk.fSize-blk.fNRcvd);
+    ::memcpy(blk.fpData+blk.fNRcvd, pbeg, nbyte);
+    fRxCrc.AddData(pbeg, nbyte);
+    blk.fNRcvd += nbyte;
+    fBlkNRcvd  += nbyte;
+    pbeg       += nbyte;
+    if (blk.fNRcvd == blk.fSize) {          // block done: keep crc
+      blk.fCrc = fRxCrc;
+      fBlkRcv += 1;
+      fStats.Inc(kStatNRxBlk);
+      fStats.Inc(kStatNRxBlkByt, double(blk.fSize));
+    }
+  }
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -1,9 +1,12 @@
 // $Id: RlinkPacketBufRcv.hpp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1210   1.3    add AddBlock(),AddCrcField(),QueueBlocks(),
+//                           ClearBlocks(),GetBlockWithCrc(),PktSize();
+//                           stream rblk data
 // 2019-07-27  1198   1.2.1  add Nak handling
 // 2018-12-08  1079   1.2    use ref not ptr for RlinkPort
 // 2017-04-07   868   1.1.1  Dump(): add detail arg
@@ -21,6 +24,9 @@
 #ifndef included_Retro_RlinkPacketBufRcv
 #define included_Retro_RlinkPacketBufRcv 1
 
+#include <vector>
+#include <deque>
+
 #include "RlinkPacketBuf.hpp"
 #include "RlinkPort.hpp"
 
@@ -38,6 +44,11 @@ namespace Retro {
       void          AcceptPacket();
       void          FlushRaw();
 
+      void          AddBlock(size_t offset, uint16_t* pdata, size_t count);
+      void          AddCrcField(size_t offset);
+      void          QueueBlocks();
+      void          ClearBlocks();
+
       enum pkt_state {
         kPktPend=0,                         //!< pending, still being filled
         kPktResp,                           //!< response packet (SOP+EOP)
@@ -51,7 +62,10 @@ namespace Retro {
       void          GetWithCrc(uint8_t& data);
       void          GetWithCrc(uint16_t& data);
       void          GetWithCrc(uint16_t* pdata, size_t count);
+      void          GetBlockWithCrc(uint16_t* pdata, size_t count);
       bool          CheckCrc();
+
+      size_t        PktSize() const;
  
       int           NakIndex() const;
       uint8_t       NakCode() const;
@@ -77,12 +91,32 @@ namespace Retro {
         kStatNRxNakCnt,                     //!< Rx NAK Cnt    seen
         kStatNRxNakRtOvlf,                  //!< Rx NAK RtOvlf seen
         kStatNRxNakRtWblk,                  //!< Rx NAK RtWblk seen
-        kStatNRxNakInval                    //!< Rx NAK invalid seen
+        kStatNRxNakInval,                   //!< Rx NAK invalid seen
+        kStatNRxBlk,                        //!< Rx blocks rcvd streamed
+        kStatNRxBlkByt                      //!< Rx block bytes rcvd streamed
       };
 
+    // blocks with at least this many words are received streamed
+      static const size_t kBlkMinWord = 16;
+
     protected:
+      struct BlkDsc {
+        size_t      fOffset;                //!< position in packet
+        uint8_t*    fpData;                 //!< pointer to block buffer
+        size_t      fSize;                  //!< block size in bytes
+        size_t      fNRcvd;                 //!< bytes received
+        RlinkCrc16  fCrc;                   //!< crc after block
+      };
+
+      struct BlkPkt {
+        std::vector<BlkDsc> fBlk;           //!< streamed blocks
+        std::vector<size_t> fCrcPos;        //!< position of crc fields
+      };
+
       void          ProcessDataIdle();
       void          ProcessDataFill();
+      void          PutData(const uint8_t* pbeg, const uint8_t* pend);
+      void          PutData(uint8_t data);
       uint8_t       GetEcode();
 
       enum rcv_state {
@@ -102,6 +136,17 @@ namespace Retro {
       int           fNakIndex;              //!< index of active nak (-1 if no)
       uint8_t       fNakCode;               //!< code  of active nak
       std::vector<uint8_t> fDropData;       //!< dropped data buffer    
+      BlkPkt        fBlkSetup;              //!< blocks of packet in setup
+      std::deque<BlkPkt> fBlkQueue;         //!< blocks of packets in flight
+      std::vector<BlkDsc> fBlkList;         //!< blocks of current packet
+      std::vector<size_t> fCrcPos;          //!< crc fields of current packet
+      size_t        fCrcIdx;                //!< index of next crc field
+      size_t        fBlkRcv;                //!< index of block in receive
+      size_t        fBlkNRcvd;              //!< block bytes received
+      size_t        fBlkGet;                //!< index of block to get
+      size_t        fBlkNGet;               //!< block bytes got
+      RlinkCrc16    fRxCrc;                 //!< crc of received data
+      size_t        fRxCrcDone;             //!< fPktBuf bytes in fRxCrc
   };
   
 } // end namespace Retro
@@ -1,9 +1,11 @@
 // $Id: RlinkPacketBufRcv.ipp 1198 2019-07-27 19:08:31Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1210   1.1    add PktSize(), PutData(uint8_t); CheckSize():
+//                           handle streamed blocks
 // 2019-07-27  1198   1.0.1  add Nak handling
 // 2014-11-23   606   1.0    Initial version
 // 2014-11-02   600   0.1    First draft (re-organize PacketBuf for rlink v4)
@@ -29,6 +31,15 @@ inline bool RlinkPacketBufRcv::CheckNak() const
 
 inline bool RlinkPacketBufRcv::CheckSize(size_t nbyte) const
 {
+  // the streamed blocks located within the next nbyte are not in fPktBuf
+  size_t npos = fNDone + fBlkNGet;
+  for (size_t i=fBlkGet; i<fBlkList.size(); i++) {
+    const BlkDsc& blk = fBlkList[i];
+    if (blk.fOffset >= npos+nbyte) break;
+    if (blk.fOffset+blk.fSize > npos+nbyte) return false;
+    if (blk.fNRcvd != blk.fSize) return false;
+    nbyte -= blk.fSize;
+  }
   return fPktBuf.size()-fNDone >= nbyte;
 }
 
@@ -56,6 +67,14 @@ inline void RlinkPacketBufRcv::GetWithCrc(uint16_t& data)
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline size_t RlinkPacketBufRcv::PktSize() const
+{
+  return fPktBuf.size() + fBlkNRcvd;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline bool RlinkPacketBufRcv::CheckCrc()
 {
   uint8_t  datl = fPktBuf[fNDone++];
@@ -80,4 +99,17 @@ inline uint8_t RlinkPacketBufRcv::NakCode() const
   return fNakCode;
 }
 
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline void RlinkPacketBufRcv::PutData(uint8_t data)
+{
+  if (fBlkRcv == fBlkList.size()) {
+    fPktBuf.push_back(data);
+  } else {
+    PutData(&data, &data+1);
+  }
+  return;
+}
+
 } // end namespace Retro
@@ -1,9 +1,13 @@
 // $Id: RlinkPacketBufSnd.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1209   1.4    add PutBlock(); SndPacket(): escape blocks directly
+//                           from user memory (zero-copy)
+// 2026-10-18  1204   1.3    SndPacket(): use FindEsc(), block-copy plain runs
+// 2026-10-18  1203   1.2.4  PutWithCrc(uint16_t*,..): use bulk crc AddData()
 // 2018-12-23  1091   1.2.3  SndRaw(): remove port open check, done at caller
 // 2018-12-19  1090   1.2.2  use RosPrintf(bool)
 // 2018-12-18  1089   1.2.1  use c++ style casts
@@ -42,12 +46,16 @@ namespace Retro {
 
 RlinkPacketBufSnd::RlinkPacketBufSnd()
   : fXonEscape(false),
-    fRawBuf()
+    fRawBuf(),
+    fBlkList(),
+    fBlkSize(0)
 {
   // Statistic setup
   fStats.Define(kStatNTxPktByt, "NTxPktByt", "Tx packet bytes send");
   fStats.Define(kStatNTxEsc,    "NTxEsc",    "Tx esc escapes");
   fStats.Define(kStatNTxXEsc,   "NTxXEsc",   "Tx xon escapes");
+  fStats.Define(kStatNTxBlk,    "NTxBlk",    "Tx blocks send zero-copy");
+  fStats.Define(kStatNTxBlkByt, "NTxBlkByt", "Tx block bytes send zero-copy");
 }
 
 //------------------------------------------+-----------------------------------
@@ -63,6 +71,8 @@ void RlinkPacketBufSnd::Init()
 {
   fPktBuf.clear();
   fRawBuf.clear();
+  fBlkList.clear();
+  fBlkSize = 0;
   fCrc.Clear();
   fFlags = 0;
   
@@ -74,8 +84,46 @@ void RlinkPacketBufSnd::Init()
 
 void RlinkPacketBufSnd::PutWithCrc(const uint16_t* pdata, size_t count)
 {
+  size_t nbeg = fPktBuf.size();
+  fPktBuf.resize(nbeg + 2*count);
+  uint8_t* pbeg = fPktBuf.data() + nbeg;
+  uint8_t* po   = pbeg;
   const uint16_t* pend = pdata + count;
-  while (pdata < pend) PutWithCrc(*pdata++);
+  while (pdata < pend) {
+    uint16_t data = *pdata++;
+    *po++ = uint8_t( data     & 0xff);
+    *po++ = uint8_t((data>>8) & 0xff);
+  }
+  fCrc.AddData(pbeg, 2*count);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a data block which is send directly from user memory.
+/*!
+  Like PutWithCrc(const uint16_t*,size_t), but the data is not copied into
+  the packet buffer. SndPacket() escapes it directly from \a pdata into
+  the raw buffer, so \a pdata must stay valid until SndPacket() is called.
+  Only done on little-endian hosts, where the memory layout of the words
+  is the byte order on the link, and for blocks of at least kBlkMinWord
+  words. Otherwise the data is copied with PutWithCrc().
+
+  \param pdata  pointer to data
+  \param count  number of words
+ */
+
+void RlinkPacketBufSnd::PutBlock(const uint16_t* pdata, size_t count)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  if (count >= kBlkMinWord) {
+    const uint8_t* pbyte = reinterpret_cast<const uint8_t*>(pdata);
+    fBlkList.push_back(BlkDsc{fPktBuf.size(), pbyte, 2*count});
+    fBlkSize += 2*count;
+    fCrc.AddData(pbyte, 2*count);
+    return;
+  }
+#endif
+  PutWithCrc(pdata, count);
   return;
 }
 
@@ -87,47 +135,61 @@ bool RlinkPacketBufSnd::SndPacket(RlinkPort& port, RerrMsg& emsg)
   size_t nesc  = 0;
   size_t nxesc = 0;
 
-  fRawBuf.reserve(2*fPktBuf.size()+4);      // max. size of raw data
+  fRawBuf.reserve(2*PktSize()+4);           // max. size of raw data
   fRawBuf.clear();
 
   PutRawEsc(kEcSop);                        // <SOP>
 
-  size_t   ni = fPktBuf.size();
-  uint8_t* pi = fPktBuf.data();
-  for (size_t i=0; i<ni; i++) {
-    uint8_t c = *pi++;
-
-    if (c == kSymEsc) {
-      PutRawEsc(kEcEsc);
-      nesc += 1;
-      continue;
-    }
-
-    if (fXonEscape) {
-      if (c == kSymXon) {
-        PutRawEsc(kEcXon);
-        nxesc += 1;
-        continue;
-      }
-      if (c == kSymXoff) {
-        PutRawEsc(kEcXoff);
-        nxesc += 1;
-        continue;
-      }
-    }
-
-    fRawBuf.push_back(c);
+  const uint8_t* pbuf = fPktBuf.data();
+  size_t ndone = 0;
+  for (auto& o: fBlkList) {                 // packet data up to block, block
+    PutRawData(pbuf+ndone, pbuf+o.fOffset, nesc, nxesc);
+    PutRawData(o.fpData, o.fpData+o.fSize, nesc, nxesc);
+    ndone = o.fOffset;
   }
+  PutRawData(pbuf+ndone, pbuf+fPktBuf.size(), nesc, nxesc);
 
   PutRawEsc(kEcEop);                        // <EOP>
   fStats.Inc(kStatNTxEsc,    double(nesc));
   fStats.Inc(kStatNTxXEsc,   double(nxesc));
+  if (!fBlkList.empty()) {
+    fStats.Inc(kStatNTxBlk,    double(fBlkList.size()));
+    fStats.Inc(kStatNTxBlkByt, double(fBlkSize));
+  }
 
   bool sndok = SndRaw(port, emsg);
   if (sndok) fStats.Inc(kStatNTxPktByt, double(PktSize()));
   return sndok;
 }
 
+//------------------------------------------+-----------------------------------
+//! Escape data and append it to the raw buffer.
+
+void RlinkPacketBufSnd::PutRawData(const uint8_t* pbeg, const uint8_t* pend,
+                                   size_t& nesc, size_t& nxesc)
+{
+  const uint8_t* pi = pbeg;
+  while (pi < pend) {
+    const uint8_t* pesc = FindEsc(pi, pend, fXonEscape);
+    fRawBuf.insert(fRawBuf.end(), pi, pesc); // copy run of plain data
+    if (pesc == pend) break;
+
+    uint8_t c = *pesc;
+    pi = pesc + 1;
+    if (c == kSymEsc) {
+      PutRawEsc(kEcEsc);
+      nesc += 1;
+    } else if (c == kSymXon) {
+      PutRawEsc(kEcXon);
+      nxesc += 1;
+    } else {
+      PutRawEsc(kEcXoff);
+      nxesc += 1;
+    }
+  }
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -211,6 +273,8 @@ void RlinkPacketBufSnd::Dump(std::ostream& os, int ind, const char* text,
   os << bl << (text?text:"--") << "RlinkPacketBufSnd @ " << this << endl;
 
   os << bl << "  fXonEscape:      " << RosPrintf(fXonEscape) << endl;
+  os << bl << "  fBlkList.size:   " << fBlkList.size() << endl;
+  os << bl << "  fBlkSize:        " << fBlkSize << endl;
 
   size_t rawbufsize = fRawBuf.size();
   os << bl << "  fRawBuf(size): " << RosPrintf(rawbufsize,"d",4);
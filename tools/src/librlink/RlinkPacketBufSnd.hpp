@@ -1,9 +1,10 @@
 // $Id: RlinkPacketBufSnd.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1209   1.3    add PutBlock(),PktSize(); send blocks zero-copy
 // 2018-12-08  1079   1.2    use ref not ptr for RlinkPort
 // 2017-04-07   868   1.1.2  Dump(): add detail arg
 // 2015-04-11   666   1.1    handle xon/xoff escaping, add (Set)XonEscape()
@@ -39,6 +40,7 @@ namespace Retro {
       void          PutWithCrc(uint8_t data);
       void          PutWithCrc(uint16_t data);
       void          PutWithCrc(const uint16_t* pdata, size_t count);
+      void          PutBlock(const uint16_t* pdata, size_t count);
       void          PutCrc();
 
       void          PutRawEsc(uint8_t ec);
@@ -51,6 +53,7 @@ namespace Retro {
       bool          SndNak(RlinkPort& port, RerrMsg& emsg);    
       bool          SndUnJam(RlinkPort& port, RerrMsg& emsg);
 
+      size_t        PktSize() const;
       size_t        RawSize() const;
 
       void          Dump(std::ostream& os, int ind=0, const char* text=0,
@@ -60,15 +63,30 @@ namespace Retro {
       enum stats {
         kStatNTxPktByt=0,                   //!< Tx packet bytes send
         kStatNTxEsc,                        //!< Tx esc escapes
-        kStatNTxXEsc                        //!< Tx xon escapes
+        kStatNTxXEsc,                       //!< Tx xon escapes
+        kStatNTxBlk,                        //!< Tx blocks send zero-copy
+        kStatNTxBlkByt                      //!< Tx block bytes send zero-copy
       };
 
+    // blocks with at least this many words are send zero-copy
+      static const size_t kBlkMinWord = 16;
+
     protected:
+      struct BlkDsc {
+        size_t      fOffset;                //!< position in fPktBuf
+        const uint8_t* fpData;              //!< pointer to block data
+        size_t      fSize;                  //!< block size in bytes
+      };
+
+      void          PutRawData(const uint8_t* pbeg, const uint8_t* pend,
+                               size_t& nesc, size_t& nxesc);
       bool          SndRaw(RlinkPort& port, RerrMsg& emsg);
 
     protected:
       bool          fXonEscape;             //!< escape XON/XOFF
       std::vector<uint8_t> fRawBuf;         //!< raw data buffer
+      std::vector<BlkDsc> fBlkList;         //!< blocks send from user memory
+      size_t        fBlkSize;               //!< total bytes in fBlkList
   };
   
 } // end namespace Retro
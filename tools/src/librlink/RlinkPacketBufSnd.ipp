@@ -1,9 +1,10 @@
 // $Id: RlinkPacketBufSnd.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2015 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1209   1.2    add PktSize()
 // 2015-04-11   666   1.1    handle xon/xoff escaping, add (Set)XonEscape()
 // 2014-11-08   602   1.0    Initial version
 // 2014-11-02   600   0.1    First draft (re-organize PacketBuf for rlink v4)
@@ -84,6 +85,14 @@ inline void RlinkPacketBufSnd::PutRawEsc(uint8_t ec)
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline size_t RlinkPacketBufSnd::PktSize() const
+{
+  return fPktBuf.size() + fBlkSize;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline size_t RlinkPacketBufSnd::RawSize() const
 {
   return fRawBuf.size();
@@ -1,9 +1,11 @@
 // $Id: RlinkPort.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.5.1  Read(): poll() timeout reduced by spin time
+// 2026-10-18  1218   1.5    add SpinRead(), SetSpinTime() for busy-poll in Read()
 // 2018-12-19  1090   1.4.4  use RosPrintf(bool)
 // 2018-12-18  1089   1.4.3  use c++ style casts
 // 2017-04-29   888   1.4.2  BUGFIX: RawRead(): proper irc for exactsize=false
@@ -74,6 +76,7 @@ RlinkPort::RlinkPort()
     fTraceLevel(0),
     fTsLastRead(),
     fTsLastWrite(),
+    fSpinTime(0),
     fStats()
 {
   fStats.Define(kStatNPortWrite,    "NPortWrite", "Port::Write() calls");
@@ -82,6 +85,9 @@ RlinkPort::RlinkPort()
   fStats.Define(kStatNPortRxByt,    "NPortRxByt", "Port Rx bytes rcvd");
   fStats.Define(kStatNPortRawWrite, "NPortRawWrite", "Port::RawWrite() calls");
   fStats.Define(kStatNPortRawRead,  "NPortRawRead",  "Port::RawRead() calls");
+  fStats.Define(kStatNPortSpin,     "NPortSpin",  "Port::Read() busy-polls");
+  fStats.Define(kStatNPortSpinHit,  "NPortSpinHit", "busy-polls with data");
+  fStats.Define(kStatNPortSpinLoop, "NPortSpinLoop","busy-poll loop turns");
 }
 
 //------------------------------------------+-----------------------------------
@@ -124,7 +130,18 @@ int RlinkPort::Read(uint8_t* buf, size_t size, const Rtime& timeout,
 
   fStats.Inc(kStatNPortRead);
 
-  bool rdpoll = PollRead(timeout);
+  bool rdpoll = false;
+  if (fSpinTime > 0 && timeout.IsPositive()) {
+    Rtime tbeg(CLOCK_MONOTONIC);
+    rdpoll = SpinRead();
+    if (!rdpoll) {                          // spin failed, poll for the rest
+      Rtime trest = timeout - (Rtime(CLOCK_MONOTONIC) - tbeg);
+      if (!trest.IsPositive()) return kTout;
+      rdpoll = PollRead(trest);
+    }
+  } else {
+    rdpoll = PollRead(timeout);
+  }
   if (!rdpoll) return kTout;
 
   int irc = -1;
@@ -244,6 +261,37 @@ bool RlinkPort::PollRead(const Rtime& timeout)
   return true;
 }
 
+//------------------------------------------+-----------------------------------
+//! Busy-poll for read data, returns true if data (or an error) is pending
+/*!
+  Polls without timeout until data arrives or the budget set with
+  SetSpinTime() is used up. This avoids the scheduler wakeup latency of a
+  blocking poll() at the price of CPU time. Read() calls this first when a
+  budget is set and falls back to PollRead() with the remaining part of its
+  timeout when it returns \c false.
+ */
+
+bool RlinkPort::SpinRead()
+{
+  fStats.Inc(kStatNPortSpin);
+
+  Rtime tend(CLOCK_MONOTONIC);
+  tend += Rtime(1.e-6 * fSpinTime);
+
+  struct pollfd fds[1] = {{fFdRead,         // fd
+                           POLLIN,          // events
+                           0}};             // revents
+  while (true) {
+    fStats.Inc(kStatNPortSpinLoop);
+    int irc = ::poll(fds, 1, 0);
+    if (irc > 0 || (irc < 0 && errno != EINTR)) break;
+    if (Rtime(CLOCK_MONOTONIC) >= tend) return false;
+  }
+
+  fStats.Inc(kStatNPortSpinHit);
+  return true;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 int RlinkPort::RawRead(uint8_t* buf, size_t size, bool exactsize,
@@ -300,6 +348,7 @@ void RlinkPort::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fTraceLevel:     " << fTraceLevel << endl;
   os << bl << "  fTsLastRead:     " << fTsLastRead << endl;
   os << bl << "  fTsLastWrite:    " << fTsLastWrite << endl;
+  os << bl << "  fSpinTime:       " << fSpinTime << endl;
   fStats.Dump(os, ind+2, "fStats: ", detail);
   return;
 }
@@ -1,9 +1,10 @@
 // $Id: RlinkPort.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1218   1.5    add SpinRead(), SetSpinTime() for busy-poll in Read()
 // 2019-06-07  1160   1.4.5  Stats() not longer const
 // 2018-12-16  1084   1.4.4  use =delete for noncopyable instead of boost
 // 2018-12-07  1078   1.4.3  use std::shared_ptr instead of boost
@@ -59,6 +60,7 @@ namespace Retro {
                          RerrMsg& emsg);
       virtual int   Write(const uint8_t* buf, size_t size, RerrMsg& emsg);
       virtual bool  PollRead(const Rtime& timeout);
+      bool          SpinRead();
 
       int           RawRead(uint8_t* buf, size_t size, bool exactsize,
                             const Rtime& timeout, Rtime& tused, RerrMsg& emsg);
@@ -68,6 +70,8 @@ namespace Retro {
 
       const RparseUrl&  Url() const;
       bool          XonEnable() const;
+      void          SetSpinTime(uint32_t usec);
+      uint32_t      SpinTime() const;
 
       int           FdRead() const;
       int           FdWrite() const;
@@ -95,6 +99,9 @@ namespace Retro {
         kStatNPortRxByt,
         kStatNPortRawWrite,
         kStatNPortRawRead,
+        kStatNPortSpin,
+        kStatNPortSpinHit,
+        kStatNPortSpinLoop,
         kDimStat
       };    
 
@@ -111,6 +118,7 @@ namespace Retro {
       uint32_t      fTraceLevel;            //!< trace level
       Rtime         fTsLastRead;            //!< time stamp last write
       Rtime         fTsLastWrite;           //!< time stamp last write
+      uint32_t      fSpinTime;              //!< busy-poll budget in usec
       Rstats        fStats;                 //!< statistics
   };
   
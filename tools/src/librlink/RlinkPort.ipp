@@ -1,9 +1,10 @@
 // $Id: RlinkPort.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1218   1.4    add SetSpinTime(),SpinTime()
 // 2019-06-07  1160   1.3.2  Stats() not longer const
 // 2018-12-07  1078   1.3.1  use std::shared_ptr instead of boost
 // 2015-04-11   666   1.3    add fXon, XonEnable()
@@ -45,6 +46,22 @@ inline bool RlinkPort::XonEnable() const
   return fXon;
 }
 
+//------------------------------------------+-----------------------------------
+//! Set busy-poll budget for Read(), 0 disables busy-poll, see SpinRead()
+
+inline void RlinkPort::SetSpinTime(uint32_t usec)
+{
+  fSpinTime = usec;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns busy-poll budget for Read() in usec
+
+inline uint32_t RlinkPort::SpinTime() const
+{
+  return fSpinTime;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
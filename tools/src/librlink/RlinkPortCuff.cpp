@@ -1,9 +1,10 @@
 // $Id: RlinkPortCuff.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2012-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2012-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1218   1.1.11 Open(): accept spin= option
 // 2018-12-18  1089   1.1.10 use c++ style casts
 // 2018-12-17  1088   1.1.9  use std::thread instead of boost
 // 2018-12-14  1081   1.1.8  use std::bind instead of boost
@@ -94,7 +95,7 @@ bool RlinkPortCuff::Open(const std::string& url, RerrMsg& emsg)
 
   if (IsOpen()) Close();
 
-  if (!fUrl.Set(url, "|trace|noinit|", "cuff", emsg)) return false;
+  if (!fUrl.Set(url, "|trace|noinit|spin=|", "cuff", emsg)) return false;
 
   // initialize USB context
   irc = libusb_init(&fpUsbContext);
@@ -1,9 +1,10 @@
 // $Id: RlinkPortFactory.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1206   2.1    add sim: support
 // 2018-12-01  1076   2.0    use unique_ptr
 // 2013-02-23   492   1.2    use RparseUrl
 // 2012-12-26   465   1.1    add cuff: support
@@ -20,6 +21,7 @@
 #include "RlinkPortFifo.hpp"
 #include "RlinkPortTerm.hpp"
 #include "RlinkPortCuff.hpp"
+#include "RlinkPortSim.hpp"
 
 #include "RlinkPortFactory.hpp"
 
@@ -53,6 +55,8 @@ RlinkPort::port_uptr_t RlinkPortFactory::New(
     return RlinkPort::port_uptr_t(new RlinkPortTerm());
   } else if (scheme == "cuff") {
     return RlinkPort::port_uptr_t(new RlinkPortCuff());
+  } else if (scheme == "sim") {
+    return RlinkPort::port_uptr_t(new RlinkPortSim());
   }
   
   emsg.Init("RlinkPortFactory::New()", string("unknown scheme: ") + scheme);
@@ -1,9 +1,10 @@
 // $Id: RlinkPortFifo.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1218   1.2.2  Open(): accept spin= option
 // 2017-04-15   875   1.2.1  Open(): set default scheme
 // 2015-04-12   666   1.2    add xon,noinit attributes
 // 2013-02-23   492   1.1    use RparseUrl
@@ -56,7 +57,7 @@ bool RlinkPortFifo::Open(const std::string& url, RerrMsg& emsg)
 {
   if (IsOpen()) Close();
 
-  if (!fUrl.Set(url, "|keep|xon|noinit|", "fifo", emsg)) return false;
+  if (!fUrl.Set(url, "|keep|xon|noinit|spin=|", "fifo", emsg)) return false;
 
   // Note: _rx fifo must be opened before the _tx fifo, otherwise the test
   //       bench might close with EOF on read prematurely (is a race condition).
@@ -0,0 +1,815 @@
+// $Id: RlinkPortSim.cpp 1206 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1227   1.0.2  TesterAccess(): ncyc read returns previous count
+// 2026-10-18  1218   1.0.1  Open(): accept spin= option
+// 2026-10-18  1206   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of RlinkPortSim.
+*/
+
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <pthread.h>
+
+#include <cstdlib>
+
+#include "librtools/Rexception.hpp"
+#include "librtools/Rtools.hpp"
+#include "librtools/RosFill.hpp"
+#include "librtools/RosPrintf.hpp"
+#include "librtools/RosPrintBvi.hpp"
+
+#include "RlinkPacketBuf.hpp"
+#include "RlinkCommand.hpp"
+#include "RlinkConnect.hpp"
+
+#include "RlinkPortSim.hpp"
+
+using namespace std;
+
+/*!
+  \class Retro::RlinkPortSim
+  \brief In-process software model of the device end of an rlink.
+
+  The port implements the rlink v4 protocol engine of \c rlink_core and a
+  small rbus device set in a driver thread. It allows to use librlink and
+  the tools based on it without hardware or a GHDL simulation, e.g. for
+  benchmarks or regression tests. Like for RlinkPortCuff the host side
+  communicates via two pipes with the driver thread.
+
+  The model provides
+    - escape decoding/encoding, command and data crc checks, and NAK
+      aborts for crc, framing, command and rbuf overflow errors
+    - the rlink core registers \c RLCNTL, \c RLSTAT, \c RLID1 and \c RLID0
+    - an rbd_tester at kRbaddrTester with cntl, stat, attn, ncyc, data,
+      dinc, fifo and lnak registers
+    - an optional plain memory
+    - attention notifies when \c anena is set in \c RLCNTL, and on
+      \c <ATTN> commas send by the host
+    - retransmit of the last response on \c <NAK> commas
+    .
+
+  The url has the form
+  \verbatim
+    sim:[?opts]
+  \endverbatim
+  with the options
+    - rbuf=n     rbuf size in kB, must be a power of 2 in 1..128 (default 2)
+    - sysid=n    value of RLID1/RLID0 (default 0)
+    - mem=n      size of memory in words, mapped from address 0 (default 0)
+    - lat=n      response latency in usec (default 0)
+    - bw=n       link bandwidth in kB/sec (default: unlimited)
+    - xon, noinit, keep   as for other ports
+    .
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+// constants definitions
+
+const uint16_t RlinkPortSim::kRbaddrTester;
+const uint16_t RlinkPortSim::kRbusTimeout;
+const size_t   RlinkPortSim::kTeFifoSize;
+
+//------------------------------------------+-----------------------------------
+//! Default constructor
+
+RlinkPortSim::RlinkPortSim()
+  : RlinkPort(),
+    fFdReadDriver(-1),
+    fFdWriteDriver(-1),
+    fDriverThread(),
+    fLatency(),
+    fByteTime(0.),
+    fTxBusy(),
+    fTxQueue(),
+    fRxEsc(false),
+    fRxInPkt(false),
+    fRxPkt(),
+    fTxPkt(),
+    fTxLast(),
+    fTxCrc(),
+    fRlCntl(0),
+    fAttnPat(0),
+    fAttnNoti(0),
+    fBabo(false),
+    fLastCmd(0),
+    fSysId(0),
+    fRbufCode(1),
+    fRbufSize(2048),
+    fTeWchk(false),
+    fTeNBusy(0),
+    fTeStat(0),
+    fTeData(0),
+    fTeNCyc(0),
+    fTeFifo(),
+    fMemBase(0),
+    fMem()
+{
+  fStats.Define(kStatNSimPkt,   "NSimPkt",   "Sim: request packets");
+  fStats.Define(kStatNSimCmd,   "NSimCmd",   "Sim: commands executed");
+  fStats.Define(kStatNSimNak,   "NSimNak",   "Sim: NAK aborts send");
+  fStats.Define(kStatNSimAttn,  "NSimAttn",  "Sim: attn notifies send");
+  fStats.Define(kStatNSimRetra, "NSimRetra", "Sim: retransmits send");
+}
+
+//------------------------------------------+-----------------------------------
+//! Destructor
+
+RlinkPortSim::~RlinkPortSim()
+{
+  if (IsOpen()) Rtools::Catch2Cerr(__func__,
+                                   [this](){ RlinkPortSim::Close(); } );
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+bool RlinkPortSim::Open(const std::string& url, RerrMsg& emsg)
+{
+  if (IsOpen()) Close();
+
+  if (!fUrl.Set(url, "|rbuf=|sysid=|mem=|lat=|bw=|keep|xon|noinit|spin=|",
+                "sim", emsg)) return false;
+
+  unsigned long rbuf  = 2;
+  unsigned long sysid = 0;
+  unsigned long mem   = 0;
+  unsigned long lat   = 0;
+  unsigned long bw    = 0;
+  if (!GetOptNum("rbuf",  rbuf,  emsg)) return false;
+  if (!GetOptNum("sysid", sysid, emsg)) return false;
+  if (!GetOptNum("mem",   mem,   emsg)) return false;
+  if (!GetOptNum("lat",   lat,   emsg)) return false;
+  if (!GetOptNum("bw",    bw,    emsg)) return false;
+
+  fRbufCode = 0;
+  while (fRbufCode <= RlinkConnect::kRLSTAT_M_RBSize &&
+         (1ul<<fRbufCode) != rbuf) fRbufCode += 1;
+  if (fRbufCode > RlinkConnect::kRLSTAT_M_RBSize) {
+    emsg.Init("RlinkPortSim::Open()",
+              string("rbuf=") + to_string(rbuf) + " not 1,2,4,..,128");
+    return false;
+  }
+  if (mem > kRbaddrTester) {
+    emsg.Init("RlinkPortSim::Open()",
+              string("mem=") + to_string(mem) + " overlaps tester");
+    return false;
+  }
+
+  fRbufSize = size_t(1) << (10 + fRbufCode);
+  fSysId    = uint32_t(sysid);
+  fLatency  = Rtime(double(lat) * 1.e-6);
+  fByteTime = (bw > 0) ? 1./(1024.*double(bw)) : 0.;
+  fMem.assign(mem, 0);
+
+  fTxBusy.Clear();
+  fTxQueue.clear();
+  fRxEsc   = false;
+  fRxInPkt = false;
+  fRxPkt.clear();
+  fTxLast.clear();
+  fRlCntl  = 0;
+  fAttnPat = 0;
+  fAttnNoti= 0;
+  fBabo    = false;
+  fLastCmd = 0;
+  RbusInit(kRbaddrTester, 0x7);
+
+  if (!OpenPipe(fFdWriteDriver, fFdWrite, emsg)) return false;
+  if (!OpenPipe(fFdRead, fFdReadDriver, emsg)) {
+    CloseFd(fFdWriteDriver);
+    CloseFd(fFdWrite);
+    return false;
+  }
+
+  fXon    = fUrl.FindOpt("xon");
+  fIsOpen = true;
+
+  fDriverThread = thread([this](){ Driver(); });
+
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void RlinkPortSim::Close()
+{
+  if (!IsOpen()) return;
+
+  // close write pipe from user side -> causes eof in driver and driver stop
+  // close also read pipe, unblocks driver in case it is stuck in write
+  CloseFd(fFdWrite);
+  CloseFd(fFdRead);
+  fDriverThread.join();
+
+  CloseFd(fFdReadDriver);
+  CloseFd(fFdWriteDriver);
+
+  RlinkPort::Close();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void RlinkPortSim::Dump(std::ostream& os, int ind, const char* text,
+                        int detail) const
+{
+  RosFill bl(ind);
+  os << bl << (text?text:"--") << "RlinkPortSim @ " << this << endl;
+  os << bl << "  fLatency:        " << fLatency << endl;
+  os << bl << "  fByteTime:       " << fByteTime << endl;
+  os << bl << "  fRbufSize:       " << fRbufSize << endl;
+  os << bl << "  fSysId:          " << RosPrintBvi(fSysId,16) << endl;
+  os << bl << "  fRlCntl:         " << RosPrintBvi(fRlCntl,16) << endl;
+  os << bl << "  fAttnPat:        " << RosPrintBvi(fAttnPat,16) << endl;
+  os << bl << "  fBabo:           " << RosPrintf(fBabo) << endl;
+  os << bl << "  fMem.size:       " << fMem.size() << endl;
+  RlinkPort::Dump(os, ind, " ^", detail);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+bool RlinkPortSim::OpenPipe(int& fdread, int& fdwrite, RerrMsg& emsg)
+{
+  int pipefd[2];
+  if (::pipe(pipefd) < 0) {
+    emsg.InitErrno("RlinkPortSim::OpenPipe()", "pipe() failed: ", errno);
+    return false;
+  }
+  fdread  = pipefd[0];
+  fdwrite = pipefd[1];
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Get a numerical option, accepts decimal, octal (0 prefix) and hex (0x).
+
+bool RlinkPortSim::GetOptNum(const char* name, unsigned long& val,
+                             RerrMsg& emsg)
+{
+  string sval;
+  if (!fUrl.FindOpt(name, sval)) return true;
+  char* endptr;
+  val = ::strtoul(sval.c_str(), &endptr, 0);
+  if (sval.empty() || *endptr != 0) {
+    emsg.Init("RlinkPortSim::Open()",
+              string("invalid value '") + sval + "' for option " + name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Driver thread main loop.
+/*!
+  Executed in separate thread. Reads the data send by the host, processes
+  it, and writes responses back once they are due. Ends when the host
+  closes the write pipe.
+ */
+
+void RlinkPortSim::Driver()
+{
+  uint8_t buf[4096];
+
+  // block SIGPIPE, a write to a closed pipe will return EPIPE
+  sigset_t sigset;
+  ::sigemptyset(&sigset);
+  ::sigaddset(&sigset, SIGPIPE);
+  ::pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+
+  while (true) {
+    pollfd pfd = {fFdWriteDriver, POLLIN, 0};
+    timespec  ts;
+    timespec* pts = nullptr;
+    if (!fTxQueue.empty()) {
+      Rtime tnow(CLOCK_MONOTONIC);
+      Rtime twait = fTxQueue.front().fTime - tnow;
+      if (twait.IsNegative()) twait.Clear();
+      ts  = twait.Timespec();
+      pts = &ts;
+    }
+
+    int irc = ::ppoll(&pfd, 1, pts, nullptr);
+    if (irc < 0 && errno != EINTR) break;
+
+    if (irc > 0) {
+      ssize_t nrd = ::read(fFdWriteDriver, buf, sizeof(buf));
+      if (nrd < 0 && errno == EINTR) continue;
+      if (nrd <= 0) break;                  // eof -> port closed, end driver
+      DriverRcv(buf, size_t(nrd));
+    }
+    DriverSnd();
+  }
+
+  // close read pipe at driver end -> host sees eof on pending reads
+  ::close(fFdReadDriver);
+  fFdReadDriver = -1;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Handle raw data received from host.
+
+void RlinkPortSim::DriverRcv(const uint8_t* buf, size_t size)
+{
+  for (size_t i=0; i<size; i++) {
+    uint8_t c = buf[i];
+
+    if (!fRxEsc) {
+      if (c == RlinkPacketBuf::kSymEsc) {
+        fRxEsc = true;
+      } else if (fRxInPkt) {
+        fRxPkt.push_back(c);
+      }                                     // data outside packet: dropped
+      continue;
+    }
+
+    fRxEsc = false;
+    uint8_t ec = c & 0x7;
+    if ((c & 0xc0) != RlinkPacketBuf::kSymEdPref ||
+        (((~c)>>3)&0x7) != ec) {            // clobbered escape (or oob)
+      fRxInPkt = false;                     // -> drop packet
+      continue;
+    }
+
+    switch (ec) {
+      case RlinkPacketBuf::kEcSop:
+        fRxInPkt = true;
+        fRxPkt.clear();
+        break;
+      case RlinkPacketBuf::kEcEop:
+        if (fRxInPkt) ExecPacket();
+        fRxInPkt = false;
+        break;
+      case RlinkPacketBuf::kEcNak:          // retransmit last response
+        fRxInPkt = false;
+        if (!fTxLast.empty()) {
+          fStats.Inc(kStatNSimRetra);
+          TxQueue(fTxLast);
+        }
+        break;
+      case RlinkPacketBuf::kEcAttn:         // send attn notify
+        fRxInPkt = false;
+        TxAttnNotify();
+        break;
+      case RlinkPacketBuf::kEcXon:
+        if (fRxInPkt) fRxPkt.push_back(RlinkPacketBuf::kSymXon);
+        break;
+      case RlinkPacketBuf::kEcXoff:
+        if (fRxInPkt) fRxPkt.push_back(RlinkPacketBuf::kSymXoff);
+        break;
+      case RlinkPacketBuf::kEcFill:
+        if (fRxInPkt) fRxPkt.push_back(RlinkPacketBuf::kSymFill);
+        break;
+      case RlinkPacketBuf::kEcEsc:
+        if (fRxInPkt) fRxPkt.push_back(RlinkPacketBuf::kSymEsc);
+        break;
+    }
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write all due tx data to host.
+
+void RlinkPortSim::DriverSnd()
+{
+  Rtime tnow(CLOCK_MONOTONIC);
+  while (!fTxQueue.empty() && fTxQueue.front().fTime <= tnow) {
+    const vector<uint8_t>& data = fTxQueue.front().fData;
+    size_t ndone = 0;
+    while (ndone < data.size()) {
+      ssize_t nwr = ::write(fFdReadDriver, data.data()+ndone,
+                            data.size()-ndone);
+      if (nwr < 0) {
+        if (errno == EINTR) continue;
+        fTxQueue.clear();                   // host gone, drop all
+        return;
+      }
+      ndone += size_t(nwr);
+    }
+    fTxQueue.pop_front();
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Execute a request packet and send the response.
+/*!
+  Processes the commands like \c rlink_core. The command crc and the \c wblk
+  data crc are checked, errors abort the packet with a NAK. Commands after
+  an active \c labo are skipped.
+ */
+
+void RlinkPortSim::ExecPacket()
+{
+  const uint8_t* req = fRxPkt.data();
+  size_t nreq = fRxPkt.size();
+  size_t i    = 0;
+  size_t nrbuf = 0;                         // rbuf bytes used
+  bool   labo  = false;
+  int    nak   = -1;
+  RlinkCrc16 rxcrc;
+
+  fStats.Inc(kStatNSimPkt);
+
+  fTxPkt.clear();
+  fTxCrc.Clear();
+  TxEsc(RlinkPacketBuf::kEcSop);
+
+  auto get16 = [req](size_t ind) {
+    return uint16_t(req[ind]) | (uint16_t(req[ind+1]) << 8);
+  };
+
+  while (i < nreq) {
+    uint8_t  creq  = req[i];
+    uint8_t  ccode = creq & 0x7;
+    size_t   nhdr  = 0;                     // bytes between cmd and crc
+    size_t   nrsp  = 0;                     // response bytes
+    switch (ccode) {
+      case RlinkCommand::kCmdRreg: nhdr = 2; nrsp = 1+2+1+2; break;
+      case RlinkCommand::kCmdRblk: nhdr = 4; nrsp = 1+2+2+1+2; break;
+      case RlinkCommand::kCmdWreg: nhdr = 4; nrsp = 1+1+2;     break;
+      case RlinkCommand::kCmdWblk: nhdr = 4; nrsp = 1+2+1+2;   break;
+      case RlinkCommand::kCmdLabo: nhdr = 0; nrsp = 1+1+1+2;   break;
+      case RlinkCommand::kCmdAttn: nhdr = 0; nrsp = 1+2+1+2;   break;
+      case RlinkCommand::kCmdInit: nhdr = 4; nrsp = 1+1+2;     break;
+      default: nak = RlinkPacketBuf::kNcCmd; break;
+    }
+    if (nak >= 0) break;
+    if (i+1+nhdr+2 > nreq) { nak = RlinkPacketBuf::kNcFrame; break; }
+
+    rxcrc.AddData(req+i, 1+nhdr);
+    uint16_t addr = (nhdr >= 2) ? get16(i+1) : 0;
+    uint16_t data = (nhdr >= 4) ? get16(i+3) : 0;
+    uint16_t ccrc = get16(i+1+nhdr);
+    i += 1+nhdr+2;
+    if (ccrc != rxcrc.Crc()) { nak = RlinkPacketBuf::kNcCcrc; break; }
+
+    size_t wbeg = i;
+    if (ccode == RlinkCommand::kCmdWblk) {  // wblk data, kept in rbuf
+      if (i+2*size_t(data)+2 > nreq) { nak = RlinkPacketBuf::kNcFrame; break; }
+      rxcrc.AddData(req+i, 2*size_t(data));
+      uint16_t dcrc = get16(i+2*size_t(data));
+      i += 2*size_t(data)+2;
+      if (dcrc != rxcrc.Crc()) { nak = RlinkPacketBuf::kNcDcrc; break; }
+      if (nrbuf+2*size_t(data) > fRbufSize) {
+        nak = RlinkPacketBuf::kNcRtWblk;
+        break;
+      }
+    }
+    if (ccode == RlinkCommand::kCmdRblk) nrsp += 2*size_t(data);
+
+    if (labo) continue;                     // skip commands after labo
+
+    if (nrbuf+nrsp > fRbufSize) { nak = RlinkPacketBuf::kNcRtOvlf; break; }
+    nrbuf += nrsp;
+
+    fStats.Inc(kStatNSimCmd);
+    fLastCmd = creq;
+    uint8_t rbstat = 0;
+    uint16_t rdata = 0;
+    TxData(creq);
+
+    switch (ccode) {
+      case RlinkCommand::kCmdRreg:
+        rbstat = RbusRead(addr, rdata);
+        TxData(rdata);
+        break;
+
+      case RlinkCommand::kCmdRblk: {
+        uint16_t done = 0;
+        fBabo = false;
+        TxData(data);
+        for (uint16_t k=0; k<data; k++) {
+          rdata = 0;
+          if (rbstat == 0) {
+            rbstat = RbusRead(addr, rdata);
+            if (rbstat == 0) done += 1; else rdata = 0;
+          }
+          TxData(rdata);
+        }
+        TxData(done);
+        if (done < data) fBabo = true;
+        break;
+      }
+
+      case RlinkCommand::kCmdWreg:
+        rbstat = RbusWrite(addr, data);
+        break;
+
+      case RlinkCommand::kCmdWblk: {
+        uint16_t done = 0;
+        fBabo = false;
+        for (uint16_t k=0; k<data; k++) {
+          rbstat = RbusWrite(addr, get16(wbeg+2*k));
+          if (rbstat) break;
+          done += 1;
+        }
+        TxData(done);
+        if (done < data) fBabo = true;
+        break;
+      }
+
+      case RlinkCommand::kCmdLabo:
+        TxData(uint8_t(fBabo ? 1 : 0));
+        if (fBabo) labo = true;
+        break;
+
+      case RlinkCommand::kCmdAttn:
+        TxData(fAttnPat);
+        fAttnPat  = 0;
+        fAttnNoti = 0;
+        break;
+
+      case RlinkCommand::kCmdInit:
+        RbusInit(addr, data);
+        break;
+    }
+
+    TxData(StatByte(rbstat));
+    TxCrc();
+  }
+
+  if (nak >= 0) {                           // abort: NAK <nakbyte> EOP
+    fStats.Inc(kStatNSimNak);
+    TxEsc(RlinkPacketBuf::kEcNak);
+    fTxPkt.push_back(uint8_t(0x80 | ((~nak)&0x7)<<3 | nak));
+  }
+  TxEsc(RlinkPacketBuf::kEcEop);
+
+  fTxLast = fTxPkt;
+  TxQueue(fTxPkt);
+
+  // send attn notify if enabled and new attn bits pending
+  if ((fRlCntl & RlinkConnect::kRLCNTL_M_AnEna) && (fAttnPat & ~fAttnNoti)) {
+    TxAttnNotify();
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns status byte for an rbus status \a rbstat.
+
+uint8_t RlinkPortSim::StatByte(uint8_t rbstat) const
+{
+  uint8_t stat = uint8_t((fTeStat & RlinkCommand::kStat_B_Stat) <<
+                         RlinkCommand::kStat_V_Stat) | rbstat;
+  if (fAttnPat) stat |= RlinkCommand::kStat_M_Attn;
+  return stat;
+}
+
+//------------------------------------------+-----------------------------------
+//! Rbus read. Returns rbus status bits (rbtout, rbnak, rberr).
+
+uint8_t RlinkPortSim::RbusRead(uint16_t addr, uint16_t& data)
+{
+  data = 0;
+  switch (addr) {
+    case RlinkConnect::kRbaddr_RLCNTL:
+      data = fRlCntl;
+      return 0;
+    case RlinkConnect::kRbaddr_RLSTAT:
+      data = uint16_t(fLastCmd) << RlinkConnect::kRLSTAT_V_LCmd | fRbufCode;
+      if (fBabo) data |= RlinkConnect::kRLSTAT_M_BAbo;
+      return 0;
+    case RlinkConnect::kRbaddr_RLID1:
+      data = uint16_t(fSysId >> 16);
+      return 0;
+    case RlinkConnect::kRbaddr_RLID0:
+      data = uint16_t(fSysId);
+      return 0;
+  }
+  if ((addr & 0xfff8) == kRbaddrTester) return TesterAccess(addr, false, data);
+  if (addr >= fMemBase && size_t(addr-fMemBase) < fMem.size()) {
+    data = fMem[addr-fMemBase];
+    return 0;
+  }
+  return RlinkCommand::kStat_M_RbNak;
+}
+
+//------------------------------------------+-----------------------------------
+//! Rbus write. Returns rbus status bits (rbtout, rbnak, rberr).
+
+uint8_t RlinkPortSim::RbusWrite(uint16_t addr, uint16_t data)
+{
+  switch (addr) {
+    case RlinkConnect::kRbaddr_RLCNTL:
+      fRlCntl = data & (RlinkConnect::kRLCNTL_M_AnEna  |
+                        RlinkConnect::kRLCNTL_M_AtoEna |
+                        RlinkConnect::kRLCNTL_M_AtoVal);
+      return 0;
+    case RlinkConnect::kRbaddr_RLSTAT:
+    case RlinkConnect::kRbaddr_RLID1:
+    case RlinkConnect::kRbaddr_RLID0:
+      return RlinkCommand::kStat_M_RbErr;   // read-only
+  }
+  if ((addr & 0xfff8) == kRbaddrTester) return TesterAccess(addr, true, data);
+  if (addr >= fMemBase && size_t(addr-fMemBase) < fMem.size()) {
+    fMem[addr-fMemBase] = data;
+    return 0;
+  }
+  return RlinkCommand::kStat_M_RbNak;
+}
+
+//------------------------------------------+-----------------------------------
+//! Rbus init. Only the rbd_tester responds (fifo,data,cntl bits).
+
+void RlinkPortSim::RbusInit(uint16_t addr, uint16_t data)
+{
+  if (addr != kRbaddrTester) return;
+  if (data & 0x1) {                         // cntl
+    fTeWchk  = false;
+    fTeStat  = 0;
+    fTeNBusy = 0;
+  }
+  if (data & 0x2) fTeData = 0;              // data
+  if (data & 0x4) fTeFifo.clear();          // fifo
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Access rbd_tester registers.
+/*!
+  Follows the semantics of rbd_tester.vhd. The busy cycles are modelled
+  by comparing \c nbusy with the rbus timeout kRbusTimeout. The cycle
+  count of each access is latched in fTeNCyc, except for a \c ncyc read,
+  which returns the count of the previous access.
+ */
+
+uint8_t RlinkPortSim::TesterAccess(uint16_t addr, bool we, uint16_t& data)
+{
+  uint16_t ioff = addr & 0x7;
+  bool busyreg = ioff >= 4;                 // data,dinc,fifo,lnak
+  uint16_t ncyc = busyreg ? fTeNBusy : 0;
+
+  if (ncyc >= kRbusTimeout) {               // busy beyond timeout
+    fTeNCyc = kRbusTimeout + 1;
+    return RlinkCommand::kStat_M_RbTout;
+  }
+  if (ioff != 3) fTeNCyc = ncyc + 1;        // keep count for ncyc read
+
+  switch (ioff) {
+    case 0:                                 // cntl
+      if (we) {
+        fTeWchk  = data & 0x8000;
+        fTeNBusy = data & 0x03ff;
+      } else {
+        data = (fTeWchk ? 0x8000 : 0) | fTeNBusy;
+      }
+      return 0;
+
+    case 1:                                 // stat
+      if (we) fTeStat = data & 0x000f;
+      else    data = fTeStat;
+      return 0;
+
+    case 2:                                 // attn
+      if (!we) return RlinkCommand::kStat_M_RbErr;
+      fAttnPat |= data;
+      return 0;
+
+    case 3:                                 // ncyc
+      if (we) return RlinkCommand::kStat_M_RbErr;
+      data = fTeNCyc;
+      return 0;
+
+    case 4:                                 // data
+      if (we) {
+        fTeWchk = false;
+        fTeData = data;
+      } else {
+        data = fTeData;
+      }
+      return 0;
+
+    case 5:                                 // dinc
+      if (we) {
+        if (data != fTeData) fTeWchk = true;
+      } else {
+        data = fTeData;
+      }
+      fTeData += 1;
+      return 0;
+
+    case 6:                                 // fifo
+      if (we) {
+        if (fTeFifo.size() >= kTeFifoSize) return RlinkCommand::kStat_M_RbErr;
+        fTeFifo.push_back(data);
+      } else {
+        if (fTeFifo.empty()) return RlinkCommand::kStat_M_RbErr;
+        data = fTeFifo.front();
+        fTeFifo.pop_front();
+      }
+      return 0;
+
+    default:                                // lnak
+      return RlinkCommand::kStat_M_RbNak;
+  }
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a response byte, update crc and escape if needed.
+
+void RlinkPortSim::TxData(uint8_t data)
+{
+  fTxCrc.AddData(data);
+  switch (data) {
+    case RlinkPacketBuf::kSymEsc:  TxEsc(RlinkPacketBuf::kEcEsc);  return;
+    case RlinkPacketBuf::kSymFill: TxEsc(RlinkPacketBuf::kEcFill); return;
+    case RlinkPacketBuf::kSymXon:
+      if (fXon) { TxEsc(RlinkPacketBuf::kEcXon);  return; }
+      break;
+    case RlinkPacketBuf::kSymXoff:
+      if (fXon) { TxEsc(RlinkPacketBuf::kEcXoff); return; }
+      break;
+  }
+  fTxPkt.push_back(data);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a 16 bit response word (little endian).
+
+void RlinkPortSim::TxData(uint16_t data)
+{
+  TxData(uint8_t(data & 0xff));
+  TxData(uint8_t(data >> 8));
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add current crc to response (crc bytes are not part of the crc).
+
+void RlinkPortSim::TxCrc()
+{
+  uint16_t crc = fTxCrc.Crc();
+  RlinkCrc16 crcsave = fTxCrc;
+  TxData(crc);
+  fTxCrc = crcsave;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add an escape sequence for escape code \a ec.
+
+void RlinkPortSim::TxEsc(uint8_t ec)
+{
+  fTxPkt.push_back(RlinkPacketBuf::kSymEsc);
+  fTxPkt.push_back(uint8_t(RlinkPacketBuf::kSymEdPref | ((~ec)&0x7)<<3 | ec));
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Queue data for delivery, applies latency and bandwidth shaping.
+
+void RlinkPortSim::TxQueue(const std::vector<uint8_t>& data)
+{
+  Rtime tnow(CLOCK_MONOTONIC);
+  Rtime tbeg = tnow + fLatency;             // earliest start of delivery
+  if (tbeg < fTxBusy) tbeg = fTxBusy;       // link still busy
+  Rtime tend = tbeg + Rtime(fByteTime * double(data.size()));
+  fTxBusy = tend;
+
+  if (!(tnow < tend) && fTxQueue.empty()) { // no shaping -> send right away
+    fTxQueue.push_back(TxItem{tend, data});
+    DriverSnd();
+  } else {
+    fTxQueue.push_back(TxItem{tend, data});
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Send an attention notify packet with the current attn pattern.
+
+void RlinkPortSim::TxAttnNotify()
+{
+  fStats.Inc(kStatNSimAttn);
+  fTxPkt.clear();
+  fTxCrc.Clear();
+  TxEsc(RlinkPacketBuf::kEcAttn);
+  TxData(fAttnPat);
+  TxCrc();
+  TxEsc(RlinkPacketBuf::kEcEop);
+  fAttnNoti = fAttnPat;
+  TxQueue(fTxPkt);
+  return;
+}
+
+} // end namespace Retro
@@ -0,0 +1,116 @@
+// $Id: RlinkPortSim.hpp 1206 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1206   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class RlinkPortSim.
+*/
+
+#ifndef included_Retro_RlinkPortSim
+#define included_Retro_RlinkPortSim 1
+
+#include "RlinkPort.hpp"
+#include "RlinkCrc16.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <thread>
+
+namespace Retro {
+
+  class RlinkPortSim : public RlinkPort {
+    public:
+
+                    RlinkPortSim();
+      virtual       ~RlinkPortSim();
+
+      virtual bool  Open(const std::string& url, RerrMsg& emsg);
+      virtual void  Close();
+
+      virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
+                         int detail=0) const;
+
+    // some constants (also defined in cpp)
+      static const uint16_t kRbaddrTester = 0xffe0; //!< rbd_tester base addr
+      static const uint16_t kRbusTimeout  = 63;     //!< rbus timeout (cycles)
+      static const size_t   kTeFifoSize   = 15;     //!< rbd_tester fifo size
+
+    // statistics counter indices
+      enum stats {
+        kStatNSimPkt = RlinkPort::kDimStat,
+        kStatNSimCmd,
+        kStatNSimNak,
+        kStatNSimAttn,
+        kStatNSimRetra,
+        kDimStat
+      };
+
+    protected:
+      struct TxItem {
+        Rtime       fTime;                  //!< time when data is delivered
+        std::vector<uint8_t> fData;         //!< raw data
+      };
+
+      int           fFdReadDriver;          //!< fd for read (driver end)
+      int           fFdWriteDriver;         //!< fd for write (driver end)
+      std::thread   fDriverThread;          //!< driver thread
+      Rtime         fLatency;               //!< response latency
+      double        fByteTime;              //!< time per byte (0 if no limit)
+      Rtime         fTxBusy;                //!< time when link tx is idle
+      std::deque<TxItem> fTxQueue;          //!< delayed tx data
+      bool          fRxEsc;                 //!< rx: escape seen
+      bool          fRxInPkt;               //!< rx: inside packet
+      std::vector<uint8_t> fRxPkt;          //!< rx: packet data (unescaped)
+      std::vector<uint8_t> fTxPkt;          //!< tx: packet data (escaped)
+      std::vector<uint8_t> fTxLast;         //!< tx: last response packet
+      RlinkCrc16    fTxCrc;                 //!< tx: crc accumulator
+      uint16_t      fRlCntl;                //!< core: RLCNTL
+      uint16_t      fAttnPat;               //!< core: attn pattern
+      uint16_t      fAttnNoti;              //!< core: attn bits notified
+      bool          fBabo;                  //!< core: babo flag
+      uint8_t       fLastCmd;               //!< core: last command
+      uint32_t      fSysId;                 //!< core: RLID1/RLID0
+      uint16_t      fRbufCode;              //!< core: rbuf size code
+      size_t        fRbufSize;              //!< core: rbuf size in bytes
+      bool          fTeWchk;                //!< tester: write check flag
+      uint16_t      fTeNBusy;               //!< tester: busy cycles
+      uint16_t      fTeStat;                //!< tester: stat
+      uint16_t      fTeData;                //!< tester: data
+      uint16_t      fTeNCyc;                //!< tester: cycles of last access
+      std::deque<uint16_t> fTeFifo;         //!< tester: fifo
+      uint16_t      fMemBase;               //!< memory: base address
+      std::vector<uint16_t> fMem;           //!< memory: data
+
+    private:
+      bool          OpenPipe(int& fdread, int& fdwrite, RerrMsg& emsg);
+      bool          GetOptNum(const char* name, unsigned long& val,
+                              RerrMsg& emsg);
+      void          Driver();
+      void          DriverRcv(const uint8_t* buf, size_t size);
+      void          DriverSnd();
+      void          ExecPacket();
+      uint8_t       StatByte(uint8_t rbstat) const;
+      uint8_t       RbusRead(uint16_t addr, uint16_t& data);
+      uint8_t       RbusWrite(uint16_t addr, uint16_t data);
+      void          RbusInit(uint16_t addr, uint16_t data);
+      uint8_t       TesterAccess(uint16_t addr, bool we, uint16_t& data);
+      void          TxData(uint8_t data);
+      void          TxData(uint16_t data);
+      void          TxCrc();
+      void          TxEsc(uint8_t ec);
+      void          TxQueue(const std::vector<uint8_t>& data);
+      void          TxAttnNotify();
+  };
+
+} // end namespace Retro
+
+//#include "RlinkPortSim.ipp"
+
+#endif
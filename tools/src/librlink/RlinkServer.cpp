@@ -1,9 +1,20 @@
 // $Id: RlinkServer.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   2.10.3 StartOrResume(): call AsyncTimerArm()
+// 2026-10-18  1227   2.10.2 count drop/defer with atomics; add SetActnLimit()
+// 2026-10-18  1227   2.10.1 QueueAction(): count overflow with atomic fActnNOvfl
+// 2026-10-18  1221   2.10   add action sources with limit and resume (ActnSource())
+// 2026-10-18  1220   2.9    add handler call profiles (Profile(),ProfileList())
+// 2026-10-18  1219   2.8    pin server thread (SetCpu()), add SyncLogFile()
+// 2026-10-18  1217   2.7    add priority classes and weighted action scheduler
+// 2026-10-18  1216   2.6    QueueAction(): lock-free, wakeup only if sleeping
+// 2026-10-18  1215   2.5    add timer wheel, TimerHandler()
+// 2026-10-18  1214   2.4    add I/O worker pool, IoDoneHandler()
+// 2026-10-18  1213   2.3    add coalesced attn handling (ExecAttnClists)
 // 2019-06-15  1164   2.2.11 adapt to new ReventFd API
 // 2019-04-07  1127   2.2.10 trace now with timestamp and selective
 // 2019-02-23  1114   2.2.9  use std::bind instead of lambda
@@ -30,8 +41,13 @@
 */
 
 #include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
 
 #include <functional>
+#include <algorithm>
+#include <sstream>
 
 #include "librtools/Rexception.hpp"
 #include "librtools/RosFill.hpp"
@@ -61,30 +77,90 @@ RlinkServer::RlinkServer()
   : fspConn(),
     fContext(),
     fAttnDsc(),
+    fActnQueue(1024),
+    fActnOvflMutex(),
+    fActnOvfl(),
+    fActnOvflPend(false),
+    fActnNOvfl(0),
+    fActnNDrop(0),
+    fActnNDefer(0),
+    fActnSleep(false),
     fActnList(),
+    fActnNList(0),
+    fActnWeight{16,8,4,1},
+    fActnCredit{0,0,0,0},
     fWakeupEvent("RlinkServer::fWakeupEvent."),
+    fIoPool(),
+    fTimerWheel(),
+    fTimerFd("RlinkServer::fTimerFd."),
+    fTimerNext(),
     fELoop(this),
     fServerThread(),
+    fCpu(-1),
     fAttnPatt(0),
     fAttnNotiPatt(0),
     fTraceLevel(0),
+    fAttnCoal(true),
+    fAttnClist(),
+    fAttnCoalList(),
+    fProfMutex(),
+    fProf(),
+    fActnSrc(),
+    fpActnSrcDef{},
+    fpProfAttnCoal(nullptr),
     fStats()
 {
   fContext.SetStatus(0, RlinkCommand::kStat_M_RbTout |
                         RlinkCommand::kStat_M_RbNak  |
                         RlinkCommand::kStat_M_RbErr);
 
+  fpActnSrcDef[kPrioTerm] = ActnSource("actn.term");
+  fpActnSrcDef[kPrioNet]  = ActnSource("actn.net");
+  fpActnSrcDef[kPrioBulk] = ActnSource("actn.bulk");
+  fpActnSrcDef[kPrioBack] = ActnSource("actn.back");
+  fpProfAttnCoal        = Profile("srv.attncoal");
+
   fELoop.AddPollHandler(bind(&RlinkServer::WakeupHandler, this, _1), 
-                        fWakeupEvent.Fd(), POLLIN);
+                        fWakeupEvent.Fd(), POLLIN, Profile("srv.wakeup"));
+  fELoop.AddPollHandler(bind(&RlinkServer::IoDoneHandler, this, _1), 
+                        fIoPool.Fd(), POLLIN, Profile("srv.iodone"));
+  fTimerFd.Open();
+  fELoop.AddPollHandler(bind(&RlinkServer::TimerHandler, this, _1), 
+                        fTimerFd.Fd(), POLLIN, Profile("srv.timer"));
 
   // Statistic setup
   fStats.Define(kStatNEloopWait,"NEloopWait","event loop turns (wait)");
   fStats.Define(kStatNEloopPoll,"NEloopPoll","event loop turns (poll)");
   fStats.Define(kStatNWakeupEvt,"NWakeupEvt","Wakeup events");
   fStats.Define(kStatNRlinkEvt, "NRlinkEvt", "Rlink data events");
+  fStats.Define(kStatNIoDoneEvt,"NIoDoneEvt","I/O completion events");
+  fStats.Define(kStatNTimerEvt, "NTimerEvt", "Timer events");
+  fStats.Define(kStatNActnQueue,"NActnQueue","actions taken from queue");
+  fStats.Define(kStatNActnOvfl, "NActnOvfl", "actions queued to overflow");
+  fStats.Define(kStatNActnDrop, "NActnDrop", "actions refused (dropped)");
+  fStats.Define(kStatNActnDefer,"NActnDefer","actions refused (deferred)");
+  fStats.Define(kStatNActnResume,"NActnResume","throttled sources resumed");
+  fStats.Define(kStatNActnTerm, "NActnTerm", "actions called (term)");
+  fStats.Define(kStatNActnNet,  "NActnNet",  "actions called (net)");
+  fStats.Define(kStatNActnBulk, "NActnBulk", "actions called (bulk)");
+  fStats.Define(kStatNActnBack, "NActnBack", "actions called (back)");
+  fStats.Define(kStatTActnTerm, "TActnTerm", "action delay sum in us (term)");
+  fStats.Define(kStatTActnNet,  "TActnNet",  "action delay sum in us (net)");
+  fStats.Define(kStatTActnBulk, "TActnBulk", "action delay sum in us (bulk)");
+  fStats.Define(kStatTActnBack, "TActnBack", "action delay sum in us (back)");
+  fStats.Define(kStatTActnMaxTerm,"TActnMaxTerm",
+                "action delay max in us (term)");
+  fStats.Define(kStatTActnMaxNet,"TActnMaxNet",
+                "action delay max in us (net)");
+  fStats.Define(kStatTActnMaxBulk,"TActnMaxBulk",
+                "action delay max in us (bulk)");
+  fStats.Define(kStatTActnMaxBack,"TActnMaxBack",
+                "action delay max in us (back)");
   fStats.Define(kStatNAttnHdl  ,"NAttnHdl"  ,"Attn handler calls");
   fStats.Define(kStatNAttnNoti ,"NAttnNoti" ,"Attn notifies processed");
   fStats.Define(kStatNAttnHarv ,"NAttnHarv" ,"Attn handler restarts");
+  fStats.Define(kStatNAttnCoal ,"NAttnCoal" ,"Attn coalesced executes");
+  fStats.Define(kStatNAttnCoalHdl,"NAttnCoalHdl","Attn coalesced handlers");
   fStats.Define(kStatNAttn00,   "NAttn00",   "Attn bit  0 set");
   fStats.Define(kStatNAttn01,   "NAttn01",   "Attn bit  1 set");
   fStats.Define(kStatNAttn02,   "NAttn02",   "Attn bit  2 set");
@@ -131,13 +207,29 @@ void RlinkServer::SetConnect(const std::shared_ptr<RlinkConnect>& spconn)
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Add an attention handler
+/*!
+  \param attnhdl  handler function
+  \param mask     attention mask
+  \param cdata    client data, used together with \a mask as handler id
+  \param pclist   primary command list of the handler, must start with an
+                  attn command. When given, the list is executed together
+                  with the lists of other handlers in one round trip when
+                  several attentions are pending, see CallAttnHandler().
+  \param pri      priority class. Handlers are called in order of their
+                  class, and in order of registration within a class.
+  \param name     name of call profile, usually the controller name. When
+                  empty \c attn.mmmm is used, with \c mmmm the hex mask.
+ */
 
 void RlinkServer::AddAttnHandler(attnhdl_t&& attnhdl, uint16_t mask,
-                                 void* cdata)
+                                 void* cdata, RlinkCommandList* pclist,
+                                 prio pri, const std::string& name)
 {
   if (mask == 0)
     throw Rexception("RlinkServer::AddAttnHandler()", "Bad args: mask == 0");
+  if (pri >= kDimPrio)
+    throw Rexception("RlinkServer::AddAttnHandler()", "Bad args: bad pri");
 
   lock_guard<RlinkConnect> lock(*fspConn);
 
@@ -148,13 +240,27 @@ void RlinkServer::AddAttnHandler(attnhdl_t&& attnhdl, uint16_t mask,
                        "Bad args: duplicate handler");
     }
   }
-  fAttnDsc.emplace_back(move(attnhdl), id);
+  auto it = find_if(fAttnDsc.begin(), fAttnDsc.end(),
+                    [pri](const AttnDsc& o){ return o.fPrio > pri; });
+  RcallProf* pprof;
+  if (name.empty()) {
+    ostringstream sos;
+    sos << "attn." << RosPrintf(mask,"x0",4);
+    pprof = Profile(sos.str());
+  } else {
+    pprof = Profile(name);
+  }
+  fAttnDsc.emplace(it, move(attnhdl), id, pclist, pri, pprof);
 
   return;
 }
 
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
+/*!
+  When \a clist was already executed as part of a coalesced attn round trip
+  (see CallAttnHandler()) only the harvest information is returned.
+ */
 
 void RlinkServer::GetAttnInfo(AttnArgs& args, RlinkCommandList& clist)
 {
@@ -162,7 +268,7 @@ void RlinkServer::GetAttnInfo(AttnArgs& args, RlinkCommandList& clist)
   if (cmd0.Command() != RlinkCommand::kCmdAttn)
     throw Rexception("RlinkServer::GetAttnInfo", "clist did't start with attn");
 
-  Exec(clist);
+  if (&clist != args.fpClistDone) Exec(clist);
 
   args.fAttnHarvest = cmd0.Data();
   args.fHarvestDone = true;
@@ -201,23 +307,188 @@ void RlinkServer::RemoveAttnHandler(uint16_t mask, void* cdata)
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Queue an action, which is called by the server thread.
+/*!
+  The action is called with the connect lock held. When it returns a value
+  \> 0 it is re-queued and called again, otherwise dropped.
+
+  Can be called from any thread and does not take the connect lock. The
+  actions are put into a lock-free ring, only when it is full they go to
+  an overflow queue protected by a separate mutex. Actions taken from the
+  overflow queue can therefore overtake ring entries. The server thread is
+  only woken up when it is waiting in the event loop.
+
+  The server thread selects the next action from the priority classes with
+  a weighted round robin, see SetActnWeight().
+
+  The action is accounted to source \a psrc, see ActnSource(). Without
+  \a psrc the default source of the priority class (\c actn.bulk etc.) is
+  used, which has no limit.
+
+  \returns \c false if the source has already its limit of pending actions.
+            The action is not queued in this case. If the source has a
+            resume handler it is called once the number of pending actions
+            dropped, otherwise the producer must handle the refusal itself.
+ */
 
-void RlinkServer::QueueAction(actnhdl_t&& actnhdl)
+bool RlinkServer::QueueAction(actnhdl_t&& actnhdl, prio pri, ActnSrc* psrc)
 {
-  lock_guard<RlinkConnect> lock(*fspConn);
-  fActnList.push_back(move(actnhdl));
-  if (IsActiveOutside()) Wakeup();
+  if (pri >= kDimPrio)
+    throw Rexception("RlinkServer::QueueAction()", "Bad args: bad pri");
+  if (!psrc) psrc = fpActnSrcDef[pri];
+
+  size_t npend = psrc->fNPend.fetch_add(1);
+  size_t limit = psrc->fLimit.load();
+  if (limit != 0 && npend >= limit) {       // source throttled
+    psrc->fNPend.fetch_sub(1);
+    // counted with atomics, fStats is updated in ActnFetch()
+    if (!psrc->fResume) {
+      psrc->fNDrop.fetch_add(1);
+      fActnNDrop.fetch_add(1);
+    } else {
+      psrc->fNDefer.fetch_add(1);
+      fActnNDefer.fetch_add(1);
+      psrc->fThrottled.store(true);
+      // the last pending action may have completed before fThrottled was
+      // set; in that case let the server thread do the resume
+      if (psrc->fNPend.load() < limit) {
+        QueueAction([this, psrc](){ ActnResume(psrc); return 0; }, pri);
+      }
+    }
+    return false;
+  }
+
+  ActnDsc dsc(move(actnhdl), pri, psrc);
+  if (!fActnQueue.Push(move(dsc))) {
+    lock_guard<mutex> lock(fActnOvflMutex);
+    fActnOvfl.push_back(move(dsc));
+    fActnOvflPend.store(true);
+    fActnNOvfl.fetch_add(1);                // fStats updated in ActnFetch()
+  }
+  
+  // wakeup only if server thread sleeps, the fence pairs with ActnSleep()
+  atomic_thread_fence(memory_order_seq_cst);
+  if (fActnSleep.load() && fActnSleep.exchange(false)) Wakeup();
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns action source \a name, creates it if not yet existing
+/*!
+  \param name    source name, also used for the call profile
+  \param limit   maximal number of pending actions, 0 for no limit. An
+                 action is pending from QueueAction() until it is dropped
+                 after returning \<= 0.
+  \param resume  optional handler, called in the server thread with the
+                 connect lock held when an action of a throttled source
+                 completed. A producer can use it to queue deferred work.
+
+  For an existing source the limit and, when given, the resume handler
+  are updated. Sources are never deleted, the returned pointer stays valid
+  for the lifetime of the server.
+
+  The default sources of the priority classes (\c actn.term etc.) have no
+  limit, they are used by producers which can't handle a refusal, like
+  the ExecAsync() completion. Their limit can be set with SetActnLimit().
+ */
+
+RlinkServer::ActnSrc* RlinkServer::ActnSource(const std::string& name,
+                                              size_t limit,
+                                              resumehdl_t&& resume)
+{
+  RcallProf* pprof = Profile(name);
+  lock_guard<mutex> lock(fProfMutex);
+  ActnSrc* psrc = nullptr;
+  for (auto& o: fActnSrc) {
+    if (o.fName == name) psrc = &o;
+  }
+  if (!psrc) {
+    fActnSrc.emplace_back(name, pprof);
+    psrc = &fActnSrc.back();
+  }
+  psrc->fLimit.store(limit);
+  if (resume) psrc->fResume = move(resume);
+  return psrc;
+}
+
+//------------------------------------------+-----------------------------------
+//! Set limit of existing action source \a name, returns false if unknown
+
+bool RlinkServer::SetActnLimit(const std::string& name, size_t limit)
+{
+  lock_guard<mutex> lock(fProfMutex);
+  for (auto& o: fActnSrc) {
+    if (o.fName == name) {
+      o.fLimit.store(limit);
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------+-----------------------------------
+//! Get all action sources, in the order of creation
+
+void RlinkServer::ActnSourceList(std::vector<const ActnSrc*>& list)
+{
+  list.clear();
+  lock_guard<mutex> lock(fProfMutex);
+  for (auto& o: fActnSrc) list.push_back(&o);
   return;
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Add a timer, returns the timer id.
+/*!
+  \param deadline  absolute \c CLOCK_MONOTONIC time
+  \param timerhdl  handler, called once in the server thread
+
+  All timers are kept in one timer wheel driven by a single timerfd.
+  Deadlines are rounded up to the 1 ms wheel tick, so timers with close
+  deadlines are handled in one wakeup. The handler is called with the
+  connect lock held and may add or cancel timers.
+ */
+
+RlinkServer::timerid_t RlinkServer::AddTimer(const Rtime& deadline,
+                                             timerhdl_t&& timerhdl)
+{
+  lock_guard<RlinkConnect> lock(*fspConn);
+  timerid_t id = fTimerWheel.Add(deadline, move(timerhdl));
+  TimerRearm();
+  return id;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a timer which expires \a dt seconds from now, returns the timer id
+
+RlinkServer::timerid_t RlinkServer::AddTimerRelative(const Rtime& dt,
+                                                     timerhdl_t&& timerhdl)
+{
+  return AddTimer(Rtime(CLOCK_MONOTONIC) + dt, move(timerhdl));
+}
+
+//------------------------------------------+-----------------------------------
+//! Cancel timer \a id, returns false if already expired or canceled
+
+bool RlinkServer::CancelTimer(timerid_t id)
+{
+  lock_guard<RlinkConnect> lock(*fspConn);
+  return fTimerWheel.Cancel(id);
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a poll handler
+/*!
+  The call time is accounted in the call profile \a name. When empty
+  \c poll.fdn is used, with \c n the file descriptor.
+ */
  
-void RlinkServer::AddPollHandler(pollhdl_t&& pollhdl, int fd, short events)
+void RlinkServer::AddPollHandler(pollhdl_t&& pollhdl, int fd, short events,
+                                 const std::string& name)
 {
   lock_guard<RlinkConnect> lock(*fspConn);
-  fELoop.AddPollHandler(move(pollhdl), fd, events);
+  RcallProf* pprof = Profile(name.empty() ? "poll.fd" + to_string(fd) : name);
+  fELoop.AddPollHandler(move(pollhdl), fd, events, pprof);
   if (IsActiveOutside()) Wakeup();
   return;
 }
@@ -343,6 +614,101 @@ bool RlinkServer::IsActiveOutside() const
   return IsActive() && this_thread::get_id() != fServerThread.get_id();
 }
 
+//------------------------------------------+-----------------------------------
+//! Set scheduler weight of priority class \a pri
+/*!
+  When actions of several classes are pending, class \c n gets a share of
+  weight[n]/sum(weight) of the action calls. Defaults are 16 for
+  kPrioTerm, 8 for kPrioNet, 4 for kPrioBulk and 1 for kPrioBack.
+ */
+
+void RlinkServer::SetActnWeight(prio pri, uint32_t weight)
+{
+  if (pri >= kDimPrio)
+    throw Rexception("RlinkServer::SetActnWeight()", "Bad args: bad pri");
+  if (weight == 0)
+    throw Rexception("RlinkServer::SetActnWeight()", "Bad args: weight==0");
+  fActnWeight[pri] = weight;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Pin server thread to \a cpu, -1 removes the pinning
+/*!
+  When several boards are served by one process each RlinkServer runs its
+  own server thread, pinning them to separate cpus keeps the event loops
+  from competing. Takes effect immediately when the server is active,
+  otherwise at the next Start() or Resume().
+ */
+
+void RlinkServer::SetCpu(int cpu)
+{
+  if (cpu < -1 || cpu >= CPU_SETSIZE)
+    throw Rexception("RlinkServer::SetCpu()", "Bad args: cpu out of range");
+  fCpu = cpu;
+  if (IsActive()) ApplyCpu();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Propagate log file of RlinkConnect to the event loop
+/*!
+  Called by RlinkConnect when it switched to another RlogFile object.
+ */
+
+void RlinkServer::SyncLogFile()
+{
+  if (fspConn) fELoop.SetLogFile(fspConn->LogFileSPtr());
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns call profile \a name, creates it if not yet existing
+/*!
+  All poll, attn and action handlers called by the server thread have a
+  call profile (see RcallProf) which accounts their call times. Handlers
+  registered with the same name share one profile. Profiles are never
+  deleted, the returned pointer stays valid for the lifetime of the server.
+  Callers which queue actions often should get the profile once and keep
+  the pointer.
+ */
+
+RcallProf* RlinkServer::Profile(const std::string& name)
+{
+  lock_guard<mutex> lock(fProfMutex);
+  for (auto& o: fProf) {
+    if (o.Name() == name) return &o;
+  }
+  fProf.emplace_back(name);
+  return &fProf.back();
+}
+
+//------------------------------------------+-----------------------------------
+//! Get all call profiles with calls, sorted by decreasing total time
+
+void RlinkServer::ProfileList(std::vector<const RcallProf*>& list)
+{
+  list.clear();
+  lock_guard<mutex> lock(fProfMutex);
+  for (auto& o: fProf) {
+    if (o.NCall() > 0) list.push_back(&o);
+  }
+  stable_sort(list.begin(), list.end(),
+              [](const RcallProf* a, const RcallProf* b)
+                { return a->TSum() > b->TSum(); });
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Clear all call profiles
+
+void RlinkServer::ProfileReset()
+{
+  lock_guard<mutex> lock(fProfMutex);
+  for (auto& o: fProf) o.Reset();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -378,12 +744,37 @@ void RlinkServer::Dump(std::ostream& os, int ind, const char* text,
     os << bl << "    [" << RosPrintf(i,"d",3) << "]: "
        << RosPrintBvi(fAttnDsc[i].fId.fMask,16)
        << ", " << fAttnDsc[i].fId.fCdata << endl;
-  os << bl << "  fActnList.size:  " << fActnList.size() << endl;
+  os << bl << "  fActnQueue.size: " << fActnQueue.Size() << endl;
+  os << bl << "  fActnOvflPend:   " << RosPrintf(fActnOvflPend.load()) << endl;
+  os << bl << "  fActnNOvfl:      " << fActnNOvfl.load() << endl;
+  os << bl << "  fActnSleep:      " << RosPrintf(fActnSleep.load()) << endl;
+  for (size_t i=0; i<kDimPrio; i++) {
+    os << bl << "  fActnList[" << i << "]:    size=" 
+       << RosPrintf(fActnList[i].size(),"d",4) 
+       << " weight=" << RosPrintf(fActnWeight[i],"d",3)
+       << " credit=" << fActnCredit[i] << endl;
+  }
+  os << bl << "  fActnNList:      " << fActnNList << endl;
   os << bl << "  fWakeupEvent:    " << fWakeupEvent.Fd() << endl;
+  fIoPool.Dump(os, ind+2, "fIoPool: ", detail-1);
+  fTimerWheel.Dump(os, ind+2, "fTimerWheel: ", detail-1);
+  os << bl << "  fTimerFd:        " << fTimerFd.Fd() << endl;
+  os << bl << "  fTimerNext:      " << fTimerNext << endl;
   fELoop.Dump(os, ind+2, "fELoop", detail);
   os << bl << "  fServerThread:   " << fServerThread.get_id() << endl;
+  os << bl << "  fCpu:            " << fCpu << endl;
   os << bl << "  fAttnPatt:       " << RosPrintBvi(fAttnPatt,16) << endl;
   os << bl << "  fAttnNotiPatt:   " << RosPrintBvi(fAttnNotiPatt,16) << endl;
+  os << bl << "  fAttnCoal:       " << RosPrintf(fAttnCoal) << endl;
+  os << bl << "  fProf.size:      " << fProf.size() << endl;
+  os << bl << "  fActnSrc:        " << endl;
+  for (auto& o: fActnSrc) {
+    os << bl << "    " << RosPrintf(o.fName.c_str(),"-s",16)
+       << " limit=" << RosPrintf(o.fLimit.load(),"d",4)
+       << " npend=" << RosPrintf(o.fNPend.load(),"d",4)
+       << " ndrop=" << o.fNDrop.load()
+       << " ndefer=" << o.fNDefer.load() << endl;
+  }
   fStats.Dump(os, ind+2, "fStats: ", detail-1);
   return;
 }
@@ -411,11 +802,22 @@ void RlinkServer::StartOrResume(bool resume)
   int rlinkfd = fspConn->Port().FdRead();
   if (!fELoop.TestPollHandler(rlinkfd, POLLIN))
     fELoop.AddPollHandler(bind(&RlinkServer::RlinkHandler, this, _1), 
-                          rlinkfd, POLLIN);
+                          rlinkfd, POLLIN, Profile("srv.rlink"));
   
   // and start server thread
   fELoop.UnStop();
   fServerThread = thread([this](){ fELoop.EventLoop(); });
+  if (fCpu >= 0) {                          // pin, but run unpinned if fails
+    try {
+      ApplyCpu();
+    } catch (Rexception& e) {
+      RlogMsg lmsg(LogFile(), 'E');
+      lmsg << e.ErrMsg();
+    }
+  }
+
+  // arm deadline timer for ExecAsync() lists sent while server was inactive
+  fspConn->AsyncTimerArm();
 
   if (resume) {
     RerrMsg emsg;
@@ -429,7 +831,36 @@ void RlinkServer::StartOrResume(bool resume)
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Set cpu affinity of server thread according to fCpu
+/*!
+  Without pinning the server thread gets the affinity mask of the process.
+ */
+
+void RlinkServer::ApplyCpu()
+{
+  cpu_set_t cset;
+  CPU_ZERO(&cset);
+  if (fCpu >= 0) {
+    CPU_SET(fCpu, &cset);
+  } else if (::sched_getaffinity(0, sizeof(cset), &cset) < 0) {
+    throw Rexception("RlinkServer::ApplyCpu()",
+                     "sched_getaffinity() failed: ", errno);
+  }
+  int irc = ::pthread_setaffinity_np(fServerThread.native_handle(),
+                                     sizeof(cset), &cset);
+  if (irc != 0)
+    throw Rexception("RlinkServer::ApplyCpu()",
+                     "pthread_setaffinity_np() failed: ", irc);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call the attention handlers for all pending attentions.
+/*!
+  In coalesced mode (see SetAttnCoalesce()) the primary command lists of all
+  handlers with a pending attention are first executed in one round trip
+  by ExecAttnClists(), the handlers then only process the results.
+ */
 
 void RlinkServer::CallAttnHandler()
 {
@@ -457,6 +888,14 @@ void RlinkServer::CallAttnHandler()
     if (fAttnPatt & (uint16_t(1)<<i)) fStats.Inc(kStatNAttn00+i);
   }
 
+  // in coalesced mode get all primary clists in one go
+  fAttnCoalList.clear();
+  if (fAttnCoal) {
+    Rtime tbeg(CLOCK_MONOTONIC);
+    ExecAttnClists();
+    fpProfAttnCoal->Add(double(Rtime(CLOCK_MONOTONIC) - tbeg));
+  }
+
   // now call handlers, multiple handlers may be called for one attn bit
   uint16_t hnext = 0;
   uint16_t hdone = 0;
@@ -464,6 +903,11 @@ void RlinkServer::CallAttnHandler()
     uint16_t hmatch = fAttnPatt & fAttnDsc[i].fId.fMask;
     if (hmatch) {
       AttnArgs args(fAttnPatt, fAttnDsc[i].fId.fMask);
+      RlinkCommandList* pclist = fAttnDsc[i].fpClist;
+      if (pclist && find(fAttnCoalList.begin(), fAttnCoalList.end(), 
+                         pclist) != fAttnCoalList.end()) {
+        args.fpClistDone = pclist;
+      }
       lock_guard<RlinkConnect> lock(*fspConn);
 
       if (fTraceLevel > 0) {
@@ -473,7 +917,9 @@ void RlinkServer::CallAttnHandler()
      }
 
       // FIXME_code: return code not used, yet
+      Rtime tbeg(CLOCK_MONOTONIC);
       fAttnDsc[i].fHandler(args);
+      fAttnDsc[i].fpProf->Add(double(Rtime(CLOCK_MONOTONIC) - tbeg));
       if (!args.fHarvestDone)
         Rexception("RlinkServer::CallAttnHandler()",
                    "Handler didn't set fHarvestDone");
@@ -517,25 +963,201 @@ void RlinkServer::CallAttnHandler()
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Execute the primary clists of all pending attn handlers in one round trip.
+/*!
+  All handlers with a pending attention which registered a primary command
+  list are collected. When there are at least two, one list with a single
+  leading attn followed by the commands of all primary lists is executed,
+  and the results are copied back into the primary lists. fAttnCoalList
+  holds the lists which were handled that way.
+
+  The harvested attn pattern seen by the handlers contains only the bits
+  which are not already handled in this round. That's what they see in
+  non-coalesced mode too, because each attn read clears the pattern.
+ */
+
+void RlinkServer::ExecAttnClists()
+{
+  for (auto& o: fAttnDsc) {
+    RlinkCommandList* pclist = o.fpClist;
+    if ((fAttnPatt & o.fId.fMask) == 0 || pclist == nullptr) continue;
+    if (pclist->Size() == 0 || 
+        (*pclist)[0].Command() != RlinkCommand::kCmdAttn) continue;
+    if (find(fAttnCoalList.begin(), fAttnCoalList.end(), pclist) != 
+        fAttnCoalList.end()) continue;
+    fAttnCoalList.push_back(pclist);
+  }
+
+  if (fAttnCoalList.size() < 2) {           // nothing to gain, use default
+    fAttnCoalList.clear();
+    return;
+  }
+
+  lock_guard<RlinkConnect> lock(*fspConn);
+  fAttnClist.Clear();
+  fAttnClist.AddAttn();
+  for (auto pclist: fAttnCoalList) {
+    for (size_t i=1; i<pclist->Size(); i++) 
+      fAttnClist.AddCommand((*pclist)[i]);
+  }
+
+  Exec(fAttnClist);
+
+  fAttnClist[0].SetData(fAttnClist[0].Data() & ~fAttnPatt);
+  size_t ind = 1;
+  for (auto pclist: fAttnCoalList) {
+    (*pclist)[0] = fAttnClist[0];
+    for (size_t i=1; i<pclist->Size(); i++) (*pclist)[i] = fAttnClist[ind++];
+  }
+
+  fStats.Inc(kStatNAttnCoal);
+  fStats.Inc(kStatNAttnCoalHdl, double(fAttnCoalList.size()));
+  if (fTraceLevel > 1) {
+    RlogMsg lmsg(LogFile(),'I');
+    lmsg << "attnhdl-coa: patt=" << RosPrintBvi(fAttnPatt,8)
+         << " nlist=" << fAttnCoalList.size()
+         << " ncmd=" << fAttnClist.Size();
+  }
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
 void RlinkServer::CallActnHandler()
 {
-  if (!ActnPending()) return;
-
-  // call first action
+  ActnFetch();
+  if (fActnNList == 0) return;
+
+  // select class, update delay stats
+  int ipri = ActnSelect();
+  std::deque<ActnDsc>& alist = fActnList[ipri];
+  ActnDsc& dsc = alist.front();
+  double delay = 1.e6 * dsc.fTime.Age(CLOCK_MONOTONIC);  // in usec
+  fStats.Inc(kStatNActnTerm+ipri);
+  fStats.Inc(kStatTActnTerm+ipri, delay);
+  if (delay > fStats.Value(kStatTActnMaxTerm+ipri))
+    fStats.Set(kStatTActnMaxTerm+ipri, delay);
+
+  // call first action of class
   lock_guard<RlinkConnect> lock(*fspConn);
 
-  int irc = fActnList.front()();
+  ActnSrc* psrc = dsc.fpSrc;
+  Rtime tbeg(CLOCK_MONOTONIC);
+  int irc = dsc.fHandler();
+  psrc->fpProf->Add(double(Rtime(CLOCK_MONOTONIC) - tbeg));
 
   // if irc>0 requeue to end, otherwise drop
   if (irc > 0) {
-    fActnList.splice(fActnList.end(), fActnList, fActnList.begin());
+    dsc.fTime.GetClock(CLOCK_MONOTONIC);
+    alist.push_back(move(dsc));
   } else {
-    fActnList.pop_front();
+    fActnNList -= 1;
+  }
+  alist.pop_front();
+
+  // action done: return credit to source, resume it if it was throttled
+  if (irc <= 0) {
+    psrc->fNPend.fetch_sub(1);
+    ActnResume(psrc);
+  }
+
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call resume handler of \a psrc if it is throttled (server thread only)
+
+void RlinkServer::ActnResume(ActnSrc* psrc)
+{
+  if (psrc->fThrottled.load() && psrc->fThrottled.exchange(false)) {
+    fStats.Inc(kStatNActnResume);
+    psrc->fResume();
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Select priority class of next action, uses smooth weighted round robin
+/*!
+  Each class with pending actions gains its weight as credit, the class
+  with the highest credit is selected and pays the sum of the weights.
+  Over time each class gets calls in proportion to its weight, and the
+  calls of a class are spread evenly between the calls of others.
+ */
+
+int RlinkServer::ActnSelect()
+{
+  int64_t wsum = 0;
+  int ibest = -1;
+  for (int i=0; i<kDimPrio; i++) {
+    if (fActnList[i].empty()) {
+      fActnCredit[i] = 0;                   // idle class: no saved credit
+      continue;
+    }
+    fActnCredit[i] += fActnWeight[i];
+    wsum += fActnWeight[i];
+    if (ibest < 0 || fActnCredit[i] > fActnCredit[ibest]) ibest = i;
+  }
+  fActnCredit[ibest] -= wsum;
+  return ibest;
+}
+
+//------------------------------------------+-----------------------------------
+//! Move queued actions to fActnList, called only in server thread
+/*!
+  Also transfers the counters updated by producer threads into fStats,
+  which is only updated by the server thread.
+ */
+
+void RlinkServer::ActnFetch()
+{
+  ActnDsc dsc;
+  while (fActnQueue.Pop(dsc)) {
+    fActnList[dsc.fPrio].push_back(move(dsc));
+    fActnNList += 1;
+    fStats.Inc(kStatNActnQueue);
+  }
+  if (fActnOvflPend.load()) {
+    lock_guard<mutex> lock(fActnOvflMutex);
+    for (auto& o: fActnOvfl) fActnList[o.fPrio].push_back(move(o));
+    fActnNList += fActnOvfl.size();
+    fActnOvfl.clear();
+    fActnOvflPend.store(false);
+  }
+  if (fActnNOvfl.load()) fStats.Inc(kStatNActnOvfl, fActnNOvfl.exchange(0));
+  if (fActnNDrop.load()) fStats.Inc(kStatNActnDrop, fActnNDrop.exchange(0));
+  if (fActnNDefer.load())
+    fStats.Inc(kStatNActnDefer, fActnNDefer.exchange(0));
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Prepare waiting in event loop, returns false if actions are pending
+/*!
+  Sets fActnSleep, so the next QueueAction() will signal a Wakeup(). The
+  fence pairs with QueueAction(), either the producer sees fActnSleep or
+  the check here sees the action.
+ */
+
+bool RlinkServer::ActnSleep()
+{
+  fActnSleep.store(true);
+  atomic_thread_fence(memory_order_seq_cst);
+  if (ActnPending()) {
+    fActnSleep.store(false);
+    return false;
   }
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Signal end of wait in event loop
 
+void RlinkServer::ActnAwake()
+{
+  fActnSleep.store(false);
   return;
 }
 
@@ -553,6 +1175,62 @@ int RlinkServer::WakeupHandler(const pollfd& pfd)
   return 0;
 }
 
+//------------------------------------------+-----------------------------------
+//! Call the completions of the I/O worker pool
+
+int RlinkServer::IoDoneHandler(const pollfd& pfd)
+{
+  fStats.Inc(kStatNIoDoneEvt);
+
+  // bail-out and cancel handler if poll returns an error event
+  if (pfd.revents & (~pfd.events)) return -1;
+
+  lock_guard<RlinkConnect> lock(*fspConn);
+  fIoPool.DoCompletions();
+  return 0;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call the handlers of all expired timers
+
+int RlinkServer::TimerHandler(const pollfd& pfd)
+{
+  fStats.Inc(kStatNTimerEvt);
+
+  // bail-out and cancel handler if poll returns an error event
+  if (pfd.revents & (~pfd.events)) return -1;
+
+  fTimerFd.Read();                          // harvest expiration count
+  lock_guard<RlinkConnect> lock(*fspConn);
+  fTimerNext.Clear();                       // timerfd now disarmed
+  try {
+    fTimerWheel.Expire(Rtime(CLOCK_MONOTONIC));
+  } catch (...) {
+    TimerRearm();
+    throw;
+  }
+  TimerRearm();
+  return 0;
+}
+
+//------------------------------------------+-----------------------------------
+//! Arm fTimerFd for the next wheel deadline, must be called with lock held
+
+void RlinkServer::TimerRearm()
+{
+  Rtime next;
+  if (fTimerWheel.NextDeadline(next)) {
+    if (fTimerNext.IsZero() || next != fTimerNext) {
+      fTimerFd.SetAbsolute(next);
+      fTimerNext = next;
+    }
+  } else if (!fTimerNext.IsZero()) {
+    fTimerFd.Cancel();
+    fTimerNext.Clear();
+  }
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
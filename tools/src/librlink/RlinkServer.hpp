@@ -1,9 +1,21 @@
 // $Id: RlinkServer.hpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   2.12.2 atomic ActnSrc counters; add SetActnLimit()
+// 2026-10-18  1227   2.12.1 add fActnNOvfl
+// 2026-10-18  1221   2.12   add action sources with limit and resume (ActnSource())
+// 2026-10-18  1220   2.11   add handler call profiles (Profile(),ProfileList())
+// 2026-10-18  1219   2.10   add SetCpu(),Cpu(),SyncLogFile()
+// 2026-10-18  1217   2.9    add priority classes for actions and attn handlers
+// 2026-10-18  1216   2.8    QueueAction(): use lock-free RmpscQueue
+// 2026-10-18  1215   2.7    add timer wheel (AddTimer(),CancelTimer())
+// 2026-10-18  1214   2.6    add I/O worker pool (IoPool())
+// 2026-10-18  1213   2.5    add coalesced attn handling (SetAttnCoalesce)
+// 2026-10-18  1208   2.4    add AttnPendingPatt()
+// 2026-10-18  1205   2.3    add ExecAsync()
 // 2019-06-07  1160   2.2.7  Stats() not longer const
 // 2018-12-17  1088   2.2.6  use std::thread instead of boost
 // 2018-12-16  1084   2.2.5  use =delete for noncopyable instead of boost
@@ -31,13 +43,20 @@
 
 #include <cstdint>
 #include <vector>
-#include <list>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "librtools/Rstats.hpp"
 #include "librtools/ReventFd.hpp"
+#include "librtools/RworkerPool.hpp"
+#include "librtools/RmpscQueue.hpp"
+#include "librtools/RtimerFd.hpp"
+#include "librtools/RtimerWheel.hpp"
+#include "librtools/RcallProf.hpp"
 
 #include "RlinkConnect.hpp"
 #include "RlinkContext.hpp"
@@ -53,13 +72,40 @@ namespace Retro {
         uint16_t    fAttnMask;              //!< in: handler attention mask
         uint16_t    fAttnHarvest;           //!< out: harvested attentions
         bool        fHarvestDone;           //!< out: set true when harvested
+        RlinkCommandList* fpClistDone;      //!< in: clist already executed
                     AttnArgs();
                     AttnArgs(uint16_t apatt, uint16_t amask);
       };
 
+      //! priority classes for actions and attention handlers
+      enum prio {
+        kPrioTerm = 0,                      //!< interactive terminal
+        kPrioNet,                           //!< network
+        kPrioBulk,                          //!< bulk DMA
+        kPrioBack,                          //!< background
+        kDimPrio
+      };
+
       typedef ReventLoop::pollhdl_t          pollhdl_t;
       typedef std::function<int(AttnArgs&)>  attnhdl_t;
       typedef std::function<int()>           actnhdl_t;
+      typedef RlinkConnect::exechdl_t        exechdl_t;
+      typedef RtimerWheel::timerhdl_t        timerhdl_t;
+      typedef RtimerWheel::id_t              timerid_t;
+      typedef std::function<void()>          resumehdl_t;
+
+      //! action source, limits the pending actions of one producer
+      struct ActnSrc {
+        std::string fName;                  //!< source name
+        RcallProf*  fpProf;                 //!< call profile
+        std::atomic<size_t> fLimit;         //!< max pending actions (0=none)
+        resumehdl_t fResume;                //!< called when unthrottled
+        std::atomic<size_t> fNPend;         //!< pending actions
+        std::atomic<bool> fThrottled;       //!< refused, resume pending
+        std::atomic<uint64_t> fNDrop;       //!< refused without fResume
+        std::atomic<uint64_t> fNDefer;      //!< refused with fResume
+                    ActnSrc(const std::string& name, RcallProf* pprof);
+      };
 
       explicit      RlinkServer();
       virtual      ~RlinkServer();
@@ -75,17 +121,34 @@ namespace Retro {
 
       bool          Exec(RlinkCommandList& clist, RerrMsg& emsg);
       void          Exec(RlinkCommandList& clist);
+      bool          ExecAsync(RlinkCommandList& clist, exechdl_t&& exechdl,
+                              RerrMsg& emsg);
+      void          ExecAsync(RlinkCommandList& clist, exechdl_t&& exechdl);
 
       void          AddAttnHandler(attnhdl_t&& attnhdl, uint16_t mask,
-                                   void* cdata = nullptr);
+                                   void* cdata = nullptr,
+                                   RlinkCommandList* pclist = nullptr,
+                                   prio pri = kPrioBulk,
+                                   const std::string& name = "");
       void          RemoveAttnHandler(uint16_t mask, void* cdata = nullptr);
       void          GetAttnInfo(AttnArgs& args, RlinkCommandList& clist);
       void          GetAttnInfo(AttnArgs& args);
 
-      void          QueueAction(actnhdl_t&& actnhdl);
+      bool          QueueAction(actnhdl_t&& actnhdl, prio pri = kPrioBulk,
+                                ActnSrc* psrc = nullptr);
+      ActnSrc*      ActnSource(const std::string& name, size_t limit = 0,
+                               resumehdl_t&& resume = resumehdl_t());
+      bool          SetActnLimit(const std::string& name, size_t limit);
+      void          ActnSourceList(std::vector<const ActnSrc*>& list);
+      RworkerPool&  IoPool();
+
+      timerid_t     AddTimer(const Rtime& deadline, timerhdl_t&& timerhdl);
+      timerid_t     AddTimerRelative(const Rtime& dt, timerhdl_t&& timerhdl);
+      bool          CancelTimer(timerid_t id);
 
       void          AddPollHandler(pollhdl_t&& pollhdl,
-                                   int fd, short events=POLLIN);
+                                   int fd, short events=POLLIN,
+                                   const std::string& name = "");
       bool          TestPollHandler(int fd, short events=POLLIN);
       void          RemovePollHandler(int fd, short events, bool nothrow=false);
       void          RemovePollHandler(int fd);
@@ -95,6 +158,7 @@ namespace Retro {
       void          Resume();
       void          Wakeup();
       void          SignalAttnNotify(uint16_t apat);
+      uint16_t      AttnPendingPatt() const;
 
       bool          IsActive() const;
       bool          IsActiveInside() const;
@@ -102,6 +166,17 @@ namespace Retro {
 
       void          SetTraceLevel(uint32_t level);
       uint32_t      TraceLevel() const;
+      void          SetAttnCoalesce(bool coal);
+      bool          AttnCoalesce() const;
+      void          SetActnWeight(prio pri, uint32_t weight);
+      uint32_t      ActnWeight(prio pri) const;
+      void          SetCpu(int cpu);
+      int           Cpu() const;
+      void          SyncLogFile();
+
+      RcallProf*    Profile(const std::string& name);
+      void          ProfileList(std::vector<const RcallProf*>& list);
+      void          ProfileReset();
 
       Rstats&       Stats();
 
@@ -115,9 +190,30 @@ namespace Retro {
         kStatNEloopPoll,                    //!< event loop turns (poll)
         kStatNWakeupEvt,                    //!< Wakeup events
         kStatNRlinkEvt,                     //!< Rlink data events
+        kStatNIoDoneEvt,                    //!< I/O completion events
+        kStatNTimerEvt,                     //!< Timer events
+        kStatNActnQueue,                    //!< actions taken from queue
+        kStatNActnOvfl,                     //!< actions queued to overflow
+        kStatNActnDrop,                     //!< actions refused (dropped)
+        kStatNActnDefer,                    //!< actions refused (deferred)
+        kStatNActnResume,                   //!< throttled sources resumed
+        kStatNActnTerm,                     //!< actions called (term)
+        kStatNActnNet,                      //!< actions called (net)
+        kStatNActnBulk,                     //!< actions called (bulk)
+        kStatNActnBack,                     //!< actions called (back)
+        kStatTActnTerm,                     //!< action delay sum in us (term)
+        kStatTActnNet,                      //!< action delay sum in us (net)
+        kStatTActnBulk,                     //!< action delay sum in us (bulk)
+        kStatTActnBack,                     //!< action delay sum in us (back)
+        kStatTActnMaxTerm,                  //!< action delay max in us (term)
+        kStatTActnMaxNet,                   //!< action delay max in us (net)
+        kStatTActnMaxBulk,                  //!< action delay max in us (bulk)
+        kStatTActnMaxBack,                  //!< action delay max in us (back)
         kStatNAttnHdl,                      //!< Attn handler calls
         kStatNAttnNoti,                     //!< Attn notifies processed
         kStatNAttnHarv,                     //!< Attn handler restarts
+        kStatNAttnCoal,                     //!< Attn coalesced executes
+        kStatNAttnCoalHdl,                  //!< Attn coalesced handlers
         kStatNAttn00,                       //!< Attn bit  0 set
         kStatNAttn01,                       //!< Attn bit  1 set
         kStatNAttn02,                       //!< Attn bit  2 set
@@ -143,10 +239,20 @@ namespace Retro {
       void          StartOrResume(bool resume);
       bool          AttnPending() const;
       bool          ActnPending() const;
+      bool          ActnSleep();
+      void          ActnAwake();
+      void          ActnFetch();
+      int           ActnSelect();
+      void          ActnResume(ActnSrc* psrc);
       void          CallAttnHandler();
+      void          ExecAttnClists();
       void          CallActnHandler();
       int           WakeupHandler(const pollfd& pfd);
       int           RlinkHandler(const pollfd& pfd);
+      int           IoDoneHandler(const pollfd& pfd);
+      int           TimerHandler(const pollfd& pfd);
+      void          TimerRearm();
+      void          ApplyCpu();
 
     protected:
       struct AttnId {
@@ -160,20 +266,58 @@ namespace Retro {
       struct AttnDsc {
         attnhdl_t   fHandler;
         AttnId      fId;
+        RlinkCommandList* fpClist;          //!< primary clist (or nullptr)
+        prio        fPrio;                  //!< priority class
+        RcallProf*  fpProf;                 //!< call profile
                     AttnDsc();
-                    AttnDsc(attnhdl_t&& hdl, const AttnId& id);
+                    AttnDsc(attnhdl_t&& hdl, const AttnId& id,
+                            RlinkCommandList* pclist, prio pri,
+                            RcallProf* pprof);
+      };
+
+      struct ActnDsc {
+        actnhdl_t   fHandler;               //!< action
+        Rtime       fTime;                  //!< time queued
+        prio        fPrio;                  //!< priority class
+        ActnSrc*    fpSrc;                  //!< action source
+                    ActnDsc();
+                    ActnDsc(actnhdl_t&& hdl, prio pri, ActnSrc* psrc);
       };
 
       std::shared_ptr<RlinkConnect>  fspConn;
       RlinkContext  fContext;               //!< default server context
       std::vector<AttnDsc>  fAttnDsc;
-      std::list<actnhdl_t>  fActnList;
+      RmpscQueue<ActnDsc> fActnQueue;       //!< queued actions (lock-free)
+      std::mutex    fActnOvflMutex;         //!< protects fActnOvfl
+      std::deque<ActnDsc> fActnOvfl;        //!< actions queued when full
+      std::atomic<bool> fActnOvflPend;      //!< fActnOvfl not empty
+      std::atomic<uint64_t> fActnNOvfl;     //!< overflows, not yet in fStats
+      std::atomic<uint64_t> fActnNDrop;     //!< drops, not yet in fStats
+      std::atomic<uint64_t> fActnNDefer;    //!< defers, not yet in fStats
+      std::atomic<bool> fActnSleep;         //!< server thread waits
+      std::deque<ActnDsc> fActnList[kDimPrio]; //!< actions of server thread
+      size_t        fActnNList;             //!< actions in fActnList
+      uint32_t      fActnWeight[kDimPrio];  //!< scheduler weights
+      int64_t       fActnCredit[kDimPrio];  //!< scheduler credits
       ReventFd      fWakeupEvent;
+      RworkerPool   fIoPool;                //!< I/O worker pool
+      RtimerWheel   fTimerWheel;            //!< timers
+      RtimerFd      fTimerFd;               //!< timerfd driving fTimerWheel
+      Rtime         fTimerNext;             //!< fTimerFd deadline (0 if idle)
       RlinkServerEventLoop fELoop;
       std::thread   fServerThread;
+      int           fCpu;                   //!< server thread cpu (-1 none)
       uint16_t      fAttnPatt;              //!< current attn pattern
       uint16_t      fAttnNotiPatt;          //!< attn notifier pattern
       uint32_t      fTraceLevel;            //!< trace level
+      bool          fAttnCoal;              //!< coalesced attn handling
+      RlinkCommandList fAttnClist;          //!< clist for coalesced attn
+      std::vector<RlinkCommandList*> fAttnCoalList; //!< coalesced clists
+      std::mutex    fProfMutex;             //!< protects fProf,fActnSrc
+      std::deque<RcallProf> fProf;          //!< handler call profiles
+      std::deque<ActnSrc> fActnSrc;         //!< action sources
+      ActnSrc*      fpActnSrcDef[kDimPrio]; //!< default action sources
+      RcallProf*    fpProfAttnCoal;         //!< ExecAttnClists() profile
       Rstats        fStats;                 //!< statistics
 };
   
@@ -1,9 +1,18 @@
 // $Id: RlinkServer.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1221   2.12   add action sources with limit and resume (ActnSource())
+// 2026-10-18  1220   2.11   add handler call profiles (Profile(),ProfileList())
+// 2026-10-18  1219   2.10   add Cpu()
+// 2026-10-18  1217   2.9    add priority classes for actions and attn handlers
+// 2026-10-18  1216   2.8    use lock-free RmpscQueue for actions
+// 2026-10-18  1214   2.6    add IoPool()
+// 2026-10-18  1213   2.5    add coalesced attn handling
+// 2026-10-18  1208   2.4    add AttnPendingPatt()
+// 2026-10-18  1205   2.3    add ExecAsync()
 // 2019-06-07  1160   2.2.3  Stats() not longer const
 // 2018-12-15  1083   2.2.2  for std::function setups: use rval ref and move
 // 2018-12-07  1078   2.2.1  use std::shared_ptr instead of boost
@@ -71,6 +80,25 @@ inline void RlinkServer::Exec(RlinkCommandList& clist)
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Queue command list for asynchronous execution, see RlinkConnect::ExecAsync
+
+inline bool RlinkServer::ExecAsync(RlinkCommandList& clist, 
+                                   exechdl_t&& exechdl, RerrMsg& emsg)
+{
+  return Connect().ExecAsync(clist, fContext, move(exechdl), emsg);
+}
+
+//------------------------------------------+-----------------------------------
+//! Queue command list for asynchronous execution, see RlinkConnect::ExecAsync
+
+inline void RlinkServer::ExecAsync(RlinkCommandList& clist, 
+                                   exechdl_t&& exechdl)
+{
+  Connect().ExecAsync(clist, fContext, move(exechdl));
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -79,6 +107,52 @@ inline uint32_t RlinkServer::TraceLevel() const
   return fTraceLevel;
 }
 
+//------------------------------------------+-----------------------------------
+//! Returns the I/O worker pool.
+/*!
+  Blocking I/O, e.g. of virtual disks or tapes, should be submitted to this
+  pool. The completions are called from the server thread with the connect
+  lock held, just like attn and action handlers.
+ */
+
+inline RworkerPool& RlinkServer::IoPool()
+{
+  return fIoPool;
+}
+
+//------------------------------------------+-----------------------------------
+//! Enable or disable coalesced attn handling, see CallAttnHandler()
+
+inline void RlinkServer::SetAttnCoalesce(bool coal)
+{
+  fAttnCoal = coal;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns \c true if attn handling is coalesced
+
+inline bool RlinkServer::AttnCoalesce() const
+{
+  return fAttnCoal;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns scheduler weight of priority class \a pri
+
+inline uint32_t RlinkServer::ActnWeight(prio pri) const
+{
+  return pri < kDimPrio ? fActnWeight[pri] : 0;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns cpu the server thread is pinned to, -1 if not pinned
+
+inline int RlinkServer::Cpu() const
+{
+  return fCpu;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -95,12 +169,20 @@ inline bool RlinkServer::AttnPending() const
   return fAttnNotiPatt | fAttnPatt;
 }
 
+//------------------------------------------+-----------------------------------
+//! Returns pattern of attentions which are notified but not yet handled.
+
+inline uint16_t RlinkServer::AttnPendingPatt() const
+{    
+  return fAttnNotiPatt | fAttnPatt;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
 inline bool RlinkServer::ActnPending() const
 {    
-  return !fActnList.empty();
+  return fActnNList || !fActnQueue.Empty() || fActnOvflPend.load();
 }
 
 //==========================================+===================================
@@ -118,7 +200,8 @@ inline RlinkServer::AttnArgs::AttnArgs()
   : fAttnPatt(0),
     fAttnMask(0), 
     fAttnHarvest(0),
-    fHarvestDone(false) 
+    fHarvestDone(false),
+    fpClistDone(nullptr)
 {}
 
 //------------------------------------------+-----------------------------------
@@ -128,7 +211,8 @@ inline RlinkServer::AttnArgs::AttnArgs(uint16_t apatt, uint16_t amask)
   : fAttnPatt(apatt),
     fAttnMask(amask), 
     fAttnHarvest(0),
-    fHarvestDone(false)
+    fHarvestDone(false),
+    fpClistDone(nullptr)
 {}
 
 //==========================================+===================================
@@ -176,15 +260,74 @@ inline bool RlinkServer::AttnId::operator==(const AttnId& rhs) const
 
 inline RlinkServer::AttnDsc::AttnDsc()
   : fHandler(),
-    fId()
+    fId(),
+    fpClist(nullptr),
+    fPrio(kPrioBulk),
+    fpProf(nullptr)
 {}
 
 //------------------------------------------+-----------------------------------
 //! Constructor
 
-inline RlinkServer::AttnDsc::AttnDsc(attnhdl_t&& hdl, const AttnId& id)
+inline RlinkServer::AttnDsc::AttnDsc(attnhdl_t&& hdl, const AttnId& id,
+                                     RlinkCommandList* pclist, prio pri,
+                                     RcallProf* pprof)
   : fHandler(move(hdl)),
-    fId(id)
+    fId(id),
+    fpClist(pclist),
+    fPrio(pri),
+    fpProf(pprof)
+{}
+
+//==========================================+===================================
+// ActnDsc sub class
+
+/*!
+  \class Retro::RlinkServer::ActnDsc
+  \brief Queued action with priority class and queue time.
+*/
+
+//------------------------------------------+-----------------------------------
+//! Default constructor
+
+inline RlinkServer::ActnDsc::ActnDsc()
+  : fHandler(),
+    fTime(),
+    fPrio(kPrioBulk),
+    fpSrc(nullptr)
+{}
+
+//------------------------------------------+-----------------------------------
+//! Constructor, sets fTime to current time
+
+inline RlinkServer::ActnDsc::ActnDsc(actnhdl_t&& hdl, prio pri,
+                                     ActnSrc* psrc)
+  : fHandler(move(hdl)),
+    fTime(CLOCK_MONOTONIC),
+    fPrio(pri),
+    fpSrc(psrc)
+{}
+
+//==========================================+===================================
+// ActnSrc sub class
+
+/*!
+  \class Retro::RlinkServer::ActnSrc
+  \brief Producer of actions, with call profile and pending action limit.
+*/
+
+//------------------------------------------+-----------------------------------
+//! Constructor
+
+inline RlinkServer::ActnSrc::ActnSrc(const std::string& name, RcallProf* pprof)
+  : fName(name),
+    fpProf(pprof),
+    fLimit(0),
+    fResume(),
+    fNPend(0),
+    fThrottled(false),
+    fNDrop(0),
+    fNDefer(0)
 {}
 
 } // end namespace Retro
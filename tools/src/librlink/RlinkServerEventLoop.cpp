@@ -1,9 +1,10 @@
 // $Id: RlinkServerEventLoop.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2015 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1216   1.3    EventLoop(): use ActnSleep()/ActnAwake()
 // 2015-04-04   662   1.2    BUGFIX: fix race in Stop(), use StopPending()
 // 2013-03-05   495   1.1.1  add exception catcher to EventLoop
 // 2013-02-22   491   1.1    use new RlogFile/RlogMsg interfaces
@@ -56,8 +57,10 @@ void RlinkServerEventLoop::EventLoop()
   try {
     while (!StopPending()) {
       int timeout = (fpServer->AttnPending() || 
-                     fpServer->ActnPending()) ? 0 : -1;
+                     fpServer->ActnPending() ||
+                     !fpServer->ActnSleep()) ? 0 : -1;
       int irc = DoPoll(timeout);
+      if (timeout < 0) fpServer->ActnAwake();
       fpServer->fStats.Inc(timeout<0 ? RlinkServer::kStatNEloopWait : 
                            RlinkServer::kStatNEloopPoll);
       if (fPollFd.size() == 0) break;
@@ -1,9 +1,14 @@
 // $Id: RtclRlinkConnect.cpp 1175 2019-06-30 06:13:17Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.6.17 M_exec: add -async; M_get: add asyncpend
+// 2026-10-18  1218   1.6.16 M_get/set: add spin
+// 2026-10-18  1211   1.6.15 M_exec: re-use fClist
+// 2026-10-18  1207   1.6.14 M_stats: add -hist
+// 2026-10-18  1202   1.6.13 M_get/set: add window
 // 2019-06-29  1175   1.6.12 M_log(): add missing OptValid() call
 // 2019-06-07  1160   1.6.11 use RtclStats::Exec()
 // 2019-03-10  1121   1.6.10 M_exec(): tranfer BlockDone values after rblk
@@ -83,7 +88,8 @@ RtclRlinkConnect::RtclRlinkConnect(Tcl_Interp* interp, const char* name)
   : RtclProxyOwned<RlinkConnect>("RlinkConnect", interp, name, 
                                  new RlinkConnect()),
     fGets(),
-    fSets()
+    fSets(),
+    fClist()
 {
   AddMeth("open",     bind(&RtclRlinkConnect::M_open,    this, _1));
   AddMeth("close",    bind(&RtclRlinkConnect::M_close,   this, _1));
@@ -119,6 +125,10 @@ RtclRlinkConnect::RtclRlinkConnect(Tcl_Interp* interp, const char* name)
   fGets.Add<uint32_t>  ("tracelevel", bind(&RlinkConnect::TraceLevel, pobj));
   fGets.Add<const Rtime&> ("timeout", bind(&RlinkConnect::Timeout, pobj));
   fGets.Add<const string&> ("logfile",bind(&RlinkConnect::LogFileName, pobj));
+  fGets.Add<size_t>    ("window",     bind(&RlinkConnect::ExecWindow, pobj));
+  fGets.Add<size_t>    ("asyncpend",
+                        bind(&RlinkConnect::ExecAsyncPending, pobj));
+  fGets.Add<uint32_t>  ("spin",       bind(&RlinkConnect::SpinTime, pobj));
 
   fGets.Add<uint32_t>  ("initdone",   bind(&RlinkConnect::LinkInitDone, pobj));
   fGets.Add<uint32_t>  ("sysid",      bind(&RlinkConnect::SysId, pobj));
@@ -145,6 +155,10 @@ RtclRlinkConnect::RtclRlinkConnect(Tcl_Interp* interp, const char* name)
                                bind(&RlinkConnect::SetTimeout, pobj, _1));
   fSets.Add<const string&>  ("logfile", 
                                bind(&RlinkConnect::SetLogFileName, pobj, _1));  
+  fSets.Add<size_t>    ("window", 
+                          bind(&RlinkConnect::SetExecWindow, pobj, _1));
+  fSets.Add<uint32_t>  ("spin", 
+                          bind(&RlinkConnect::SetSpinTime, pobj, _1));
 
   // attributes of buildin RlinkContext
   RlinkContext* pcntx = &Obj().Context();
@@ -219,11 +233,12 @@ int RtclRlinkConnect::M_exec(RtclArgs& args)
   static RtclNameSet optset("-rreg|-rblk|-wreg|-wblk|-labo|-attn|-init|"
                             "-edata|-edone|-estat|"
                             "-estaterr|-estatnak|-estattout|"
-                            "-print|-dump|-rlist");
+                            "-print|-dump|-rlist|-async");
 
   Tcl_Interp* interp = args.Interp();
 
-  RlinkCommandList clist;
+  RlinkCommandList& clist = fClist;
+  clist.Clear();
   string opt;
   uint16_t addr=0;
 
@@ -232,6 +247,7 @@ int RtclRlinkConnect::M_exec(RtclArgs& args)
   string varprint;
   string vardump;
   string varlist;
+  bool async = false;
 
   while (args.NextOpt(opt, optset)) {
     
@@ -340,6 +356,8 @@ int RtclRlinkConnect::M_exec(RtclArgs& args)
     } else if (opt == "-rlist") {           // -rlist ?varRes -----------------
       varlist = "-";
       if (!args.GetArg("??varRes", varlist)) return kERR;
+    } else if (opt == "-async") {           // -async -------------------------
+      async = true;
     }
 
   } // while (args.NextOpt(opt, optset))
@@ -356,6 +374,21 @@ int RtclRlinkConnect::M_exec(RtclArgs& args)
   if (clist.Size() == 0) return kOK;
 
   RerrMsg emsg;
+
+  if (async) {                              // -async: no results returned
+    bool hasvar = !varprint.empty() || !vardump.empty() || !varlist.empty();
+    for (auto& o: vardata) if (!o.empty()) hasvar = true;
+    for (auto& o: varstat) if (!o.empty()) hasvar = true;
+    if (hasvar)
+      return args.Quit("-E: -async doesn't allow result variables or "
+                       "-print,-dump,-rlist");
+    // the list must live till completion, the handler keeps a copy alive
+    auto splist = make_shared<RlinkCommandList>(clist);
+    if (!Obj().ExecAsync(*splist, Obj().Context(),
+                         [splist](RlinkCommandList&, bool){}, emsg))
+      return args.Quit(emsg);
+    return kOK;
+  }
   
   if (!Obj().Exec(clist, emsg)) return args.Quit(emsg);
 
@@ -701,8 +734,20 @@ int RtclRlinkConnect::M_rawwblk(RtclArgs& args)
 
 int RtclRlinkConnect::M_stats(RtclArgs& args)
 {
+  static RtclNameSet suboptset("-hist");
+  string subopt;
+  bool hist = false;
+  if (args.NextSubOpt(subopt, suboptset) >= 0) {
+    if (!args.OptValid()) return kERR;
+    hist = true;
+  }
+
   RtclStats::Context cntx;
   if (!RtclStats::GetArgs(args, cntx)) return kERR;
+  if (hist || cntx.opt == "-reset") {       // -hist: histograms only
+    if (!RtclStats::Exec(args, cntx, Obj().HistStats())) return kERR;
+    if (hist) return kOK;
+  }
   if (!RtclStats::Exec(args, cntx, Obj().Stats())) return kERR;
   if (!RtclStats::Exec(args, cntx, Obj().SndStats())) return kERR;
   if (!RtclStats::Exec(args, cntx, Obj().RcvStats())) return kERR;
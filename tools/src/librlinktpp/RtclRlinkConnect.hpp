@@ -1,9 +1,10 @@
 // $Id: RtclRlinkConnect.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2017 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1211   1.1.1  add fClist
 // 2017-04-29   888   1.1    drop M_rawio; add M_rawread,M_rawrblk,M_rawwblk
 // 2015-04-12   666   1.0.5  add M_init
 // 2015-01-06   631   1.0.4  add M_get, M_set, remove M_config
@@ -69,6 +70,7 @@ namespace Retro {
       RtclOPtr      fCmdnameObj[8];
       RtclGetList   fGets;
       RtclSetList   fSets;
+      RlinkCommandList fClist;              //!< re-used list of M_exec
   };
   
 } // end namespace Retro
@@ -1,9 +1,16 @@
 // $Id: RtclRlinkServer.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.11 add stats -sources and actnlimit
+// 2026-10-18  1227   1.2.10 stats -handlers: adopt to new RcallProf bins
+// 2026-10-18  1220   1.2.9  add stats -handlers
+// 2026-10-18  1219   1.2.8  add cpu and conn attributes
+// 2026-10-18  1217   1.2.7  add actnw* attributes
+// 2026-10-18  1214   1.2.6  add iothreads attribute
+// 2026-10-18  1213   1.2.5  add attncoal attribute
 // 2019-06-07  1160   1.2.4  use RtclStats::Exec()
 // 2019-02-23  1114   1.2.3  use std::bind instead of lambda
 // 2018-12-17  1087   1.2.2  use std::lock_guard instead of boost
@@ -34,6 +41,7 @@
 #include <memory>
 #include <functional>
 
+#include "librtools/RosPrintf.hpp"
 #include "librtools/RosPrintBvi.hpp"
 #include "librtcltools/Rtcl.hpp"
 #include "librtcltools/RtclOPtr.hpp"
@@ -61,12 +69,14 @@ RtclRlinkServer::RtclRlinkServer(Tcl_Interp* interp, const char* name)
   : RtclProxyOwned<RlinkServer>("RlinkServer", interp, name, 
                                 new RlinkServer()),
     fspConn(),
+    fConnName(),
     fGets(),
     fSets()
 {
   AddMeth("server",   bind(&RtclRlinkServer::M_server,  this, _1));
   AddMeth("attn",     bind(&RtclRlinkServer::M_attn,    this, _1));
   AddMeth("stats",    bind(&RtclRlinkServer::M_stats,   this, _1));
+  AddMeth("actnlimit",bind(&RtclRlinkServer::M_actnlimit,this, _1));
   AddMeth("print",    bind(&RtclRlinkServer::M_print,   this, _1));
   AddMeth("dump",     bind(&RtclRlinkServer::M_dump,    this, _1));
   AddMeth("get",      bind(&RtclRlinkServer::M_get,     this, _1));
@@ -77,9 +87,53 @@ RtclRlinkServer::RtclRlinkServer(Tcl_Interp* interp, const char* name)
   RlinkServer* pobj  = &Obj();
   fGets.Add<uint32_t>  ("tracelevel", 
                           bind(&RlinkServer::TraceLevel, pobj));
+  fGets.Add<bool>      ("attncoal", 
+                          bind(&RlinkServer::AttnCoalesce, pobj));
 
   fSets.Add<uint32_t>  ("tracelevel",
                           bind(&RlinkServer::SetTraceLevel, pobj, _1));
+  fSets.Add<bool>      ("attncoal",
+                          bind(&RlinkServer::SetAttnCoalesce, pobj, _1));
+  fGets.Add<const string&> ("conn",
+                          bind(&RtclRlinkServer::ConnName, this));
+  fGets.Add<int>       ("cpu", 
+                          bind(&RlinkServer::Cpu, pobj));
+  fSets.Add<int>       ("cpu",
+                          bind(&RlinkServer::SetCpu, pobj, _1));
+
+  // weights of action scheduler
+  fGets.Add<uint32_t>  ("actnwterm", 
+                          bind(&RlinkServer::ActnWeight, pobj,
+                               RlinkServer::kPrioTerm));
+  fGets.Add<uint32_t>  ("actnwnet", 
+                          bind(&RlinkServer::ActnWeight, pobj,
+                               RlinkServer::kPrioNet));
+  fGets.Add<uint32_t>  ("actnwbulk", 
+                          bind(&RlinkServer::ActnWeight, pobj,
+                               RlinkServer::kPrioBulk));
+  fGets.Add<uint32_t>  ("actnwback", 
+                          bind(&RlinkServer::ActnWeight, pobj,
+                               RlinkServer::kPrioBack));
+
+  fSets.Add<uint32_t>  ("actnwterm",
+                          bind(&RlinkServer::SetActnWeight, pobj,
+                               RlinkServer::kPrioTerm, _1));
+  fSets.Add<uint32_t>  ("actnwnet",
+                          bind(&RlinkServer::SetActnWeight, pobj,
+                               RlinkServer::kPrioNet, _1));
+  fSets.Add<uint32_t>  ("actnwbulk",
+                          bind(&RlinkServer::SetActnWeight, pobj,
+                               RlinkServer::kPrioBulk, _1));
+  fSets.Add<uint32_t>  ("actnwback",
+                          bind(&RlinkServer::SetActnWeight, pobj,
+                               RlinkServer::kPrioBack, _1));
+
+  // attributes of I/O worker pool
+  RworkerPool* ppool = &Obj().IoPool();
+  fGets.Add<size_t>    ("iothreads", 
+                          bind(&RworkerPool::NThread, ppool));
+  fSets.Add<size_t>    ("iothreads",
+                          bind(&RworkerPool::SetNThread, ppool, _1));
 
   // attributes of buildin RlinkContext
   RlinkContext* pcntx = &Obj().Context();
@@ -121,10 +175,19 @@ int RtclRlinkServer::ClassCmdConfig(RtclArgs& args)
   fspConn = dynamic_cast<RtclRlinkConnect*>(pprox)->ObjSPtr();
   // set RlinkConnect in RlinkServer (make RlinkServer also co-owner)
   Obj().SetConnect(fspConn);
+  fConnName = parent;
 
   return kOK;
 }
 
+//------------------------------------------+-----------------------------------
+//! Returns name of the RlinkConnect proxy given in ClassCmdConfig()
+
+const std::string& RtclRlinkServer::ConnName() const
+{
+  return fConnName;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -262,12 +325,85 @@ int RtclRlinkServer::M_attn(RtclArgs& args)
 
 int RtclRlinkServer::M_stats(RtclArgs& args)
 {
+  // stats -handlers: call profiles of handlers, sorted by total time
+  // stats -sources:  limits and refusal counts of action sources
+  static RtclNameSet hdlset("-handlers");
+  static RtclNameSet srcset("-sources");
+  static RtclNameSet rstset("-reset");
+  string opt;
+  if (string(args.PeekArgString(0)) == "-handlers") {
+    args.NextOpt(opt, hdlset);
+    bool reset = args.NextOpt(opt, rstset);
+    if (!args.AllDone()) return kERR;
+    vector<const RcallProf*> list;
+    Obj().ProfileList(list);
+    ostringstream sos;
+    sos << "name                 ncall      tsum(us)  tavg(us)    tmax(us)"
+        << "  | hist: <2us <4us <8us ...";
+    for (auto p: list) {
+      sos << endl;
+      p->Print(sos);
+    }
+    if (reset) Obj().ProfileReset();
+    args.SetResult(sos);
+    return kOK;
+  }
+  if (string(args.PeekArgString(0)) == "-sources") {
+    args.NextOpt(opt, srcset);
+    if (!args.AllDone()) return kERR;
+    vector<const RlinkServer::ActnSrc*> list;
+    Obj().ActnSourceList(list);
+    ostringstream sos;
+    sos << "name                limit npend resume      ndrop      ndefer";
+    for (auto p: list) {
+      sos << endl << RosPrintf(p->fName.c_str(), "-s", 18)
+          << " " << RosPrintf(p->fLimit.load(), "d", 6)
+          << " " << RosPrintf(p->fNPend.load(), "d", 5)
+          << " " << RosPrintf(p->fResume ? "yes" : "no", "-s", 6)
+          << " " << RosPrintf(p->fNDrop.load(), "d", 10)
+          << "  " << RosPrintf(p->fNDefer.load(), "d", 10);
+    }
+    args.SetResult(sos);
+    return kOK;
+  }
+
   RtclStats::Context cntx;
   if (!RtclStats::GetArgs(args, cntx)) return kERR;
   if (!RtclStats::Exec(args, cntx, Obj().Stats())) return kERR;
   return kOK;
 }
 
+//------------------------------------------+-----------------------------------
+//! Get or set the pending action limit of an action source
+/*!
+  Usage: actnlimit name ?limit?  (0 means unlimited)
+ */
+
+int RtclRlinkServer::M_actnlimit(RtclArgs& args)
+{
+  string name;
+  int32_t limit = 0;
+  if (!args.GetArg("name", name)) return kERR;
+  if (!args.GetArg("?limit", limit, 0, 1000000)) return kERR;
+  if (!args.AllDone()) return kERR;
+
+  if (args.NOptMiss() == 0) {               // set
+    if (!Obj().SetActnLimit(name, size_t(limit)))
+      return args.Quit(string("-E: unknown action source '") + name + "'");
+    return kOK;
+  }
+
+  vector<const RlinkServer::ActnSrc*> list;
+  Obj().ActnSourceList(list);
+  for (auto p: list) {
+    if (p->fName == name) {
+      args.SetResult(int(p->fLimit.load()));
+      return kOK;
+    }
+  }
+  return args.Quit(string("-E: unknown action source '") + name + "'");
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
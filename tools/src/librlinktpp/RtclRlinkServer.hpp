@@ -1,9 +1,11 @@
 // $Id: RtclRlinkServer.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.3  add M_actnlimit()
+// 2026-10-18  1219   1.2.2  add ConnName(), fConnName
 // 2018-12-07  1078   1.2.1  use std::shared_ptr instead of boost
 // 2018-12-01  1076   1.2    use unique_ptr
 // 2015-04-04   662   1.1    add M_get, M_set; remove 'server -trace'
@@ -41,10 +43,13 @@ namespace Retro {
 
       virtual int   ClassCmdConfig(RtclArgs& args);
 
+      const std::string& ConnName() const;
+
     protected:
       int           M_server(RtclArgs& args);
       int           M_attn(RtclArgs& args);
       int           M_stats(RtclArgs& args);
+      int           M_actnlimit(RtclArgs& args);
       int           M_print(RtclArgs& args);
       int           M_dump(RtclArgs& args);
       int           M_get(RtclArgs& args);
@@ -56,6 +61,7 @@ namespace Retro {
       typedef std::list<ahdl_uptr_t> alist_t;
 
       std::shared_ptr<RlinkConnect> fspConn;
+      std::string   fConnName;              //!< name of RlinkConnect proxy
       alist_t       fAttnHdl; //!< list of attn handlers
       RtclGetList   fGets;
       RtclSetList   fSets;
@@ -0,0 +1,109 @@
+// $Id: RcallProf.cpp 1220 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1227   1.1    use Rstats and IncLogHist() for histogram
+// 2026-10-18  1220   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of class RcallProf.
+*/
+
+#include "RcallProf.hpp"
+
+#include "RosFill.hpp"
+#include "RosPrintf.hpp"
+
+using namespace std;
+
+/*!
+  \class Retro::RcallProf
+  \brief Call time profile of one handler.
+
+  Keeps number of calls, sum and maximum of the call times, and a histogram
+  with logarithmic bins, kept in an Rstats and filled with
+  Rstats::IncLogHist(): bin 0 counts calls below 2 us, bin \c n calls from
+  2^n to 2^(n+1) us, the last bin also all longer calls.
+
+  Add() is cheap and not thread safe, all calls must come from one thread.
+  Readers in other threads may see slightly inconsistent values.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Constructor
+
+RcallProf::RcallProf(const std::string& name)
+  : fName(name),
+    fNCall(0),
+    fTSum(0.),
+    fTMax(0.),
+    fHist()
+{
+  fHist.DefineLogHist(0, "HCall", "call time", "usec",
+                      kHistMaskFirst, kHistMaskLast);
+}
+
+//------------------------------------------+-----------------------------------
+//! Clear all counters
+
+void RcallProf::Reset()
+{
+  fNCall = 0;
+  fTSum  = 0.;
+  fTMax  = 0.;
+  fHist.Reset();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns lower edge of histogram bin \a ind in sec
+
+double RcallProf::BinLow(size_t ind)
+{
+  return ind == 0 ? 0. : 1.e-6 * double(uint64_t(1) << ind);
+}
+
+//------------------------------------------+-----------------------------------
+//! Print one line: name, calls, total, average and max time (in us), hist
+/*!
+  The histogram is printed up to the last non-empty bin.
+ */
+
+void RcallProf::Print(std::ostream& os) const
+{
+  double tavg = fNCall ? fTSum / double(fNCall) : 0.;
+  os << RosPrintf(fName.c_str(),"-s",16)
+     << RosPrintf(fNCall,"d",10)
+     << RosPrintf(1.e6*fTSum,"f",14,1)
+     << RosPrintf(1.e6*tavg,"f",10,2)
+     << RosPrintf(1.e6*fTMax,"f",12,1)
+     << "  |";
+  size_t nbin = kNBin;
+  while (nbin > 0 && Bin(nbin-1) == 0) nbin--;
+  for (size_t i=0; i<nbin; i++) os << " " << Bin(i);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void RcallProf::Dump(std::ostream& os, int ind, const char* text,
+                     int detail) const
+{
+  RosFill bl(ind);
+  os << bl << (text?text:"--") << "RcallProf @ " << this << endl;
+  os << bl << "  fName:           " << fName << endl;
+  os << bl << "  fNCall:          " << fNCall << endl;
+  os << bl << "  fTSum:           " << fTSum << endl;
+  os << bl << "  fTMax:           " << fTMax << endl;
+  fHist.Dump(os, ind+2, "fHist: ", detail-1);
+  return;
+}
+
+} // end namespace Retro
@@ -0,0 +1,63 @@
+// $Id: RcallProf.hpp 1220 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1227   1.1    use Rstats and IncLogHist() for histogram
+// 2026-10-18  1220   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class \c RcallProf.
+*/
+
+#ifndef included_Retro_RcallProf
+#define included_Retro_RcallProf 1
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+
+#include "Rstats.hpp"
+
+namespace Retro {
+
+  class RcallProf {
+    public:
+      static const size_t kNBin = 24;       //!< histogram bins
+      static const size_t kHistMaskFirst = 0x1;      //!< IncLogHist first mask
+      static const size_t kHistMaskLast  = 0xffffff; //!< IncLogHist last mask
+
+      explicit      RcallProf(const std::string& name = "");
+
+      const std::string&  Name() const;
+
+      void          Add(double dt);
+      void          Reset();
+
+      uint64_t      NCall() const;
+      double        TSum() const;
+      double        TMax() const;
+      uint64_t      Bin(size_t ind) const;
+      static double BinLow(size_t ind);
+      const Rstats& Hist() const;
+
+      void          Print(std::ostream& os) const;
+      void          Dump(std::ostream& os, int ind=0, const char* text=0,
+                         int detail=0) const;
+
+    protected:
+      std::string   fName;                  //!< name of call site
+      uint64_t      fNCall;                 //!< number of calls
+      double        fTSum;                  //!< sum of call times in sec
+      double        fTMax;                  //!< max call time in sec
+      Rstats        fHist;                  //!< log2 histogram of call time
+  };
+
+} // end namespace Retro
+
+#include "RcallProf.ipp"
+
+#endif
@@ -0,0 +1,80 @@
+// $Id: RcallProf.ipp 1220 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1227   1.1    use Rstats and IncLogHist() for histogram
+// 2026-10-18  1220   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation (inline) of class RcallProf.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Returns name
+
+inline const std::string& RcallProf::Name() const
+{
+  return fName;
+}
+
+//------------------------------------------+-----------------------------------
+//! Account one call which took \a dt seconds
+
+inline void RcallProf::Add(double dt)
+{
+  fNCall += 1;
+  fTSum  += dt;
+  if (dt > fTMax) fTMax = dt;
+  size_t usec = (dt > 0.) ? size_t(dt * 1.e6) : 0;
+  // IncLogHist() ignores 0, so account calls below 1 us as 1 us (bin 0)
+  fHist.IncLogHist(0, kHistMaskFirst, kHistMaskLast, usec ? usec : 1);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of calls
+
+inline uint64_t RcallProf::NCall() const
+{
+  return fNCall;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns sum of call times in sec
+
+inline double RcallProf::TSum() const
+{
+  return fTSum;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns maximal call time in sec
+
+inline double RcallProf::TMax() const
+{
+  return fTMax;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns histogram bin \a ind, see BinLow() for the bin ranges
+
+inline uint64_t RcallProf::Bin(size_t ind) const
+{
+  return ind < kNBin ? uint64_t(fHist.Value(ind)) : 0;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns histogram as Rstats, one counter per bin
+
+inline const Rstats& RcallProf::Hist() const
+{
+  return fHist;
+}
+
+} // end namespace Retro
@@ -0,0 +1,56 @@
+// $Id: RmpscQueue.hpp 1216 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1216   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class \c RmpscQueue.
+*/
+
+#ifndef included_Retro_RmpscQueue
+#define included_Retro_RmpscQueue 1
+
+#include <cstddef>
+#include <atomic>
+#include <vector>
+
+namespace Retro {
+
+  template <class T>
+  class RmpscQueue {
+    public:
+      explicit      RmpscQueue(size_t size=1024);
+
+                    RmpscQueue(const RmpscQueue&) = delete;  // noncopyable
+      RmpscQueue&   operator=(const RmpscQueue&) = delete;    // noncopyable
+
+      size_t        Capacity() const;
+
+      bool          Push(T&& obj);
+      bool          Pop(T& obj);
+      bool          Empty() const;
+      size_t        Size() const;
+
+    protected:
+      struct Cell {
+        std::atomic<size_t> fSeq;           //!< sequence number of cell
+        T           fObj;                   //!< stored object
+                    Cell();
+      };
+
+      std::vector<Cell> fCells;             //!< preallocated cells
+      size_t        fMask;                  //!< index mask (size-1)
+      std::atomic<size_t> fPushPos;         //!< next push position
+      std::atomic<size_t> fPopPos;          //!< next pop position
+  };
+
+} // end namespace Retro
+
+#include "RmpscQueue.ipp"
+
+#endif
@@ -0,0 +1,134 @@
+// $Id: RmpscQueue.ipp 1216 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1216   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation (inline) of class RmpscQueue.
+*/
+
+#include <utility>
+
+#include "Rexception.hpp"
+
+/*!
+  \class Retro::RmpscQueue
+  \brief Bounded lock-free multi-producer/single-consumer queue.
+
+  Fixed ring of preallocated cells, each cell carries a sequence number
+  which tells whether it is free for the producer of a given position or
+  filled for the consumer. Producers claim a position with a CAS on
+  fPushPos, fill the cell and publish it by updating the sequence number.
+  Push() never blocks, it returns \c false when the ring is full.
+
+  Pop() must only be called from a single thread at a time.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Constructor, \a size is rounded up to a power of 2
+
+template <class T>
+inline RmpscQueue<T>::RmpscQueue(size_t size)
+  : fCells(),
+    fMask(0),
+    fPushPos(0),
+    fPopPos(0)
+{
+  if (size == 0)
+    throw Rexception("RmpscQueue::<ctor>", "Bad args: size==0");
+  size_t nc = 1;
+  while (nc < size) nc <<= 1;
+  std::vector<Cell> cells(nc);
+  fCells.swap(cells);
+  fMask = nc - 1;
+  for (size_t i=0; i<nc; i++) fCells[i].fSeq.store(i, std::memory_order_relaxed);
+}
+
+//------------------------------------------+-----------------------------------
+//! Cell default constructor
+
+template <class T>
+inline RmpscQueue<T>::Cell::Cell()
+  : fSeq(0),
+    fObj()
+{}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of cells
+
+template <class T>
+inline size_t RmpscQueue<T>::Capacity() const
+{
+  return fCells.size();
+}
+
+//------------------------------------------+-----------------------------------
+//! Add \a obj to queue, returns false (and leaves \a obj as is) if full
+
+template <class T>
+inline bool RmpscQueue<T>::Push(T&& obj)
+{
+  size_t pos = fPushPos.load(std::memory_order_relaxed);
+  Cell* pcell;
+  while (true) {
+    pcell = &fCells[pos & fMask];
+    size_t seq = pcell->fSeq.load(std::memory_order_acquire);
+    if (seq == pos) {                       // cell free: try to claim
+      if (fPushPos.compare_exchange_weak(pos, pos+1,
+                                         std::memory_order_relaxed)) break;
+    } else if (seq < pos) {                 // cell not yet popped: full
+      return false;
+    } else {                                // other producer was faster
+      pos = fPushPos.load(std::memory_order_relaxed);
+    }
+  }
+  pcell->fObj = std::move(obj);
+  pcell->fSeq.store(pos+1, std::memory_order_release);
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Remove oldest object into \a obj, returns false if queue empty
+
+template <class T>
+inline bool RmpscQueue<T>::Pop(T& obj)
+{
+  size_t pos = fPopPos.load(std::memory_order_relaxed);
+  Cell& cell = fCells[pos & fMask];
+  if (cell.fSeq.load(std::memory_order_acquire) != pos+1) return false;
+  obj = std::move(cell.fObj);
+  cell.fObj = T();                          // release resources held by obj
+  cell.fSeq.store(pos+fCells.size(), std::memory_order_release);
+  fPopPos.store(pos+1, std::memory_order_relaxed);
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns true if queue has no published object (consumer view)
+
+template <class T>
+inline bool RmpscQueue<T>::Empty() const
+{
+  size_t pos = fPopPos.load(std::memory_order_relaxed);
+  return fCells[pos & fMask].fSeq.load(std::memory_order_acquire) != pos+1;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns approximate number of queued objects
+
+template <class T>
+inline size_t RmpscQueue<T>::Size() const
+{
+  size_t push = fPushPos.load(std::memory_order_relaxed);
+  size_t pop  = fPopPos.load(std::memory_order_relaxed);
+  return push > pop ? push - pop : 0;
+}
+
+} // end namespace Retro
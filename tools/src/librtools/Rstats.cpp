@@ -1,9 +1,10 @@
 // $Id: Rstats.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.0.7  add DefineLogHist()
 // 2019-06-07  1160   1.0.6  add Reset(); drop operator-=() and operator*=()
 // 2018-12-18  1089   1.0.5  use c++ style casts
 // 2017-02-04   865   1.0.4  add NameMaxLength(); Print(): add counter name
@@ -108,6 +109,31 @@ void Rstats::Reset()
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Define the bins of a log2 histogram filled with IncLogHist().
+/*!
+  Defines counters starting at \a ind, one for each bin, the \a maskfirst
+  and \a masklast arguments must be the same as used with IncLogHist().
+  The bin names are \a name plus the upper bin bound, the last bin, which
+  also counts all larger values, gets the suffix \c Max.
+ */
+
+void Rstats::DefineLogHist(size_t ind, const std::string& name,
+                           const std::string& text, const std::string& unit,
+                           size_t maskfirst, size_t masklast)
+{
+  for (size_t mask=maskfirst; ; mask = (mask<<1) | 0x1) {
+    string bnd = to_string(mask+1);
+    if (mask < masklast) {
+      Define(ind++, name + bnd, text + " < " + bnd + " " + unit);
+    } else {
+      bnd = to_string((mask>>1)+1);
+      Define(ind++, name + "Max", text + " >= " + bnd + " " + unit);
+      return;
+    }
+  }
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -1,9 +1,10 @@
 // $Id: Rstats.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2011-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.0.4  add DefineLogHist()
 // 2019-06-07  1160   1.0.3  add Reset(); drop operator-=() and operator*=()
 // 2017-02-04   865   1.0.2  add NameMaxLength(); Dump(): add detail arg
 // 2017-02-18   851   1.0.1  add IncLogHist; fix + and * operator definition
@@ -39,6 +40,10 @@ namespace Retro {
 
       void          Reset();
 
+      void          DefineLogHist(size_t ind, const std::string& name,
+                                  const std::string& text,
+                                  const std::string& unit,
+                                  size_t maskfirst, size_t masklast);
       void          IncLogHist(size_t ind, size_t maskfirst,
                                size_t masklast, size_t val);
 
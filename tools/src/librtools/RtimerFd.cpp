@@ -1,9 +1,10 @@
 // $Id: RtimerFd.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1215   1.2    add SetAbsolute(); SetRelative(): fix dt check
 // 2019-06-08  1161   1.1    derive from Rfd, inherit IsOpen,Close,Fd
 // 2017-02-18   852   1.0    Initial version
 // 2013-01-11   473   0.1    First draft
@@ -67,7 +68,7 @@ void RtimerFd::SetRelative(const Rtime& dt)
   if (!IsOpen())
     throw Rexception(fCnam+"SetRelative()", "bad state: not open");
 
-  if (dt.Sec() <= 0 || dt.NSec() <= 0)
+  if (dt.Sec() < 0 || (dt.Sec() == 0 && dt.NSec() <= 0))
     throw Rexception(fCnam+"SetRelative()", "bad value: dt zero or negative ");
 
   struct itimerspec itspec;
@@ -81,6 +82,31 @@ void RtimerFd::SetRelative(const Rtime& dt)
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Arm timer for an absolute time of the clock given in Open()
+/*!
+  A time in the past is accepted, the timer expires immediately.
+ */
+
+void RtimerFd::SetAbsolute(const Rtime& tabs)
+{
+  if (!IsOpen())
+    throw Rexception(fCnam+"SetAbsolute()", "bad state: not open");
+
+  if (tabs.IsZero() || tabs.IsNegative())
+    throw Rexception(fCnam+"SetAbsolute()", "bad value: tabs zero or negative");
+
+  struct itimerspec itspec;
+  itspec.it_interval.tv_sec   = 0;
+  itspec.it_interval.tv_nsec  = 0;
+  itspec.it_value             = tabs.Timespec();
+
+  if (::timerfd_settime(fFd, TFD_TIMER_ABSTIME, &itspec, nullptr) < 0)
+    throw Rexception(fCnam+"SetAbsolute()", 
+                     "timerfd_settime() failed: ", errno);
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -0,0 +1,274 @@
+// $Id: RtimerWheel.cpp 1215 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1215   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of class RtimerWheel.
+*/
+
+#include <math.h>
+
+#include <limits>
+
+#include "RtimerWheel.hpp"
+
+#include "RosFill.hpp"
+#include "Rexception.hpp"
+
+using namespace std;
+
+/*!
+  \class Retro::RtimerWheel
+  \brief Hierarchical timer wheel.
+
+  Holds any number of one-shot timers, each with an absolute deadline on
+  the \c CLOCK_MONOTONIC clock and a handler. The wheel is passive, the
+  owner arms a single timer for NextDeadline() and calls Expire() when it
+  fires. Expire() calls the handlers of all due timers.
+
+  Deadlines are rounded up to the tick length given in the constructor,
+  so all timers due in the same tick are handled in one Expire() call.
+  Timers are kept in kNLevel levels of kNSlot slots, level \c n has a slot
+  width of kNSlot^n ticks. Add() and Cancel() are O(1), timers of the
+  higher levels are moved to lower levels when their slot becomes current.
+  Cancel() only removes the timer from the table, the id left in the slot
+  is dropped when the slot is processed.
+
+  The class is not thread safe, the owner must serialize all calls.
+  Handlers may call Add() and Cancel().
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Constructor
+/*!
+  \param tick  tick length in sec, defines timer resolution
+ */
+
+RtimerWheel::RtimerWheel(double tick)
+  : fTick(tick),
+    fTime0(CLOCK_MONOTONIC),
+    fNow(0),
+    fIdLast(kIdNone),
+    fTimers(),
+    fSlots(kNLevel*kNSlot),
+    fStats()
+{
+  if (tick <= 0.)
+    throw Rexception("RtimerWheel::<ctor>", "Bad args: tick <= 0");
+
+  fStats.Define(kStatNAdd    , "NAdd"    , "timers added");
+  fStats.Define(kStatNCancel , "NCancel" , "timers canceled");
+  fStats.Define(kStatNFire   , "NFire"   , "timer handlers called");
+  fStats.Define(kStatNExpire , "NExpire" , "Expire() calls");
+  fStats.Define(kStatNTick   , "NTick"   , "ticks with due timers");
+  fStats.Define(kStatNCascade, "NCascade", "timers moved to lower level");
+}
+
+//------------------------------------------+-----------------------------------
+//! Add a timer, returns the timer id.
+/*!
+  \param deadline  absolute \c CLOCK_MONOTONIC time, a deadline in the past
+                   is handled in the next Expire() call
+  \param hdl       handler, called once by Expire()
+ */
+
+RtimerWheel::id_t RtimerWheel::Add(const Rtime& deadline, timerhdl_t&& hdl)
+{
+  if (fTimers.empty()) {                    // idle wheel: drop stale ids
+    for (auto& o: fSlots) o.clear();        //   and catch up with clock
+    uint64_t now = TimeToTick(Rtime(CLOCK_MONOTONIC), false);
+    if (now > fNow) fNow = now;
+  }
+
+  uint64_t expire = TimeToTick(deadline, true);
+  if (expire < fNow) expire = fNow;
+
+  id_t id = ++fIdLast;
+  fTimers.emplace(id, Timer{expire, move(hdl)});
+  Place(id, expire);
+  fStats.Inc(kStatNAdd);
+  return id;
+}
+
+//------------------------------------------+-----------------------------------
+//! Cancel timer \a id, returns false if already expired or canceled
+
+bool RtimerWheel::Cancel(id_t id)
+{
+  if (fTimers.erase(id) == 0) return false;
+  fStats.Inc(kStatNCancel);
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Get time of the next wheel tick which has work, false if none pending
+
+bool RtimerWheel::NextDeadline(Rtime& deadline) const
+{
+  if (fTimers.empty()) return false;
+  deadline = TickToTime(NextTick());
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call handlers of all timers due at time \a now, returns number called
+/*!
+  When a handler throws the remaining timers of the tick stay pending and
+  are handled in the next Expire() call.
+ */
+
+size_t RtimerWheel::Expire(const Rtime& now)
+{
+  fStats.Inc(kStatNExpire);
+  uint64_t tnow = TimeToTick(now, false);
+  size_t nfire = 0;
+
+  while (!fTimers.empty()) {
+    uint64_t tick = NextTick();
+    if (tick > tnow) break;
+
+    fNow = tick;
+    for (int level=kNLevel-1; level>0; level--) {
+      uint64_t lmask = (uint64_t(1) << (kSlotBits*level)) - 1;
+      if ((tick & lmask) == 0) Cascade(level, tick);
+    }
+
+    slot_t fire;
+    fire.swap(fSlots[tick & kSlotMask]);
+    fNow = tick + 1;                        // Add() in handlers -> next tick
+
+    bool hit = false;
+    for (size_t i=0; i<fire.size(); i++) {
+      auto it = fTimers.find(fire[i]);
+      if (it == fTimers.end()) continue;    // canceled
+      timerhdl_t hdl = move(it->second.fHandler);
+      fTimers.erase(it);
+      fStats.Inc(kStatNFire);
+      nfire += 1;
+      hit = true;
+      try {
+        hdl();
+      } catch (...) {
+        for (size_t j=i+1; j<fire.size(); j++) {
+          auto itj = fTimers.find(fire[j]);
+          if (itj != fTimers.end()) Place(fire[j], itj->second.fExpire=fNow);
+        }
+        throw;
+      }
+    }
+    if (hit) fStats.Inc(kStatNTick);
+  }
+
+  if (fNow <= tnow) fNow = tnow + 1;        // nothing in between: skip
+  return nfire;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void RtimerWheel::Dump(std::ostream& os, int ind, const char* text,
+                       int detail) const
+{
+  RosFill bl(ind);
+  os << bl << (text?text:"--") << "RtimerWheel @ " << this << endl;
+  os << bl << "  fTick:           " << fTick << endl;
+  os << bl << "  fTime0:          " << fTime0 << endl;
+  os << bl << "  fNow:            " << fNow << endl;
+  os << bl << "  fIdLast:         " << fIdLast << endl;
+  os << bl << "  fTimers.size:    " << fTimers.size() << endl;
+  fStats.Dump(os, ind+2, "fStats: ", detail-1);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Convert time to tick number, rounds up or down
+
+uint64_t RtimerWheel::TimeToTick(const Rtime& time, bool roundup) const
+{
+  double dt = double(time - fTime0) / fTick;
+  if (dt <= 0.) return 0;
+  return uint64_t(roundup ? ceil(dt - 1.e-3) : floor(dt + 1.e-3));
+}
+
+//------------------------------------------+-----------------------------------
+//! Convert tick number to time
+
+Rtime RtimerWheel::TickToTime(uint64_t tick) const
+{
+  return fTime0 + Rtime(double(tick) * fTick);
+}
+
+//------------------------------------------+-----------------------------------
+//! Put timer \a id with expire tick \a expire (>= fNow) into its slot
+/*!
+  The level is choosen such that the slot is processed before \a expire.
+  Timers beyond the range of the top level are put into the last slot in
+  range and are placed again when that slot is cascaded.
+ */
+
+void RtimerWheel::Place(id_t id, uint64_t expire)
+{
+  uint64_t delta = expire - fNow;
+  int level = 0;
+  while (level < kNLevel-1 && delta >= (kNSlot << (kSlotBits*level))) {
+    level += 1;
+  }
+  uint64_t range = uint64_t(1) << (kSlotBits*kNLevel);
+  if (delta >= range) expire = fNow + range - 1;
+
+  size_t islot = (expire >> (kSlotBits*level)) & kSlotMask;
+  fSlots[level*kNSlot + islot].push_back(id);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Move timers of the current slot of \a level to lower levels
+
+void RtimerWheel::Cascade(int level, uint64_t tick)
+{
+  size_t islot = (tick >> (kSlotBits*level)) & kSlotMask;
+  slot_t ids;
+  ids.swap(fSlots[level*kNSlot + islot]);
+  for (auto id: ids) {
+    auto it = fTimers.find(id);
+    if (it == fTimers.end()) continue;      // canceled
+    Place(id, it->second.fExpire);
+    fStats.Inc(kStatNCascade);
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns the first tick >= fNow which has a non-empty slot to process
+/*!
+  For level 0 this is the tick of the slot, for higher levels the tick at
+  which the slot is cascaded.
+ */
+
+uint64_t RtimerWheel::NextTick() const
+{
+  uint64_t best = numeric_limits<uint64_t>::max();
+  for (int level=0; level<kNLevel; level++) {
+    int shift = kSlotBits*level;
+    uint64_t first = (fNow + (uint64_t(1) << shift) - 1) >> shift;
+    if ((first << shift) >= best) break;
+    for (uint64_t m=first; m<first+kNSlot; m++) {
+      if ((m << shift) >= best) break;
+      if (!fSlots[level*kNSlot + (m & kSlotMask)].empty()) {
+        best = m << shift;
+        break;
+      }
+    }
+  }
+  return best;
+}
+
+} // end namespace Retro
@@ -0,0 +1,100 @@
+// $Id: RtimerWheel.hpp 1215 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1227   1.0.1  remove unused fFire
+// 2026-10-18  1215   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class \c RtimerWheel.
+*/
+
+#ifndef included_Retro_RtimerWheel
+#define included_Retro_RtimerWheel 1
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <ostream>
+
+#include "Rtime.hpp"
+#include "Rstats.hpp"
+
+namespace Retro {
+
+  class RtimerWheel {
+    public:
+      typedef uint64_t               id_t;
+      typedef std::function<void()>  timerhdl_t;
+
+      static const id_t kIdNone = 0;       //!< id never returned by Add()
+
+      explicit      RtimerWheel(double tick=0.001);
+
+                    RtimerWheel(const RtimerWheel&) = delete;  // noncopyable
+      RtimerWheel&  operator=(const RtimerWheel&) = delete;    // noncopyable
+
+      double        Tick() const;
+
+      id_t          Add(const Rtime& deadline, timerhdl_t&& hdl);
+      bool          Cancel(id_t id);
+      bool          IsPending(id_t id) const;
+      size_t        Size() const;
+
+      bool          NextDeadline(Rtime& deadline) const;
+      size_t        Expire(const Rtime& now);
+
+      Rstats&       Stats();
+      void          Dump(std::ostream& os, int ind=0, const char* text=0,
+                         int detail=0) const;
+
+    // statistics counter indices
+      enum stats {
+        kStatNAdd = 0,                      //!< timers added
+        kStatNCancel,                       //!< timers canceled
+        kStatNFire,                         //!< timer handlers called
+        kStatNExpire,                       //!< Expire() calls
+        kStatNTick,                         //!< ticks with due timers
+        kStatNCascade,                      //!< timers moved to lower level
+        kDimStat
+      };
+
+    protected:
+      static const int      kNLevel   = 4;  //!< number of wheel levels
+      static const int      kSlotBits = 6;  //!< log2 of slots per level
+      static const uint64_t kNSlot    = uint64_t(1)<<kSlotBits;
+      static const uint64_t kSlotMask = kNSlot-1;
+
+      struct Timer {
+        uint64_t    fExpire;                //!< expire tick
+        timerhdl_t  fHandler;               //!< handler
+      };
+
+      typedef std::vector<id_t> slot_t;
+
+      uint64_t      TimeToTick(const Rtime& time, bool roundup) const;
+      Rtime         TickToTime(uint64_t tick) const;
+      void          Place(id_t id, uint64_t expire);
+      void          Cascade(int level, uint64_t tick);
+      uint64_t      NextTick() const;
+
+    protected:
+      double        fTick;                  //!< tick length in sec
+      Rtime         fTime0;                 //!< time of tick 0
+      uint64_t      fNow;                   //!< next tick to be processed
+      id_t          fIdLast;                //!< last id handed out
+      std::unordered_map<id_t,Timer> fTimers;  //!< active timers
+      std::vector<slot_t> fSlots;           //!< slots, kNSlot per level
+      Rstats        fStats;                 //!< statistics
+  };
+
+} // end namespace Retro
+
+#include "RtimerWheel.ipp"
+
+#endif
@@ -0,0 +1,49 @@
+// $Id: RtimerWheel.ipp 1215 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1215   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation (inline) of class RtimerWheel.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Returns tick length in sec
+
+inline double RtimerWheel::Tick() const
+{
+  return fTick;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns true if timer \a id is still pending
+
+inline bool RtimerWheel::IsPending(id_t id) const
+{
+  return fTimers.find(id) != fTimers.end();
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of pending timers
+
+inline size_t RtimerWheel::Size() const
+{
+  return fTimers.size();
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline Rstats& RtimerWheel::Stats()
+{
+  return fStats;
+}
+
+} // end namespace Retro
@@ -0,0 +1,242 @@
+// $Id: RworkerPool.cpp 1214 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1214   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of class RworkerPool.
+*/
+
+#include "RworkerPool.hpp"
+
+#include "RosFill.hpp"
+#include "RosPrintf.hpp"
+#include "Rtools.hpp"
+
+using namespace std;
+
+/*!
+  \class Retro::RworkerPool
+  \brief Small thread pool for blocking I/O with an eventfd completion queue.
+
+  Jobs consist of a \c work function, which is called by one of the worker
+  threads, and an optional \c done function. The done functions are queued
+  when the work is finished and the event returned by Fd() is signaled.
+  The owner of the pool, usually an event loop, calls DoCompletions() when
+  the fd is readable, so all done functions are called in its thread.
+
+  The worker threads are started on the first Submit(). With 0 worker
+  threads Submit() calls work and done directly, which is equivalent to
+  the plain synchronous execution.
+
+  Jobs can be executed in any order, a user which requires ordering must
+  ensure that only one of its jobs is pending at a time.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Constructor
+
+RworkerPool::RworkerPool(size_t nthread)
+  : fNThread(nthread),
+    fMutex(),
+    fCondWork(),
+    fCondIdle(),
+    fWorkQueue(),
+    fDoneQueue(),
+    fThreads(),
+    fNActive(0),
+    fStop(false),
+    fDoneEvent("RworkerPool::fDoneEvent."),
+    fStats()
+{
+  fStats.Define(kStatNSubmit , "NSubmit" , "jobs submitted");
+  fStats.Define(kStatNSync   , "NSync"   , "jobs done synchronously");
+  fStats.Define(kStatNDone   , "NDone"   , "completions called");
+  fStats.Define(kStatNWaitMax, "NWaitMax", "max jobs waiting");
+}
+
+//------------------------------------------+-----------------------------------
+//! Destructor, waits for all started jobs, pending completions are dropped
+
+RworkerPool::~RworkerPool()
+{
+  Rtools::Catch2Cerr(__func__, [this](){ Stop(); } );
+}
+
+//------------------------------------------+-----------------------------------
+//! Set number of worker threads, running workers are stopped after Drain()
+
+void RworkerPool::SetNThread(size_t nthread)
+{
+  Drain();
+  Stop();
+  fNThread = nthread;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Queue a job.
+/*!
+  \param work  function called in a worker thread
+  \param done  function called by DoCompletions() after work finished,
+               can be an empty function
+ */
+
+void RworkerPool::Submit(work_t&& work, done_t&& done)
+{
+  if (fNThread == 0) {                      // synchronous mode
+    fStats.Inc(kStatNSync);
+    work();
+    if (done) done();
+    return;
+  }
+
+  {
+    lock_guard<mutex> lock(fMutex);
+    if (fThreads.empty()) Start();
+    fStats.Inc(kStatNSubmit);
+    fWorkQueue.push_back(Job{move(work), move(done)});
+    if (double(fWorkQueue.size()) > fStats.Value(kStatNWaitMax))
+      fStats.Set(kStatNWaitMax, double(fWorkQueue.size()));
+  }
+  fCondWork.notify_one();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Call all queued completions, returns number of completions called.
+/*!
+  Must be called when Fd() is readable, the completions are called in the
+  thread of the caller, without fMutex held. When a completion throws, the
+  event is re-signaled in case further completions are queued.
+ */
+
+size_t RworkerPool::DoCompletions()
+{
+  fDoneEvent.Wait();
+
+  size_t ndone = 0;
+  while (true) {
+    done_t done;
+    {
+      lock_guard<mutex> lock(fMutex);
+      if (fDoneQueue.empty()) break;
+      done = move(fDoneQueue.front());
+      fDoneQueue.pop_front();
+    }
+    fStats.Inc(kStatNDone);
+    ndone += 1;
+    try {
+      done();
+    } catch (...) {
+      lock_guard<mutex> lock(fMutex);
+      if (!fDoneQueue.empty()) fDoneEvent.Signal();
+      throw;
+    }
+  }
+  return ndone;
+}
+
+//------------------------------------------+-----------------------------------
+//! Wait until all submitted work is finished, completions are not called
+
+void RworkerPool::Drain()
+{
+  unique_lock<mutex> lock(fMutex);
+  fCondIdle.wait(lock, [this](){ return fWorkQueue.empty() && fNActive==0; });
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of jobs queued or worked on
+
+size_t RworkerPool::NPending() const
+{
+  lock_guard<mutex> lock(fMutex);
+  return fWorkQueue.size() + fNActive;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void RworkerPool::Dump(std::ostream& os, int ind, const char* text,
+                       int detail) const
+{
+  RosFill bl(ind);
+  os << bl << (text?text:"--") << "RworkerPool @ " << this << endl;
+
+  lock_guard<mutex> lock(fMutex);
+  os << bl << "  fNThread:        " << fNThread << endl;
+  os << bl << "  fThreads.size:   " << fThreads.size() << endl;
+  os << bl << "  fWorkQueue.size: " << fWorkQueue.size() << endl;
+  os << bl << "  fDoneQueue.size: " << fDoneQueue.size() << endl;
+  os << bl << "  fNActive:        " << fNActive << endl;
+  os << bl << "  fDoneEvent:      " << fDoneEvent.Fd() << endl;
+  fStats.Dump(os, ind+2, "fStats: ", detail-1);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Start worker threads, fMutex must be held
+
+void RworkerPool::Start()
+{
+  fStop = false;
+  for (size_t i=0; i<fNThread; i++) {
+    fThreads.emplace_back(&RworkerPool::Worker, this);
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Stop and join worker threads, jobs not yet started stay queued
+
+void RworkerPool::Stop()
+{
+  {
+    lock_guard<mutex> lock(fMutex);
+    if (fThreads.empty()) return;
+    fStop = true;
+  }
+  fCondWork.notify_all();
+  for (auto& o: fThreads) o.join();
+  fThreads.clear();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Worker thread main loop
+
+void RworkerPool::Worker()
+{
+  unique_lock<mutex> lock(fMutex);
+  while (true) {
+    fCondWork.wait(lock, [this](){ return fStop || !fWorkQueue.empty(); });
+    if (fStop) break;
+
+    Job job(move(fWorkQueue.front()));
+    fWorkQueue.pop_front();
+    fNActive += 1;
+
+    lock.unlock();
+    Rtools::Catch2Cerr(__func__, job.fWork);
+    lock.lock();
+
+    fNActive -= 1;
+    if (job.fDone) {
+      fDoneQueue.push_back(move(job.fDone));
+      fDoneEvent.Signal();
+    }
+    fCondIdle.notify_all();
+  }
+  return;
+}
+
+} // end namespace Retro
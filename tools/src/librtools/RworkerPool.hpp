@@ -0,0 +1,93 @@
+// $Id: RworkerPool.hpp 1214 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1214   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class \c RworkerPool.
+*/
+
+#ifndef included_Retro_RworkerPool
+#define included_Retro_RworkerPool 1
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <ostream>
+
+#include "ReventFd.hpp"
+#include "Rstats.hpp"
+
+namespace Retro {
+
+  class RworkerPool {
+    public:
+      typedef std::function<void()>  work_t;
+      typedef std::function<void()>  done_t;
+
+      explicit      RworkerPool(size_t nthread=2);
+                   ~RworkerPool();
+
+                    RworkerPool(const RworkerPool&) = delete;  // noncopyable
+      RworkerPool&  operator=(const RworkerPool&) = delete;    // noncopyable
+
+      void          SetNThread(size_t nthread);
+      size_t        NThread() const;
+
+      void          Submit(work_t&& work, done_t&& done);
+      size_t        DoCompletions();
+      void          Drain();
+      size_t        NPending() const;
+      int           Fd() const;
+
+      Rstats&       Stats();
+      void          Dump(std::ostream& os, int ind=0, const char* text=0,
+                         int detail=0) const;
+
+    // statistics counter indices
+      enum stats {
+        kStatNSubmit = 0,                   //!< jobs submitted
+        kStatNSync,                         //!< jobs done synchronously
+        kStatNDone,                         //!< completions called
+        kStatNWaitMax,                      //!< max jobs waiting
+        kDimStat
+      };
+
+    protected:
+      struct Job {
+        work_t      fWork;                  //!< work, called by worker
+        done_t      fDone;                  //!< completion, by DoCompletions
+      };
+
+      void          Start();
+      void          Stop();
+      void          Worker();
+
+    protected:
+      size_t        fNThread;               //!< number of worker threads
+      mutable std::mutex fMutex;            //!< protects queues and state
+      std::condition_variable fCondWork;    //!< work queued or stop request
+      std::condition_variable fCondIdle;    //!< a job finished
+      std::deque<Job> fWorkQueue;           //!< jobs not yet started
+      std::deque<done_t> fDoneQueue;        //!< completions not yet called
+      std::vector<std::thread> fThreads;    //!< worker threads
+      size_t        fNActive;               //!< jobs currently worked on
+      bool          fStop;                  //!< stop request for workers
+      ReventFd      fDoneEvent;             //!< signals pending completions
+      Rstats        fStats;                 //!< statistics
+  };
+
+} // end namespace Retro
+
+#include "RworkerPool.ipp"
+
+#endif
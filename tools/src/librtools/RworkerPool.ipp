@@ -0,0 +1,41 @@
+// $Id: RworkerPool.ipp 1214 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1214   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation (inline) of class RworkerPool.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Returns number of worker threads (0 means synchronous execution)
+
+inline size_t RworkerPool::NThread() const
+{
+  return fNThread;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns fd of the event signaling pending completions
+
+inline int RworkerPool::Fd() const
+{
+  return fDoneEvent.Fd();
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline Rstats& RworkerPool::Stats()
+{
+  return fStats;
+}
+
+} // end namespace Retro
@@ -1,9 +1,11 @@
 // $Id: Rw11.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.2    add fspDiskCache
+// 2026-10-18  1220   1.1.6  name attn handler call profile
 // 2019-02-23  1114   1.1.5  use std::bind instead of lambda
 // 2018-12-19  1090   1.1.4  use RosPrintf(bool)
 // 2018-12-15  1082   1.1.3  use lambda instead of boost::bind
@@ -49,7 +51,8 @@ const int      Rw11::kLam;
 Rw11::Rw11()
   : fspServ(),
     fNCpu(0),
-    fStarted(false)
+    fStarted(false),
+    fspDiskCache(make_shared<Rw11VirtDiskCache>())
 {}
 
 //------------------------------------------+-----------------------------------
@@ -65,7 +68,8 @@ void Rw11::SetServer(const std::shared_ptr<RlinkServer>& spserv)
 {
   fspServ = spserv;
   fspServ->AddAttnHandler(bind(&Rw11::AttnHandler, this, _1), 
-                          uint16_t(1)<<kLam, this);
+                          uint16_t(1)<<kLam, this, nullptr,
+                          RlinkServer::kPrioBulk, "rw11");
   return;
 }
 
@@ -114,7 +118,7 @@ void Rw11::Start()
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
-void Rw11::Dump(std::ostream& os, int ind, const char* text, int /*detail*/) const
+void Rw11::Dump(std::ostream& os, int ind, const char* text, int detail) const
 {
   RosFill bl(ind);
   os << bl << (text?text:"--") << "Rw11 @ " << this << endl;
@@ -125,6 +129,7 @@ void Rw11::Dump(std::ostream& os, int ind, const char* text, int /*detail*/) con
   for (auto& o: fspCpu) os << o.get() << " ";
   os << endl;
   os << bl << "  fStarted:        " << RosPrintf(fStarted) << endl;
+  fspDiskCache->Dump(os, ind+2, "fspDiskCache: ", detail);
   return;
 }
 
@@ -1,9 +1,10 @@
 // $Id: Rw11.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.2    add fspDiskCache, DiskCache()
 // 2018-12-16  1084   1.1.3  use =delete for noncopyable instead of boost
 // 2018-12-07  1078   1.1.2  use std::shared_ptr instead of boost
 // 2017-04-07   868   1.1.1  Dump(): add detail arg
@@ -24,6 +25,8 @@
 
 #include "librlink/RlinkServer.hpp"
 
+#include "Rw11VirtDiskCache.hpp"
+
 namespace Retro {
 
   class Rw11Cpu;                            // forw decl to avoid circular incl
@@ -47,6 +50,9 @@ namespace Retro {
       size_t        NCpu() const;
       Rw11Cpu&      Cpu(size_t ind) const;
 
+      const std::shared_ptr<Rw11VirtDiskCache>& DiskCacheSPtr() const;
+      Rw11VirtDiskCache& DiskCache() const;
+
       void          Start();
       bool          IsStarted() const;
 
@@ -64,6 +70,7 @@ namespace Retro {
       size_t        fNCpu;
       std::shared_ptr<Rw11Cpu>  fspCpu[4];
       bool          fStarted;               //!< true if Start() called
+      std::shared_ptr<Rw11VirtDiskCache> fspDiskCache; //!< shared disk cache
   };
   
 } // end namespace Retro
@@ -1,9 +1,10 @@
 // $Id: Rw11.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.1    add DiskCache(),DiskCacheSPtr()
 // 2018-12-07  1078   1.0.1  use std::shared_ptr instead of boost
 // 2013-03-06   495   1.0    Initial version
 // 2013-01-27   478   0.1    First draft
@@ -51,6 +52,22 @@ inline RlogFile& Rw11::LogFile() const
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline const std::shared_ptr<Rw11VirtDiskCache>& Rw11::DiskCacheSPtr() const
+{
+  return fspDiskCache;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline Rw11VirtDiskCache& Rw11::DiskCache() const
+{
+  return *fspDiskCache;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline size_t Rw11::NCpu() const
 {
   return fNCpu;
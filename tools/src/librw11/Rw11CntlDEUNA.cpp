@@ -1,9 +1,14 @@
 // $Id: Rw11CntlDEUNA.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   0.5.15 ring sources limited to 1, resume refused handler
+// 2026-10-18  1221   0.5.14 use action sources for ring handlers
+// 2026-10-18  1220   0.5.13 name call profiles of attn and ring handlers
+// 2026-10-18  1217   0.5.12 use kPrioNet priority class
+// 2026-10-18  1215   0.5.11 use RlinkServer timer wheel for rx poll timer
 // 2019-06-15  1164   0.5.10 adapt to new RtimerFd API
 // 2019-04-19  1133   0.5.9  use ExecWibr()
 // 2019-02-23  1114   0.5.8  use std::bind instead of lambda
@@ -242,7 +247,11 @@ Rw11CntlDEUNA::Rw11CntlDEUNA()
     fRxDscNxt{},
     fRxPollTime(0.01),
     fRxQueLimit(1000),
-    fRxPollTimer("Rw11CntlDEUNA::fRxPollTimer."),
+    fRxPollTimer(RtimerWheel::kIdNone),
+    fpSrcTxRing(nullptr),
+    fpSrcRxRing(nullptr),
+    fTxRingDeferred(false),
+    fRxRingDeferred(false),
     fRxBufQueue(),
     fRxBufCurr(),
     fRxBufOffset(0)
@@ -315,7 +324,11 @@ Rw11CntlDEUNA::Rw11CntlDEUNA()
 //! Destructor
 
 Rw11CntlDEUNA::~Rw11CntlDEUNA()
-{}
+{
+  if (fRxPollTimer != RtimerWheel::kIdNone)
+    Rtools::Catch2Cerr(__func__, 
+                       [this](){ Server().CancelTimer(fRxPollTimer); } );
+}
 
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
@@ -349,9 +362,14 @@ void Rw11CntlDEUNA::Start()
   fPr1State = kSTATE_READY;
   UnitSetupAll();
 
-  // add attn handler
+  // add attn handler, get action sources for ring handlers
   Server().AddAttnHandler(bind(&Rw11CntlDEUNA::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, nullptr,
+                          RlinkServer::kPrioNet, Name());
+  fpSrcTxRing = Server().ActnSource(Name() + ".txring", 1,
+                                    [this](){ ResumeTxRing(); });
+  fpSrcRxRing = Server().ActnSource(Name() + ".rxring", 1,
+                                    [this](){ ResumeRxRing(); });
   fStarted = true;
 
   return;
@@ -655,7 +673,9 @@ void Rw11CntlDEUNA::Dump(std::ostream& os, int ind, const char* text,
 
   os << bl << "  fRxPollTime:      " << fRxPollTime << endl;
   os << bl << "  fRxQueLimit:      " << RosPrintf(fRxQueLimit,"d", 4)  << endl;
-  os << bl << "  fRxPollTimer:     " << fRxPollTimer.Fd()  << endl;
+  os << bl << "  fRxPollTimer:     " << fRxPollTimer << endl;
+  os << bl << "  fTxRingDeferred:  " << RosPrintf(fTxRingDeferred) << endl;
+  os << bl << "  fRxRingDeferred:  " << RosPrintf(fRxRingDeferred) << endl;
   size_t rxquesize = fRxBufQueue.size();
   os << bl << "  fRxBufQueue.size: " << RosPrintf(rxquesize,"d", 4) << endl;
   for (size_t i=0; i<rxquesize; i++) {
@@ -998,13 +1018,6 @@ void Rw11CntlDEUNA::SetRunning(bool run)
 {
   if (fRunning == run) return;
   if (run) {                                // start
-    if (! fRxPollTimer.IsOpen()) {            // start poll timer if needed 
-      fRxPollTimer.Open();
-      Server().AddPollHandler([this](const pollfd& pfd)
-                                { return RxPollHandler(pfd); }, 
-                              fRxPollTimer.Fd(), POLLIN);
-    }
-
     fRunning  = true;
     fPr1State = kSTATE_RUN;
     fTxRingIndex = 0;
@@ -1392,7 +1405,7 @@ void Rw11CntlDEUNA::StartTxRing(const uint16_t dsccur[4],
   
   if (fTxDscCurPC[2] & kTXR2_M_OWN) {       // pending tx frames ?
     fTxRingState = kStateTxBusy;
-    Server().QueueAction([this](){ return TxRingHandler(); });
+    QueueTxRing();
   }
   return;
 }
@@ -1435,16 +1448,67 @@ void Rw11CntlDEUNA::StartRxRing(const uint16_t dsccur[4],
   if (!fRxBufQueue.empty() &&               // if pending rx frames
       fRxDscCur[2] & kRXR2_M_OWN) {         // and buffer available
     fRxRingState = kStateRxBusy;
-    Server().QueueAction([this](){ return RxRingHandler(); });
+    QueueRxRing();
   }
   return;
 }
 
+//--------------------------------------+-----------------------------------
+//! Queue TxRingHandler, remember when action source refused it
+/*!
+  The ring state stays busy when the action is refused, so no new start
+  is accepted, and ResumeTxRing() queues the handler later.
+ */
+
+void Rw11CntlDEUNA::QueueTxRing()
+{
+  fTxRingDeferred = !Server().QueueAction([this](){ return TxRingHandler(); },
+                                          RlinkServer::kPrioNet, fpSrcTxRing);
+  return;
+}
+
+//--------------------------------------+-----------------------------------
+//! Queue RxRingHandler, remember when action source refused it
+
+void Rw11CntlDEUNA::QueueRxRing()
+{
+  fRxRingDeferred = !Server().QueueAction([this](){ return RxRingHandler(); },
+                                          RlinkServer::kPrioNet, fpSrcRxRing);
+  return;
+}
+
+//--------------------------------------+-----------------------------------
+//! Resume handler of action source txring, called from server thread
+
+void Rw11CntlDEUNA::ResumeTxRing()
+{
+  lock_guard<RlinkConnect> lock(Connect());
+  if (!fTxRingDeferred) return;
+  fTxRingDeferred = false;
+  if (fTxRingState == kStateTxBusy) QueueTxRing(); // not stopped meanwhile
+  return;
+}
+
+//--------------------------------------+-----------------------------------
+//! Resume handler of action source rxring, called from server thread
+
+void Rw11CntlDEUNA::ResumeRxRing()
+{
+  lock_guard<RlinkConnect> lock(Connect());
+  if (!fRxRingDeferred) return;
+  fRxRingDeferred = false;
+  if (fRxRingState == kStateRxBusy) QueueRxRing(); // not stopped meanwhile
+  return;
+}
+
 //--------------------------------------+-----------------------------------
 //! FIXME_docs
 void Rw11CntlDEUNA::StopRxRing()
 {
-  if (fRxRingState == kStateRxPoll) fRxPollTimer.Cancel();
+  if (fRxRingState == kStateRxPoll) {
+    Server().CancelTimer(fRxPollTimer);
+    fRxPollTimer = RtimerWheel::kIdNone;
+  }
   fRxRingState = kStateRxIdle;
   return;
 }
@@ -1672,7 +1736,8 @@ int Rw11CntlDEUNA::RxRingHandler()
   // now decide whether to idle, continue, or poll
   if (fRxBufQueue.empty()) return 0;        // quit if nothing to do
   if (!(fRxDscCur[2] & kRXR2_M_OWN)) {      // no free buffer
-    fRxPollTimer.SetRelative(fRxPollTime);
+    fRxPollTimer = Server().AddTimerRelative(fRxPollTime,
+                             bind(&Rw11CntlDEUNA::RxPollHandler, this));
     fRxRingState = kStateRxPoll;              // activate timer
     return 0;
   }
@@ -1683,20 +1748,16 @@ int Rw11CntlDEUNA::RxRingHandler()
 
 //--------------------------------------+-----------------------------------
 //! FIXME_docs
-int Rw11CntlDEUNA::RxPollHandler(const pollfd& pfd)
+void Rw11CntlDEUNA::RxPollHandler()
 {
-  // bail-out and cancel handler if poll returns an error event
-  if (pfd.revents & (~pfd.events)) return -1;
-
-  uint64_t cnt = fRxPollTimer.Read();       // harvest expiration count
+  fRxPollTimer = RtimerWheel::kIdNone;
   if (!Running() ||                         // if not running
-      fRxRingState != kStateRxPoll ||       // if not polling
-      !cnt) return 0;                       // if not expired -> quit
+      fRxRingState != kStateRxPoll) return; // if not polling -> quit
 
   fRxRingState = kStateRxIdle;              // end poll
   StartRxRing();                            // re-start rx ring
 
-  return 0;
+  return;
 }
 
 //--------------------------------------+-----------------------------------
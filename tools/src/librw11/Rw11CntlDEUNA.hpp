@@ -1,9 +1,13 @@
 // $Id: Rw11CntlDEUNA.hpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   0.5.4  add Queue{Tx,Rx}Ring(),Resume{Tx,Rx}Ring()
+// 2026-10-18  1221   0.5.3  fpProf{Tx,Rx}Ring -> fpSrc{Tx,Rx}Ring
+// 2026-10-18  1220   0.5.2  add fpProfTxRing,fpProfRxRing
+// 2026-10-18  1215   0.5.1  use RlinkServer timer wheel for rx poll timer
 // 2017-04-14   875   0.5    Initial version (minimal functions, 211bsd ready)
 // 2014-06-09   561   0.1    First draft 
 // ---------------------------------------------------------------------------
@@ -19,7 +23,6 @@
 #include <deque>
 
 #include "librtools/Rtime.hpp"
-#include "librtools/RtimerFd.hpp"
 
 #include "RethBuf.hpp"
 
@@ -302,9 +305,13 @@ namespace Retro {
                                 const uint16_t dscnxt[4]);
       void          StopRxRing();
 
+      void          QueueTxRing();
+      void          QueueRxRing();
+      void          ResumeTxRing();
+      void          ResumeRxRing();
       int           TxRingHandler();
       int           RxRingHandler();
-      int           RxPollHandler(const pollfd& pfd);
+      void          RxPollHandler();
 
       uint16_t      RingIndexNext(uint16_t index, uint16_t size, 
                                   uint16_t inc=1) const;
@@ -380,7 +387,11 @@ namespace Retro {
       uint16_t      fRxDscNxt[4];           //!< rx nxt ring dsc
       Rtime         fRxPollTime;            //!< rx poll time interval
       size_t        fRxQueLimit;            //!< rx queue limit
-      RtimerFd      fRxPollTimer;           //!< rx poll timer
+      RlinkServer::timerid_t fRxPollTimer;  //!< rx poll timer id
+      RlinkServer::ActnSrc* fpSrcTxRing;    //!< action source TxRingHandler
+      RlinkServer::ActnSrc* fpSrcRxRing;    //!< action source RxRingHandler
+      bool          fTxRingDeferred;        //!< TxRingHandler queue refused
+      bool          fRxRingDeferred;        //!< RxRingHandler queue refused
       std::deque<RethBuf::pbuf_t> fRxBufQueue; //!< rx packet queue
       RethBuf::pbuf_t fRxBufCurr;           //!< rx packet current
       size_t        fRxBufOffset;           //!< rx packet offset
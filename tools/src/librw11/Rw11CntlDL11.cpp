@@ -1,9 +1,12 @@
 // $Id: Rw11CntlDL11.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.5.4  name attn handler call profile
+// 2026-10-18  1217   1.5.3  use kPrioTerm priority class
+// 2026-10-18  1213   1.5.2  register fPrimClist for coalesced attn
 // 2019-05-31  1156   1.5.1  size->fuse rename; use unit.StatInc[RT]x
 // 2019-04-27  1139   1.5    add dl11_buf readout
 // 2019-04-19  1133   1.4.2  use ExecWibr(),ExecRibr()
@@ -164,7 +167,8 @@ void Rw11CntlDL11::Start()
 
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlDL11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioTerm, Name());
   fStarted = true;
   return;
 }
@@ -396,7 +400,8 @@ void Rw11CntlDL11::TxProcessBuf(const RlinkCommand& cmd, bool prim,
   if ((!fTxQueBusy) && fumin > 1) {       // if fumin>1 no fuse==1 seen
     fStats.Inc(kStatNTxQue);
     fTxQueBusy = true;
-    Server().QueueAction(bind(&Rw11CntlDL11::TxRcvHandler, this));
+    Server().QueueAction(bind(&Rw11CntlDL11::TxRcvHandler, this),
+                         RlinkServer::kPrioTerm);
   }
   
   if (fTraceLevel > 0) {
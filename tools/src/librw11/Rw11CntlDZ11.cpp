@@ -1,9 +1,12 @@
 // $Id: Rw11CntlDZ11.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2019- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2019-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.0.3  name attn handler call profile
+// 2026-10-18  1217   1.0.2  use kPrioTerm priority class
+// 2026-10-18  1213   1.0.1  register fPrimClist for coalesced attn
 // 2019-05-19  1150   1.0    Initial version
 // 2019-05-04  1146   0.1    First draft
 // ---------------------------------------------------------------------------
@@ -189,7 +192,8 @@ void Rw11CntlDZ11::Start()
 
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlDZ11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioTerm, Name());
   fStarted = true;
   return;
 }
@@ -487,7 +491,8 @@ void Rw11CntlDZ11::TxProcess(const RlinkCommand& cmd, bool prim, uint16_t fuse)
   if ((!fTxQueBusy) && done > 0 && (!lastseen)) {
     fStats.Inc(kStatNTxQue);
     fTxQueBusy = true;
-    Server().QueueAction(bind(&Rw11CntlDZ11::TxRcvHandler, this));
+    Server().QueueAction(bind(&Rw11CntlDZ11::TxRcvHandler, this),
+                         RlinkServer::kPrioTerm);
   }
   
   if (fTraceLevel > 0) {
@@ -1,9 +1,12 @@
 // $Id: Rw11CntlLP11.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.3.8  name attn handler call profile
+// 2026-10-18  1217   1.3.7  use kPrioBack priority class
+// 2026-10-18  1213   1.3.6  register fPrimClist for coalesced attn
 // 2019-05-30  1155   1.3.5  size->fuse rename
 // 2019-04-27  1140   1.3.4  use RtraceTools::
 // 2019-04-19  1133   1.3.3  use ExecWibr()
@@ -146,7 +149,8 @@ void Rw11CntlLP11::Start()
   
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlLP11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioBack, Name());
 
   fStarted = true;
   return;
@@ -313,7 +317,8 @@ void Rw11CntlLP11::ProcessBuf(const RlinkCommand& cmd, bool prim)
     } else {
       fStats.Inc(kStatNQue);
       fQueBusy = true;
-      Server().QueueAction(bind(&Rw11CntlLP11::RcvHandler, this));
+      Server().QueueAction(bind(&Rw11CntlLP11::RcvHandler, this),
+                           RlinkServer::kPrioBack);
     }
   }
 
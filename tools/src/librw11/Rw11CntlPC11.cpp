@@ -1,9 +1,13 @@
 // $Id: Rw11CntlPC11.cpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.5.6  PpRcvHandler via action source pprcv, limit 1
+// 2026-10-18  1220   1.5.5  name attn handler call profile
+// 2026-10-18  1217   1.5.4  use kPrioBack priority class
+// 2026-10-18  1213   1.5.3  register fPrimClist for coalesced attn
 // 2019-05-31  1156   1.5.2  size->fuse rename
 // 2019-04-27  1140   1.5.1  use RtraceTools::
 // 2019-04-20  1134   1.5    add pc11_buf readout
@@ -104,6 +108,8 @@ Rw11CntlPC11::Rw11CntlPC11()
     fFsize(0),
     fPpRblkSize(4),
     fPpQueBusy(false),
+    fPpQueDeferred(false),
+    fpSrcPpRcv(nullptr),
     fPrDrain(kPrDrain_Idle)
 {
   // must be here because Units have a back-ptr (not available at Rw11CntlBase)
@@ -168,7 +174,10 @@ void Rw11CntlPC11::Start()
 
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlPC11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioBack, Name());
+  fpSrcPpRcv = Server().ActnSource(Name() + ".pprcv", 1,
+                                   [this](){ PpResume(); });
 
   fStarted = true;
   return;
@@ -345,6 +354,7 @@ void Rw11CntlPC11::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fFsize:          " << RosPrintf(fFsize,"d",3) << endl;
   os << bl << "  fPpRblkSize:     " << RosPrintf(fPpRblkSize,"d",3) << endl;
   os << bl << "  fPpQueBusy:      " << RosPrintf(fPpQueBusy) << endl;
+  os << bl << "  fPpQueDeferred:  " << RosPrintf(fPpQueDeferred) << endl;
   os << bl << "  fPrDrain:        ";
   switch (fPrDrain) {
     case kPrDrain_Idle: os << "Idle";  break;
@@ -562,7 +572,7 @@ void Rw11CntlPC11::PpProcessBuf(const RlinkCommand& cmd, bool prim,
   if ((!fPpQueBusy) && fumin > 1) {       // if fumin>1 no fuse==1 seen
     fStats.Inc(kStatNPpQue);
     fPpQueBusy = true;
-    Server().QueueAction(bind(&Rw11CntlPC11::PpRcvHandler, this));
+    PpQueue();
   }
   
   if (fTraceLevel > 0) {
@@ -596,8 +606,34 @@ void Rw11CntlPC11::PpProcessBuf(const RlinkCommand& cmd, bool prim,
 }
   
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Queue PpRcvHandler, remember when action source refused it
   
+void Rw11CntlPC11::PpQueue()
+{
+  fPpQueDeferred = !Server().QueueAction(bind(&Rw11CntlPC11::PpRcvHandler,
+                                              this),
+                                         RlinkServer::kPrioBack, fpSrcPpRcv);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Resume handler of action source pprcv, re-queues a refused PpRcvHandler
+/*!
+  fPpQueBusy stays set while the action is deferred, so PpProcessBuf()
+  doesn't try to queue another one.
+ */
+
+void Rw11CntlPC11::PpResume()
+{
+  if (!fPpQueDeferred) return;
+  fPpQueDeferred = false;
+  PpQueue();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 int Rw11CntlPC11::PpRcvHandler()
 {
   fPpQueBusy = false;
@@ -1,9 +1,10 @@
 // $Id: Rw11CntlPC11.hpp 1185 2019-07-12 17:29:12Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.4.2  add PpQueue(),PpResume(),fPpQueDeferred,fpSrcPpRcv
 // 2019-05-30  1155   1.4.1  size->fuse rename
 // 2019-04-20  1134   1.4    add pc11_buf readout
 // 2019-04-14  1131   1.3.1  remove SetOnline(), use UnitSetup()
@@ -115,6 +116,8 @@ namespace Retro {
       void          PrProcessBuf(uint16_t rbuf);
       void          PpProcessBuf(const RlinkCommand& cmd, bool prim,
                                  uint16_t rbuf);
+      void          PpQueue();
+      void          PpResume();
       int           PpRcvHandler();
     
     protected:
@@ -127,6 +130,8 @@ namespace Retro {
       uint16_t      fFsize;                 //!< fifo size
       uint16_t      fPpRblkSize;            //!< puncher rblk chunk size
       bool          fPpQueBusy;             //!< puncher queue busy
+      bool          fPpQueDeferred;         //!< puncher queue refused
+      RlinkServer::ActnSrc* fpSrcPpRcv;     //!< action source PpRcvHandler
       int           fPrDrain;               //!< reader drain state
   };
   
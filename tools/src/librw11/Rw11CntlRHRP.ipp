@@ -1,9 +1,11 @@
 // $Id: Rw11CntlRHRP.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   1.2    add SetStream(),Stream()
+// 2026-10-18  1208   1.1    add SetChunkAuto(),ChunkAuto()
 // 2019-06-07  1160   1.0.1  RdmaStats() not longer const
 // 2015-05-14   680   1.0    Initial version
 // 2015-03-21   659   0.1    First draft
@@ -37,6 +39,40 @@ inline size_t Rw11CntlRHRP::ChunkSize() const
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline void Rw11CntlRHRP::SetChunkAuto(bool chunkauto)
+{
+  fRdma.SetChunkAuto(chunkauto);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline bool Rw11CntlRHRP::ChunkAuto() const
+{
+  return fRdma.ChunkAuto();
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline void Rw11CntlRHRP::SetStream(bool stream)
+{
+  fRdma.SetStream(stream);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline bool Rw11CntlRHRP::Stream() const
+{
+  return fRdma.Stream();
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline Rstats& Rw11CntlRHRP::RdmaStats()
 {
   return fRdma.Stats();
@@ -1,11 +1,13 @@
 // $Id: Rw11CntlRK11.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // Other credits: 
 //   the boot code is from the simh project and Copyright Robert M Supnik
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   2.0.14 name attn handler call profile
+// 2026-10-18  1213   2.0.13 register fPrimClist for coalesced attn
 // 2019-04-19  1133   2.0.12 use ExecWibr()
 // 2019-04-14  1131   2.0.11 proper unit init, call UnitSetupAll() in Start()
 // 2019-02-23  1114   2.0.10 use std::bind instead of lambda
@@ -216,7 +218,8 @@ void Rw11CntlRK11::Start()
 
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlRK11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioBulk, Name());
 
   fStarted = true;
   return;
@@ -1,9 +1,11 @@
 // $Id: Rw11CntlRK11.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   2.2    add SetStream(),Stream()
+// 2026-10-18  1208   2.1    add SetChunkAuto(),ChunkAuto()
 // 2019-06-07  1160   2.0.2  RdmaStats() not longer const
 // 2017-04-02   865   2.0.1  Dump(): add detail arg
 // 2015-01-03   627   2.0    use Rw11RdmaDisk
@@ -44,6 +46,10 @@ namespace Retro {
 
       void          SetChunkSize(size_t chunk);
       size_t        ChunkSize() const;
+      void          SetChunkAuto(bool chunkauto);
+      bool          ChunkAuto() const;
+      void          SetStream(bool stream);
+      bool          Stream() const;
 
       Rstats&       RdmaStats();
 
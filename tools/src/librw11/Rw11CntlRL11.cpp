@@ -1,12 +1,14 @@
 // $Id: Rw11CntlRL11.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // Other credits: 
 //   the boot code is from the simh project and Copyright Robert M Supnik
 //   CalcCrc() is adopted from the simh project and Copyright Robert M Supnik
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.0.14 name attn handler call profile
+// 2026-10-18  1213   1.0.13 register fPrimClist for coalesced attn
 // 2019-04-14  1131   1.0.12 proper unit init, call UnitSetupAll() in Start()
 // 2019-02-23  1114   1.0.11 use std::bind instead of lambda
 // 2018-12-22  1091   1.0.10 AttnHandler(): sa->san (-Wshadow fix)
@@ -256,7 +258,8 @@ void Rw11CntlRL11::Start()
 
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlRL11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioBulk, Name());
 
   fStarted = true;
   return;
@@ -1,9 +1,11 @@
 // $Id: Rw11CntlRL11.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   1.2    add SetStream(),Stream()
+// 2026-10-18  1208   1.1    add SetChunkAuto(),ChunkAuto()
 // 2019-06-07  1160   1.0.2  RdmaStats() not longer const
 // 2017-04-02   865   1.0.1  Dump(): add detail arg
 // 2015-03-01   653   1.0    Initial version
@@ -41,6 +43,10 @@ namespace Retro {
 
       void          SetChunkSize(size_t chunk);
       size_t        ChunkSize() const;
+      void          SetChunkAuto(bool chunkauto);
+      bool          ChunkAuto() const;
+      void          SetStream(bool stream);
+      bool          Stream() const;
 
       Rstats&       RdmaStats();
 
@@ -1,11 +1,14 @@
 // $Id: Rw11CntlTM11.cpp 1183 2019-07-10 18:48:41Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // Other credits: 
 //   the boot code is from the simh project and Copyright Robert M Supnik
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.2.1  name attn handler call profile
+// 2026-10-18  1214   1.2    record read/write via I/O worker pool
+// 2026-10-18  1213   1.1.1  register fPrimClist for coalesced attn
 // 2019-07-10  1183   1.1    support odd record length
 // 2019-07-08  1182   1.0.11 BUGFIX: AddNormalExit(): get tmds logic right
 // 2019-04-19  1133   1.0.10 use ExecWibr()
@@ -135,6 +138,8 @@ Rw11CntlTM11::Rw11CntlTM11()
     fRd_fu(0),
     fRd_rddone(0),
     fRd_opcode(0),
+    fIoRc(false),
+    fIoEmsg(),
     fBuf(),
     fRdma(this,
           std::bind(&Rw11CntlTM11::RdmaPreExecCB,  this, _1, _2, _3, _4),
@@ -201,7 +206,8 @@ void Rw11CntlTM11::Start()
 
   // add attn handler
   Server().AddAttnHandler(bind(&Rw11CntlTM11::AttnHandler, this, _1), 
-                          uint16_t(1)<<fLam, this);
+                          uint16_t(1)<<fLam, this, &fPrimClist,
+                          RlinkServer::kPrioBulk, Name());
 
   fStarted = true;
   return;
@@ -392,15 +398,8 @@ int Rw11CntlTM11::AttnHandler(RlinkServer::AttnArgs& args)
     fStats.Inc(kStatNFuncRead);
     size_t nwalloc = (nbyt+1)/2;
     if (fBuf.size() < nwalloc) fBuf.resize(nwalloc);
-    bool rc = unit.VirtReadRecord(nbyt, reinterpret_cast<uint8_t*>(fBuf.data()),
-                                  fRd_rddone, fRd_opcode, emsg);
-    if (!rc) WriteLog("read", emsg);
-    if ((!rc) || fRd_rddone == 0) {
-      AddFastExit(clist, fRd_opcode, 0);
-    } else {
-      size_t nwdma = fRd_rddone/2;
-      fRdma.QueueWMem(addr, fBuf.data(), nwdma, Rw11Cpu::kCPAH_M_UBM22);
-    }
+    fRdma.QueueIo(bind(&Rw11CntlTM11::IoReadRecord, this, unum, nbyt),
+                  bind(&Rw11CntlTM11::IoReadRecordDone, this));
 
   } else if (fu == kFUNC_WRITE ||           // Write -------------------------
              fu == kFUNC_WEIRG) {
@@ -461,6 +460,13 @@ void Rw11CntlTM11::RdmaPostExecCB(int stat, size_t ndone,
   // handle Rdma aborts
   if (stat == Rw11Rdma::kStatusFailRdma) tmcr |= kTMCR_M_RNXM;
 
+  // for WRITE or WEIRG write record first, register update when done
+  if (fRd_fu != kFUNC_READ) {
+    fRdma.QueueIo(bind(&Rw11CntlTM11::IoWriteRecord, this, ndone),
+                  bind(&Rw11CntlTM11::IoWriteRecordDone, this, ndone, tmcr));
+    return;
+  }
+
   // finally to TM11 register update
   RlinkCommandList clist1;
   AddNormalExit(clist1, ndone, tmcr);
@@ -468,6 +474,61 @@ void Rw11CntlTM11::RdmaPostExecCB(int stat, size_t ndone,
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Record read, called in I/O worker thread
+
+void Rw11CntlTM11::IoReadRecord(uint16_t unum, size_t nbyt)
+{
+  Rw11UnitTM11& unit = *fspUnit[unum];
+  fIoRc = unit.VirtReadRecord(nbyt, reinterpret_cast<uint8_t*>(fBuf.data()),
+                              fRd_rddone, fRd_opcode, fIoEmsg);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Record read completion, queues Rdma or does fast exit
+
+void Rw11CntlTM11::IoReadRecordDone()
+{
+  if (!fIoRc) WriteLog("read", fIoEmsg);
+  if ((!fIoRc) || fRd_rddone == 0) {
+    RlinkCommandList clist;
+    AddFastExit(clist, fRd_opcode, 0);
+    Server().Exec(clist);
+  } else {
+    size_t nwdma = fRd_rddone/2;
+    fRdma.QueueWMem(fRd_addr, fBuf.data(), nwdma, Rw11Cpu::kCPAH_M_UBM22);
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Record write, called in I/O worker thread
+
+void Rw11CntlTM11::IoWriteRecord(size_t ndone)
+{
+  uint16_t unum = (fRd_tmcr>>kTMCR_V_UNIT)  & kTMCR_B_UNIT;
+  Rw11UnitTM11& unit = *fspUnit[unum];
+  size_t nbyt = 2*ndone;
+  if (fRd_tmbc & 0x1) nbyt -= 1;            // odd rlen corrections
+  int opcode;
+  fIoRc = unit.VirtWriteRecord(nbyt, reinterpret_cast<uint8_t*>(fBuf.data()), 
+                               opcode, fIoEmsg);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Record write completion, does TM11 register update
+
+void Rw11CntlTM11::IoWriteRecordDone(size_t ndone, uint16_t tmcr)
+{
+  if (!fIoRc) WriteLog("write", fIoEmsg);
+  RlinkCommandList clist;
+  AddNormalExit(clist, ndone, tmcr);
+  Server().Exec(clist);
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -549,7 +610,6 @@ void Rw11CntlTM11::AddNormalExit(RlinkCommandList& clist, size_t ndone,
   
   uint32_t addr = fRd_addr + 2*ndone;
   uint16_t tmbc = fRd_tmbc + 2*uint16_t(ndone);
-  size_t   nbyt = 2*ndone;
 
   if (fRd_fu == kFUNC_READ) {               // handle READ
     if (fRd_rddone & 0x1) {                 // odd rlen corrections
@@ -561,7 +621,6 @@ void Rw11CntlTM11::AddNormalExit(RlinkCommandList& clist, size_t ndone,
 
     case Rw11VirtTape::kOpCodeOK:
       if (fRd_rddone & 0x1) {                 // write trailing byte
-        nbyt += 1;
         Cpu().AddLalh(clist, fRd_addr + 2*ndone, Rw11Cpu::kCPAH_M_UBM22);
         Cpu().AddMembe(clist, Rw11Cpu::kCPMEMBE_M_BE0);
         clist.AddWreg(Rw11Cpu::kCPMEM, fBuf[ndone]);
@@ -582,17 +641,11 @@ void Rw11CntlTM11::AddNormalExit(RlinkCommandList& clist, size_t ndone,
     }
 
   } else {                                  // handle WRITE or WEIRG
-    int opcode;
-    RerrMsg emsg;
     if (fRd_tmbc & 0x1) {                   // odd rlen corrections
-      nbyt -= 1;
       addr -= 1;
       tmbc -= 1;
     }
-    
-    if (!unit.VirtWriteRecord(nbyt, reinterpret_cast<uint8_t*>(fBuf.data()), 
-                              opcode, emsg)) 
-      WriteLog("write", emsg);
+    // Note: the record was already written by IoWriteRecord()
   }
 
   // now Virt status up-to-date, even for writes
@@ -1,9 +1,11 @@
 // $Id: Rw11CntlTM11.hpp 1183 2019-07-10 18:48:41Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1214   1.3    record read/write via I/O worker pool
+// 2026-10-18  1208   1.2    add SetChunkAuto(),ChunkAuto()
 // 2019-07-10  1183   1.1    support odd record length
 // 2019-06-07  1160   1.0.2  RdmaStats() not longer const
 // 2017-04-02   865   1.0.1  Dump(): add detail arg
@@ -42,6 +44,8 @@ namespace Retro {
 
       void          SetChunkSize(size_t chunk);
       size_t        ChunkSize() const;
+      void          SetChunkAuto(bool chunkauto);
+      bool          ChunkAuto() const;
 
       Rstats&       RdmaStats();
 
@@ -146,6 +150,10 @@ namespace Retro {
       void          AddNormalExit(RlinkCommandList& clist, size_t ndone,
                                   uint16_t tmcr=0);
       void          WriteLog(const char* func, RerrMsg&  emsg);
+      void          IoReadRecord(uint16_t unum, size_t nbyt);
+      void          IoReadRecordDone();
+      void          IoWriteRecord(size_t ndone);
+      void          IoWriteRecordDone(size_t ndone, uint16_t tmcr);
       void          WriteExitLog(uint16_t tmcr, uint32_t addr,
                                  uint16_t tmbc, uint16_t tmds);
 
@@ -164,6 +172,8 @@ namespace Retro {
       uint16_t      fRd_fu;                 //!< Rdma: request fu code
       size_t        fRd_rddone;             //!< Rdma: bytes read
       int           fRd_opcode;             //!< Rdma: read opcode
+      bool          fIoRc;                  //!< I/O job: return code
+      RerrMsg       fIoEmsg;                //!< I/O job: error message
       std::vector<uint16_t>  fBuf;          //!< data buffer
       Rw11Rdma      fRdma;                  //!< Rdma controller
   };
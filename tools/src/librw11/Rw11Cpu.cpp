@@ -1,9 +1,12 @@
 // $Id: Rw11Cpu.cpp 1175 2019-06-30 06:13:17Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.23 MemRead(),MemWrite(): adaptive bs only if fMemBlkAuto
+// 2026-10-18  1211   1.2.22 W11AttnHandler(): re-use fAttnClist
+// 2026-10-18  1208   1.2.21 MemRead(),MemWrite(): use adaptive block size
 // 2019-06-29  1175   1.2.20 MemWriteByte(): use membe 
 // 2019-04-30  1143   1.2.19 add m9312 setup and HasM9312()
 // 2019-04-19  1133   1.2.18 add ExecWibr(),ExecRibr(); LoadAbs(): better trace
@@ -230,6 +233,7 @@ Rw11Cpu::Rw11Cpu(const std::string& type)
     fHasKw11l(false),
     fHasKw11p(false),
     fHasIist(false),
+    fMemBlkAuto(false),
     fCpuAct(0),
     fCpuStat(0),
     fCpuActMutex(),
@@ -237,6 +241,7 @@ Rw11Cpu::Rw11Cpu(const std::string& type)
     fCntlMap(),
     fIAddrMap(),
     fRAddrMap(),
+    fAttnClist(),
     fStats()
 {}
 
@@ -509,40 +514,57 @@ uint16_t Rw11Cpu::ExecRibr(uint16_t ibaddr)
 }
   
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Read memory block.
+/*!
+  The transfer is split into blocks of RlinkConnect::BlockSizePrudent() size.
+  When enabled with SetMemBlkAuto() the blocks are RlinkConnect::BlockSizeAuto()
+  sized instead and the transfer time of each block is used to tune the
+  adaptive block size.
+ */
 
 bool Rw11Cpu::MemRead(uint16_t addr, std::vector<uint16_t>& data, 
                       size_t nword, RerrMsg& emsg)
 {
-  size_t blkmax = Connect().BlockSizePrudent();
   data.resize(nword);
   size_t ndone = 0;
   while (nword>ndone) {
+    size_t blkmax = fMemBlkAuto ? Connect().BlockSizeAuto() :
+                                  Connect().BlockSizePrudent();
     size_t nblk = min(blkmax, nword-ndone);
     RlinkCommandList clist;
     clist.AddWreg(fBase+kCPAL, addr+2*ndone);
     clist.AddRblk(fBase+kCPMEMI, data.data()+ndone, nblk);
+    Rtime tbeg(CLOCK_MONOTONIC);
     if (!Server().Exec(clist, emsg)) return false;
+    if (fMemBlkAuto)
+      Connect().BlockSizeAutoUpdate(nblk, Rtime(CLOCK_MONOTONIC) - tbeg);
     ndone += nblk;
   }
   return true;
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Write memory block.
+/*!
+  Block size selection as for MemRead().
+ */
 
 bool Rw11Cpu::MemWrite(uint16_t addr, const std::vector<uint16_t>& data,
                        RerrMsg& emsg)
 {
-  size_t blkmax = Connect().BlockSizePrudent();
   size_t nword = data.size();
   size_t ndone = 0;
   while (nword>ndone) {
+    size_t blkmax = fMemBlkAuto ? Connect().BlockSizeAuto() :
+                                  Connect().BlockSizePrudent();
     size_t nblk = min(blkmax, nword-ndone);
     RlinkCommandList clist;
     clist.AddWreg(fBase+kCPAL, addr+2*ndone);
     clist.AddWblk(fBase+kCPMEMI, data.data()+ndone, nblk);
+    Rtime tbeg(CLOCK_MONOTONIC);
     if (!Server().Exec(clist, emsg)) return false;
+    if (fMemBlkAuto)
+      Connect().BlockSizeAutoUpdate(nblk, Rtime(CLOCK_MONOTONIC) - tbeg);
     ndone += nblk;
   }
   return true;
@@ -934,10 +956,10 @@ void Rw11Cpu::AllRAddrMapInsert(const std::string& name, uint16_t rbaddr)
 
 void Rw11Cpu::W11AttnHandler()
 {
-  RlinkCommandList clist;
-  clist.AddRreg(fBase+kCPSTAT);
-  Server().Exec(clist);
-  SetCpuActDown(clist[0].Data());
+  fAttnClist.Clear();
+  fAttnClist.AddRreg(fBase+kCPSTAT);
+  Server().Exec(fAttnClist);
+  SetCpuActDown(fAttnClist[0].Data());
   return;
 }
 
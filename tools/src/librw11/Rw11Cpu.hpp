@@ -1,9 +1,11 @@
 // $Id: Rw11Cpu.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.22 add SetMemBlkAuto(),MemBlkAuto(),fMemBlkAuto
+// 2026-10-18  1211   1.2.21 add fAttnClist
 // 2019-06-07  1160   1.2.20 Stats() not longer const
 // 2019-04-30  1143   1.2.19 add HasM9312()
 // 2019-04-19  1133   1.2.18 add ExecWibr(),ExecRibr()
@@ -136,6 +138,9 @@ namespace Retro {
                              uint16_t ibaddr2=0, uint16_t data2=0);
       uint16_t      ExecRibr(uint16_t ibaddr);
 
+      void          SetMemBlkAuto(bool ena);
+      bool          MemBlkAuto() const;
+
       bool          MemRead(uint16_t addr, std::vector<uint16_t>& data, 
                             size_t nword, RerrMsg& emsg);
       bool          MemWrite(uint16_t addr, const std::vector<uint16_t>& data,
@@ -345,6 +350,7 @@ namespace Retro {
       bool          fHasKw11l;              //!< has kw11-l (line clock)
       bool          fHasKw11p;              //!< has kw11-p (prog clock)
       bool          fHasIist;               //!< has iist   (smp comm)
+      bool          fMemBlkAuto;            //!< MemRead/Write use adaptive bs
       bool          fCpuAct;
       uint16_t      fCpuStat;
       std::mutex               fCpuActMutex;
@@ -352,6 +358,7 @@ namespace Retro {
       cmap_t        fCntlMap;               //!< name->cntl map
       RlinkAddrMap  fIAddrMap;              //!< ibus name<->address mapping
       RlinkAddrMap  fRAddrMap;              //!< rbus name<->address mapping
+      RlinkCommandList fAttnClist;          //!< re-used list of W11AttnHandler
       Rstats        fStats;                 //!< statistics
   };
   
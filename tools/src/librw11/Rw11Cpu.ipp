@@ -1,9 +1,10 @@
 // $Id: Rw11Cpu.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.8  add SetMemBlkAuto(),MemBlkAuto()
 // 2019-06-07  1160   1.2.7  Stats() not longer const
 // 2019-04-30  1143   1.2.6  add HasM9312()
 // 2019-04-13  1131   1.2.5  add MemSize()
@@ -176,6 +177,23 @@ inline bool Rw11Cpu::HasIist() const
   return fHasIist;
 }
 
+//------------------------------------------+-----------------------------------
+//! Enable or disable adaptive block size for MemRead() and MemWrite()
+
+inline void Rw11Cpu::SetMemBlkAuto(bool ena)
+{
+  fMemBlkAuto = ena;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns \c true if MemRead() and MemWrite() use adaptive block size
+
+inline bool Rw11Cpu::MemBlkAuto() const
+{
+  return fMemBlkAuto;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -1,9 +1,20 @@
 // $Id: Rw11Rdma.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.5.3  limit action source cntl.rdma to 1, resume refused
+// 2026-10-18  1227   1.5.2  RdmaHandler(): ncmd of aborting inter-chunk labo
+// 2026-10-18  1227   1.5.1  RdmaHandler(): set fNCmdPost before PostRdmaHook()
+// 2026-10-18  1223   1.5    pack several chunks into one packet
+// 2026-10-18  1222   1.4    add stream mode (SetWordAvail(),ChunkRdmaHook())
+// 2026-10-18  1221   1.3.3  use action source cntl.rdma for RdmaHandler
+// 2026-10-18  1220   1.3.2  use call profile cntl.rdma for RdmaHandler
+// 2026-10-18  1217   1.3.1  use kPrioBulk priority class
+// 2026-10-18  1214   1.3    add QueueIo(); PostRdmaHook() can be async
+// 2026-10-18  1211   1.2.1  RdmaHandler(): re-use fClist
+// 2026-10-18  1208   1.2    add adaptive chunk size (SetChunkAuto())
 // 2019-02-23  1114   1.1.5  use std::bind instead of lambda
 // 2018-12-19  1090   1.1.4  use RosPrintf(bool)
 // 2018-12-15  1083   1.1.3  for std::function setups: use rval ref and move
@@ -21,6 +32,7 @@
 #include <functional>
 
 #include "librtools/Rexception.hpp"
+#include "librtools/Rtime.hpp"
 #include "librtools/RosFill.hpp"
 #include "librtools/RosPrintf.hpp"
 #include "librtools/RosPrintBvi.hpp"
@@ -37,6 +49,11 @@ using namespace std;
 // all method definitions in namespace Retro
 namespace Retro {
 
+//------------------------------------------+-----------------------------------
+// constants definitions
+
+const size_t Rw11Rdma::kRbufChunkDelta;
+
 //------------------------------------------+-----------------------------------
 //! Constructor
 
@@ -45,6 +62,8 @@ Rw11Rdma::Rw11Rdma(Rw11Cntl* pcntl, precb_t&& precb, postcb_t&& postcb)
     fPreExecCB(move(precb)),
     fPostExecCB(move(postcb)),
     fChunksize(0),
+    fChunkAuto(false),
+    fStream(false),
     fStatus(kStatusDone),
     fIsWMem(false),
     fAddr(0),
@@ -53,6 +72,14 @@ Rw11Rdma::Rw11Rdma(Rw11Cntl* pcntl, precb_t&& precb, postcb_t&& postcb)
     fNWordRest(0),
     fNWordDone(0),
     fpBlock(nullptr),
+    fNWordAvail(0),
+    fStalled(false),
+    fIoPending(false),
+    fNCmdPost(0),
+    fpActnSrc(nullptr),
+    fHdlDeferred(false),
+    fClist(),
+    fChunkInd(),
     fStats()
 {
   fStats.Define(kStatNQueRMem,     "NQueRMem"     , "RMem chains queued");
@@ -61,6 +88,9 @@ Rw11Rdma::Rw11Rdma(Rw11Cntl* pcntl, precb_t&& precb, postcb_t&& postcb)
   fStats.Define(kStatNRdmaWMem,    "NRdmaWMem"    , "WMem chunks done");
   fStats.Define(kStatNExtClist,    "NExtClist"    , "clist extended");
   fStats.Define(kStatNFailRdma,    "NFailRdma"    , "Rdma failures");
+  fStats.Define(kStatNQueIo,       "NQueIo"       , "I/O jobs queued");
+  fStats.Define(kStatNStall,       "NStall"       , "chunks stalled on data");
+  fStats.Define(kStatNExec,        "NExec"        , "Exec calls (packets)");
 }
 
 //------------------------------------------+-----------------------------------
@@ -80,6 +110,23 @@ void Rw11Rdma::SetChunkSize(size_t chunk)
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Enable or disable adaptive chunk size.
+/*!
+  When enabled the chunk size is determined for each chunk from
+  RlinkConnect::BlockSizeAuto(), and the transfer time of each chunk is
+  fed back with RlinkConnect::BlockSizeAutoUpdate(). While attentions of
+  other devices are pending the block size is reduced to give the
+  attention handlers, e.g. of terminals, a faster turn around.
+  The ChunkSize() setting is ignored in this mode.
+ */
+
+void Rw11Rdma::SetChunkAuto(bool chunkauto)
+{
+  fChunkAuto = chunkauto;
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -88,7 +135,7 @@ void Rw11Rdma::QueueRMem(uint32_t addr, uint16_t* block, size_t size,
 {
   fStats.Inc(kStatNQueRMem);
   SetupRdma(false, addr, block, size, mode);
-  Server().QueueAction(bind(&Rw11Rdma::RdmaHandler, this));
+  QueueHandler();
   return;
 }
 
@@ -100,7 +147,27 @@ void Rw11Rdma::QueueWMem(uint32_t addr, const uint16_t* block, size_t size,
 {
   fStats.Inc(kStatNQueWMem);
   SetupRdma(true, addr, const_cast<uint16_t*>(block), size, mode);
-  Server().QueueAction(bind(&Rw11Rdma::RdmaHandler, this));
+  QueueHandler();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Queue a blocking I/O job to the server I/O worker pool.
+/*!
+  \a work is called in a worker thread, \a done is called in the server
+  thread when \a work finished. The Rdma is considered active, see
+  IsActive(), while the job is pending. Only one job can be pending.
+ */
+
+void Rw11Rdma::QueueIo(RworkerPool::work_t&& work, RworkerPool::done_t&& done)
+{
+  if (fIoPending)
+    throw Rexception("Rw11Rdma::QueueIo", "Bad state: I/O already pending");
+
+  fStats.Inc(kStatNQueIo);
+  fIoPending = true;
+  Server().IoPool().Submit(move(work), bind(&Rw11Rdma::IoDone, this, 
+                                            RworkerPool::done_t(move(done))));
   return;
 }
 
@@ -114,6 +181,8 @@ void Rw11Rdma::Dump(std::ostream& os, int ind, const char* text,
   os << bl << (text?text:"--") << "Rw11Rdma @ " << this << endl;
 
   os << bl << "  fChunkSize:      " << RosPrintf(fChunksize,"d",4) << endl;
+  os << bl << "  fChunkAuto:      " << RosPrintf(fChunkAuto) << endl;
+  os << bl << "  fStream:         " << RosPrintf(fStream) << endl;
   os << bl << "  fStatus:         " << fStatus << endl;
   os << bl << "  fIsWMem:         " << RosPrintf(fIsWMem) << endl;
   os << bl << "  fAddr:           " << RosPrintBvi(fAddr,8,22) << endl;
@@ -122,6 +191,10 @@ void Rw11Rdma::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fNWordRest:      " << RosPrintf(fNWordRest,"d",4) << endl;
   os << bl << "  fNWordDone:      " << RosPrintf(fNWordDone,"d",4) << endl;
   os << bl << "  fpBlock:         " << fpBlock << endl;
+  os << bl << "  fNWordAvail:     " << RosPrintf(fNWordAvail,"d",4) << endl;
+  os << bl << "  fStalled:        " << RosPrintf(fStalled) << endl;
+  os << bl << "  fIoPending:      " << RosPrintf(fIoPending) << endl;
+  os << bl << "  fHdlDeferred:    " << RosPrintf(fHdlDeferred) << endl;
   fStats.Dump(os, ind+2, "fStats: ", detail-1);
   return;
 }
@@ -148,6 +221,64 @@ void Rw11Rdma::SetupRdma(bool iswmem, uint32_t addr, uint16_t* block,
   fNWordRest = size;
   fNWordDone = 0;  
   fpBlock    = block;
+  fNWordAvail = size;
+  fStalled   = false;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Queue RdmaHandler() as server action.
+/*!
+  Only one RdmaHandler() action can be pending, see ActnSource(). When the
+  server refuses the action it is queued again by the resume handler.
+ */
+
+void Rw11Rdma::QueueHandler()
+{
+  if (!Server().QueueAction(bind(&Rw11Rdma::RdmaHandler, this),
+                            RlinkServer::kPrioBulk, ActnSource())) {
+    fHdlDeferred = true;
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns action source of RdmaHandler(), named after the controller
+/*!
+  The source has a limit of one pending action, a refused action is
+  queued again by the resume handler when the pending one completed.
+ */
+
+RlinkServer::ActnSrc* Rw11Rdma::ActnSource()
+{
+  if (!fpActnSrc) {
+    fpActnSrc = Server().ActnSource(CntlBase().Name() + ".rdma", 1,
+                                    [this](){
+                                      if (!fHdlDeferred) return;
+                                      fHdlDeferred = false;
+                                      QueueHandler();
+                                    });
+  }
+  return fpActnSrc;
+}
+
+//------------------------------------------+-----------------------------------
+//! Set number of words at the start of the buffer ready for transfer.
+/*!
+  By default the whole buffer is ready when the Rdma is queued. A subclass
+  which fills the buffer while the Rdma runs lowers the limit right after
+  QueueWMem() and raises it as data arrives. A chunk never extends beyond
+  the limit, when RdmaHandler() finds no data it stalls and is queued again
+  by the next SetWordAvail() call.
+ */
+
+void Rw11Rdma::SetWordAvail(size_t nword)
+{
+  fNWordAvail = nword;
+  if (fStalled && fNWordAvail > fNWordDone) {
+    fStalled = false;
+    QueueHandler();
+  }
   return;
 }
 
@@ -156,30 +287,84 @@ void Rw11Rdma::SetupRdma(bool iswmem, uint32_t addr, uint16_t* block,
 
 int Rw11Rdma::RdmaHandler()
 {
-  RlinkCommandList clist;
+  RlinkCommandList& clist = fClist;
+  clist.Clear();
 
   if (fNWordDone == 0) {                    // first chunk ?
     PreRdmaHook();
   }
 
-  size_t nwnext = min(fNWordRest, fNWordMax);
-  if (fIsWMem) {
-    fStats.Inc(kStatNRdmaWMem);
-    Cpu().AddWMem(clist, fAddr, fpBlock, nwnext, fMode, true);
-  } else {
-    fStats.Inc(kStatNRdmaRMem);
-    Cpu().AddRMem(clist, fAddr, fpBlock, nwnext, fMode, true);
+  if (fNWordRest > 0 && fNWordAvail <= fNWordDone) {  // no data yet: stall
+    fStats.Inc(kStatNStall);
+    fStalled = true;
+    return 0;
   }
+
+  if (fChunkAuto) {                         // adaptive chunk size
+    int lam = CntlBase().Lam();
+    uint16_t amask = (lam >= 0) ? uint16_t(1)<<lam : 0;
+    if (Server().AttnPendingPatt() & ~amask) Connect().BlockSizeAutoShrink();
+    fNWordMax = Connect().BlockSizeAuto();
+  }
+
+  // add chunks as long as they fit into one packet. Each chunk reloads
+  // cpal/cpah, chunks are separated by a labo, so a failing chunk aborts
+  // the rest of the packet. In adaptive mode one chunk is send.
+  size_t nwrest = min(fNWordRest, fNWordAvail-fNWordDone);
+  size_t rbmax  = Connect().RbufSize() - RlinkConnect::kRbufPrudentDelta;
+  size_t rbuse  = 0;
+  size_t nwnext = 0;
+  fChunkInd.clear();
+  do {
+    size_t nw   = min(nwrest, fNWordMax);
+    size_t nuse = 2*nw + RlinkConnect::kRbufBlkDelta + kRbufChunkDelta;
+    if (!fChunkInd.empty()) {
+      if (fChunkAuto || rbuse+nuse > rbmax) break;
+      clist.AddLabo();
+    }
+    if (fIsWMem) {
+      fStats.Inc(kStatNRdmaWMem);
+      Cpu().AddWMem(clist, fAddr+2*nwnext, fpBlock+nwnext, nw, fMode, true);
+    } else {
+      fStats.Inc(kStatNRdmaRMem);
+      Cpu().AddRMem(clist, fAddr+2*nwnext, fpBlock+nwnext, nw, fMode, true);
+    }
+    fChunkInd.push_back(clist.Size()-1);
+    rbuse  += nuse;
+    nwnext += nw;
+    nwrest -= nw;
+  } while (nwrest > 0);
   size_t ncmd = clist.Size();
+  fStats.Inc(kStatNExec);
   
   if (nwnext == fNWordRest) fStatus = kStatusBusyLast;
   
   fPreExecCB(fStatus, fNWordDone, nwnext, clist);
   if (clist.Size() != ncmd) fStats.Inc(kStatNExtClist);
 
+  Rtime tbeg(CLOCK_MONOTONIC);
   Server().Exec(clist);
 
-  size_t nwdone = clist[ncmd-1].BlockDone();
+  size_t nwdone = 0;
+  for (size_t i=0; i<fChunkInd.size(); i++) {
+    const RlinkCommand& cmd = clist[fChunkInd[i]];
+    nwdone += cmd.BlockDone();
+    if (cmd.BlockDone() != cmd.BlockSize()) {
+      // when a chunk other than the last fails the labo after it aborts
+      // the packet, the fused labo of the controller is never executed.
+      // Report the aborting labo instead, so the controller does its
+      // error exit.
+      if (i+1 < fChunkInd.size()) {
+        const RlinkCommand& labo = clist[fChunkInd[i]+1];
+        if (labo.Command() == RlinkCommand::kCmdLabo && labo.Data() != 0)
+          ncmd = fChunkInd[i]+1;
+      }
+      break;
+    }
+  }
+  if (fChunkAuto && nwdone == fNWordMax) {
+    Connect().BlockSizeAutoUpdate(nwdone, Rtime(CLOCK_MONOTONIC) - tbeg);
+  }
   
   fAddr      += 2*nwdone;
   fNWordRest -= nwdone;
@@ -196,11 +381,23 @@ int Rw11Rdma::RdmaHandler()
     islast  = true;
   }
 
-  if (islast) {
-    PostRdmaHook(fNWordDone);
+  // fNCmdPost must be set before PostRdmaHook(), with an inline I/O pool
+  // the job and PostRdmaHookDone() run before PostRdmaHook() returns
+  fNCmdPost = ncmd;
+  if (islast && PostRdmaHook(fNWordDone)) { // post hook queued I/O ?
+    return 0;                               // finish in PostRdmaHookDone()
   }
+  if (!islast) ChunkRdmaHook(fNWordDone);
+
+  return RdmaDone(ncmd);
+}
+
+//------------------------------------------+-----------------------------------
+//! Call post Exec callback and finish Rdma when last chunk was done
 
-  fPostExecCB(fStatus, fNWordDone, clist, ncmd);
+int Rw11Rdma::RdmaDone(size_t ncmd)
+{
+  fPostExecCB(fStatus, fNWordDone, fClist, ncmd);
 
   if (fStatus == kStatusBusy) {
     return 1;
@@ -209,6 +406,16 @@ int Rw11Rdma::RdmaHandler()
   return 0;
 }
 
+//------------------------------------------+-----------------------------------
+//! Completion wrapper for QueueIo()
+
+void Rw11Rdma::IoDone(const RworkerPool::done_t& done)
+{
+  fIoPending = false;
+  done();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -218,10 +425,31 @@ void Rw11Rdma::PreRdmaHook()
 }
   
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Hook called after each chunk except the last, \a nwdone is words done
+
+void Rw11Rdma::ChunkRdmaHook(size_t /*nwdone*/)
+{
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Hook called after the last chunk.
+/*!
+  Returns \c true when the hook queued an I/O job with QueueIo(). In that
+  case the job completion must call PostRdmaHookDone() to finish the Rdma.
+ */
+
+bool Rw11Rdma::PostRdmaHook(size_t /*nwdone*/)
+{
+  return false;
+}
+
+//------------------------------------------+-----------------------------------
+//! Finish Rdma after an asynchronous PostRdmaHook()
 
-void Rw11Rdma::PostRdmaHook(size_t /*nwdone*/)
+void Rw11Rdma::PostRdmaHookDone()
 {
+  RdmaDone(fNCmdPost);
   return;
 }
   
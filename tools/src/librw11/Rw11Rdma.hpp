@@ -1,9 +1,17 @@
 // $Id: Rw11Rdma.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.7.1  add QueueHandler(),fHdlDeferred
+// 2026-10-18  1223   1.7    add fChunkInd, kRbufChunkDelta, NExec stat
+// 2026-10-18  1222   1.6    add stream mode (SetWordAvail(),ChunkRdmaHook())
+// 2026-10-18  1221   1.5    Profile() -> ActnSource(); fpProf -> fpActnSrc
+// 2026-10-18  1220   1.4    add Profile(), fpProf
+// 2026-10-18  1214   1.3    add QueueIo(); PostRdmaHook() can be async
+// 2026-10-18  1211   1.2.1  add fClist
+// 2026-10-18  1208   1.2    add SetChunkAuto(),ChunkAuto()
 // 2019-06-07  1160   1.1.5  Stats() not longer const
 // 2018-12-16  1084   1.1.4  use =delete for noncopyable instead of boost
 // 2018-12-15  1083   1.1.3  for std::function setups: use rval ref and move
@@ -22,9 +30,11 @@
 #define included_Retro_Rw11Rdma 1
 
 #include <functional>
+#include <vector>
 
 #include "librtools/Rstats.hpp"
 #include "librtools/RerrMsg.hpp"
+#include "librtools/RworkerPool.hpp"
 
 #include "librtools/Rbits.hpp"
 #include "Rw11Cntl.hpp"
@@ -55,6 +65,10 @@ namespace Retro {
 
       void          SetChunkSize(size_t chunk);
       size_t        ChunkSize() const;
+      void          SetChunkAuto(bool chunkauto);
+      bool          ChunkAuto() const;
+      void          SetStream(bool stream);
+      bool          Stream() const;
 
       bool          IsActive() const;
 
@@ -62,6 +76,8 @@ namespace Retro {
                               uint16_t mode);
       void          QueueWMem(uint32_t addr, const uint16_t* block, size_t size,
                               uint16_t mode);
+      void          QueueIo(RworkerPool::work_t&& work, 
+                            RworkerPool::done_t&& done);
 
       Rstats&       Stats();
       virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
@@ -75,6 +91,9 @@ namespace Retro {
         kStatNRdmaWMem,                     //!< WMem chunks done
         kStatNExtClist,                     //!< clist extended
         kStatNFailRdma,                     //!< Rdma failures
+        kStatNQueIo,                        //!< I/O jobs queued
+        kStatNStall,                        //!< chunks stalled on data
+        kStatNExec,                         //!< Exec calls (packets)
         kDimStat
       };    
 
@@ -87,17 +106,28 @@ namespace Retro {
       };
 
     protected:
+      static const size_t kRbufChunkDelta=16; //!< rbuf for chunk cpal/h,labo
+
       void          SetupRdma(bool iswmem, uint32_t addr, uint16_t* block,
                               size_t size, uint16_t mode);
       int           RdmaHandler();
+      void          QueueHandler();
+      RlinkServer::ActnSrc* ActnSource();
+      int           RdmaDone(size_t ncmd);
+      void          IoDone(const RworkerPool::done_t& done);
+      void          SetWordAvail(size_t nword);
       virtual void  PreRdmaHook();
-      virtual void  PostRdmaHook(size_t nwdone);
+      virtual void  ChunkRdmaHook(size_t nwdone);
+      virtual bool  PostRdmaHook(size_t nwdone);
+      void          PostRdmaHookDone();
 
     protected:
       Rw11Cntl*     fpCntlBase;             //!< plain Rw11Cntl ptr
       precb_t       fPreExecCB;             //!< pre Exec callback
       postcb_t      fPostExecCB;            //!< post Exec callback
       size_t        fChunksize;             //!< channel chunk size
+      bool          fChunkAuto;             //!< use adaptive chunk size
+      bool          fStream;                //!< overlap I/O and transfer
       enum status   fStatus;                //!< dma status
       bool          fIsWMem;                //!< is memory write
       uint32_t      fAddr;                  //!< current mem address
@@ -106,6 +136,14 @@ namespace Retro {
       size_t        fNWordRest;             //!< words to be done
       size_t        fNWordDone;             //!< words transfered
       uint16_t*     fpBlock;                //!< current buffer pointer
+      size_t        fNWordAvail;            //!< words ready for transfer
+      bool          fStalled;               //!< handler waits for data
+      bool          fIoPending;             //!< I/O job pending
+      size_t        fNCmdPost;              //!< ncmd for async PostRdmaHook
+      RlinkServer::ActnSrc* fpActnSrc;      //!< action source of RdmaHandler
+      bool          fHdlDeferred;           //!< RdmaHandler queue refused
+      RlinkCommandList fClist;              //!< re-used list of RdmaHandler
+      std::vector<size_t> fChunkInd;        //!< clist index of chunk blk's
       Rstats        fStats;                 //!< statistics
   };
   
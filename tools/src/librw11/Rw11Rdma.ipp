@@ -1,9 +1,12 @@
 // $Id: Rw11Rdma.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   1.4    add SetStream(),Stream()
+// 2026-10-18  1214   1.3    IsActive(): true also when I/O pending
+// 2026-10-18  1208   1.1    add ChunkAuto()
 // 2019-06-07  1160   1.0.1  Stats() not longer const
 // 2015-01-04   627   1.0    Initial version
 // ---------------------------------------------------------------------------
@@ -74,9 +77,34 @@ inline size_t Rw11Rdma::ChunkSize() const
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+inline bool Rw11Rdma::ChunkAuto() const
+{
+  return fChunkAuto;
+}
+
+//------------------------------------------+-----------------------------------
+//! Enable or disable streaming, see Rw11RdmaDisk.
+
+inline void Rw11Rdma::SetStream(bool stream)
+{
+  fStream = stream;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline bool Rw11Rdma::Stream() const
+{
+  return fStream;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 inline bool Rw11Rdma::IsActive() const
 {
-  return fStatus != kStatusDone;
+  return fStatus != kStatusDone || fIoPending;
 }
 
 //------------------------------------------+-----------------------------------
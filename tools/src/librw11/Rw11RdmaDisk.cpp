@@ -1,9 +1,11 @@
 // $Id: Rw11RdmaDisk.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   1.2    stream mode: overlap disk I/O and Rdma
+// 2026-10-18  1214   1.1    disk read/write via I/O worker pool
 // 2018-09-16  1047   1.0.2  coverity fixup (uninitialized scalar)
 // 2017-04-02   865   1.0.1  Dump(): add detail arg
 // 2015-01-04   628   1.0    Initial version
@@ -13,6 +15,8 @@
   \brief   Implemenation of Rw11RdmaDisk.
 */
 
+#include <algorithm>
+
 #include "librtools/RosFill.hpp"
 #include "librtools/RosPrintf.hpp"
 #include "librtools/Rexception.hpp"
@@ -39,10 +43,16 @@ Rw11RdmaDisk::Rw11RdmaDisk(Rw11Cntl* pcntl, precb_t&& precb, postcb_t&& postcb)
     fNWord(0),
     fNBlock(0),
     fLba(),
-    fFunc(kFuncRead)
+    fFunc(kFuncRead),
+    fNBlkIo(0),
+    fPostWait(false),
+    fIoRc(false),
+    fIoEmsg()
 {
   fStats.Define(kStatNWritePadded, "NWritePadded" , "padded disk write");
   fStats.Define(kStatNWChkFail,    "NWChkFail"    , "write check failed");
+  fStats.Define(kStatNIoStream,    "NIoStream"    , "I/O jobs overlapping Rdma");
+  fStream = true;                           // default: overlap I/O and Rdma
 }
 
 //------------------------------------------+-----------------------------------
@@ -52,13 +62,19 @@ Rw11RdmaDisk::~Rw11RdmaDisk()
 {}
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Queue a disk read.
+/*!
+  The disk is read with I/O worker pool jobs, the Rdma is queued when
+  the first data is available. In stream mode, see Rw11Rdma::SetStream(),
+  the disk is read in segments of about one chunk, the next segment is
+  read while the previous one is transfered.
+ */
 
 void Rw11RdmaDisk::QueueDiskRead(uint32_t addr, size_t size, uint16_t mode, 
                                  uint32_t lba, Rw11UnitDisk* punit)
 {
   SetupDisk(size, lba, punit, kFuncRead);
-  QueueWMem(addr, fBuf.data(), size, mode);
+  QueueIoRead(addr, size, mode);
   return;
 }
 
@@ -129,6 +145,8 @@ void Rw11RdmaDisk::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fNBlock:         " << RosPrintf(fNBlock,"d",5) << endl;
   os << bl << "  fLba:            " << RosPrintf(fLba,"d",8) << endl;
   os << bl << "  fFunc:           " << fFunc << endl;
+  os << bl << "  fNBlkIo:         " << RosPrintf(fNBlkIo,"d",5) << endl;
+  os << bl << "  fPostWait:       " << RosPrintf(fPostWait) << endl;
 
   Rw11Rdma::Dump(os, ind, " ^", detail);
   return;
@@ -147,6 +165,8 @@ void Rw11RdmaDisk::SetupDisk(size_t size, uint32_t lba, Rw11UnitDisk* punit,
   fNBlock = (fNWord+bszwrd-1)/bszwrd;
   fLba    = lba;
   fFunc   = func;
+  fNBlkIo = 0;
+  fPostWait = false;
 
   size_t tsize = fNBlock*bszwrd;
   if (fBuf.size() < tsize) fBuf.resize(tsize);
@@ -155,31 +175,82 @@ void Rw11RdmaDisk::SetupDisk(size_t size, uint32_t lba, Rw11UnitDisk* punit,
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Returns number of disk blocks per I/O job in stream mode (about a chunk)
 
-void Rw11RdmaDisk::PreRdmaHook()
+size_t Rw11RdmaDisk::SegBlocks() const
 {
-  if (fFunc != kFuncRead) return;          // quit unless read request
+  size_t nwseg = fChunkAuto ? Connect().BlockSizeAuto() : fChunksize;
+  if (nwseg == 0) nwseg = Connect().BlockSizePrudent();
+  size_t bszwrd = fpUnit->BlockSize()/2;    // block size in words
+  return max(size_t(1), nwseg/bszwrd);
+}
 
-  RerrMsg emsg;
-  bool rc = fpUnit->VirtRead(fLba, fNBlock,
-                             reinterpret_cast<uint8_t*>(fBuf.data()), emsg);
-  if (!rc) throw Rexception("Rw11RdmaDisk::PreRdmaHook()", 
-                            "VirtRead() failed: ", emsg);
+//------------------------------------------+-----------------------------------
+//! Queue read of the next disk segment
+
+void Rw11RdmaDisk::QueueIoRead(uint32_t addr, size_t size, uint16_t mode)
+{
+  size_t nblock = fNBlock - fNBlkIo;
+  if (fStream) nblock = min(nblock, SegBlocks());
+  QueueIo(bind(&Rw11RdmaDisk::IoRead, this, nblock),
+          bind(&Rw11RdmaDisk::IoReadDone, this, addr, size, mode, nblock));
   return;
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Hook called after each chunk, writes completed blocks in stream mode
+/*!
+  Only one I/O job can be pending, blocks completed while a write is
+  pending are written when it is done, see IoWriteChunkDone().
+ */
 
-void Rw11RdmaDisk::PostRdmaHook(size_t nwdone)
+void Rw11RdmaDisk::ChunkRdmaHook(size_t nwdone)
 {
-  if (nwdone == 0) return;                  // quit if rdma failed early
-  if (fFunc != kFuncWrite) return;          // quit unless write request
+  if (fFunc != kFuncWrite || !fStream || fIoPending) return;
+
+  size_t bszwrd = fpUnit->BlockSize()/2;    // block size in words
+  size_t nblock = nwdone/bszwrd - fNBlkIo;  // complete, not written blocks
+  if (nblock == 0) return;
+
+  fStats.Inc(kStatNIoStream);
+  QueueIo(bind(&Rw11RdmaDisk::IoWrite, this, nblock),
+          bind(&Rw11RdmaDisk::IoWriteChunkDone, this, nblock));
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Hook called after the last chunk
+/*!
+  When a stream mode I/O job is still pending the Rdma is finished after
+  that job, see PostWaitDone(). Otherwise PostIo() is called.
+ */
+
+bool Rw11RdmaDisk::PostRdmaHook(size_t nwdone)
+{
+  if (fIoPending) {                         // stream mode I/O pending
+    fPostWait = true;                       //   finish in PostWaitDone()
+    return true;
+  }
+  return PostIo(nwdone);
+}
+
+//------------------------------------------+-----------------------------------
+//! Write the not yet written blocks of a write request
+/*!
+  For write requests the disk is written with an I/O worker pool job, the
+  Rdma is finished when the job completed. Returns \c true when a job was
+  queued.
+ */
+
+bool Rw11RdmaDisk::PostIo(size_t nwdone)
+{
+  if (nwdone == 0) return false;            // quit if rdma failed early
+  if (fFunc != kFuncWrite) return false;    // quit unless write request
 
   size_t bszwrd = fpUnit->BlockSize()/2;    // block size in words
   size_t nblock = (nwdone+bszwrd-1)/bszwrd;
   size_t npad   = nblock*bszwrd - nwdone;
+  if (nblock <= fNBlkIo) return false;      // all written in stream mode
 
   // if an incomplete block was read, pad it with hex dead
   if (npad) {
@@ -188,13 +259,99 @@ void Rw11RdmaDisk::PostRdmaHook(size_t nwdone)
     for (size_t i=0; i<npad; i++) *p++ = 0xdead;
   }
 
-  RerrMsg emsg;
-  bool rc = fpUnit->VirtWrite(fLba, nblock, 
-                              reinterpret_cast<uint8_t*>(fBuf.data()), emsg);
-  if (!rc) throw Rexception("Rw11RdmaDisk::PostRdmaHook()", 
-                            "VirtWrite() failed: ", emsg);
+  QueueIo(bind(&Rw11RdmaDisk::IoWrite, this, nblock-fNBlkIo),
+          bind(&Rw11RdmaDisk::IoWriteDone, this));
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Finish Rdma which ended while a stream mode I/O job was pending
+
+void Rw11RdmaDisk::PostWaitDone()
+{
+  fPostWait = false;
+  if (!PostIo(fNWordDone)) PostRdmaHookDone();
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Disk read of \a nblock blocks after fNBlkIo, called in I/O worker thread
+
+void Rw11RdmaDisk::IoRead(size_t nblock)
+{
+  size_t bszwrd = fpUnit->BlockSize()/2;    // block size in words
+  uint16_t* pbuf = fBuf.data() + fNBlkIo*bszwrd;
+  fIoRc = fpUnit->VirtRead(fLba+fNBlkIo, nblock,
+                           reinterpret_cast<uint8_t*>(pbuf), fIoEmsg);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Disk read completion
+/*!
+  Queues the Rdma after the first segment, makes the data available to
+  the Rdma and queues the read of the next segment.
+ */
+
+void Rw11RdmaDisk::IoReadDone(uint32_t addr, size_t size, uint16_t mode,
+                              size_t nblock)
+{
+  if (!fIoRc) throw Rexception("Rw11RdmaDisk::IoReadDone()", 
+                               "VirtRead() failed: ", fIoEmsg);
+  bool first = fNBlkIo == 0;
+  fNBlkIo += nblock;
+  if (fPostWait) {                          // Rdma failed meanwhile
+    PostWaitDone();
+    return;
+  }
+
+  size_t bszwrd = fpUnit->BlockSize()/2;    // block size in words
+  if (first) QueueWMem(addr, fBuf.data(), size, mode);
+  SetWordAvail(min(fNBlkIo*bszwrd, fNWord));
+  if (fNBlkIo < fNBlock) {
+    fStats.Inc(kStatNIoStream);
+    QueueIoRead(addr, size, mode);
+  }
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Disk write of \a nblock blocks after fNBlkIo, called in I/O worker thread
+
+void Rw11RdmaDisk::IoWrite(size_t nblock)
+{
+  size_t bszwrd = fpUnit->BlockSize()/2;    // block size in words
+  uint16_t* pbuf = fBuf.data() + fNBlkIo*bszwrd;
+  fIoRc = fpUnit->VirtWrite(fLba+fNBlkIo, nblock, 
+                            reinterpret_cast<uint8_t*>(pbuf), fIoEmsg);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Stream mode disk write completion, writes blocks completed meanwhile
+
+void Rw11RdmaDisk::IoWriteChunkDone(size_t nblock)
+{
+  if (!fIoRc) throw Rexception("Rw11RdmaDisk::IoWriteChunkDone()", 
+                               "VirtWrite() failed: ", fIoEmsg);
+  fNBlkIo += nblock;
+  if (fPostWait) {                          // last chunk done meanwhile
+    PostWaitDone();
+    return;
+  }
+  ChunkRdmaHook(fNWordDone);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Disk write completion, finishes the Rdma
+
+void Rw11RdmaDisk::IoWriteDone()
+{
+  if (!fIoRc) throw Rexception("Rw11RdmaDisk::IoWriteDone()", 
+                               "VirtWrite() failed: ", fIoEmsg);
+  PostRdmaHookDone();
+  return;
+}
 
 } // end namespace Retro
@@ -1,9 +1,11 @@
 // $Id: Rw11RdmaDisk.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2015-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2015-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   1.2    stream mode: overlap disk I/O and Rdma
+// 2026-10-18  1214   1.1    disk read/write via I/O worker pool
 // 2018-12-15  1083   1.0.2  for std::function setups: use rval ref and move
 // 2017-04-02   865   1.0.1  Dump(): add detail arg
 // 2015-01-04   627   1.0    Initial version
@@ -47,6 +49,7 @@ namespace Retro {
       enum stats {
         kStatNWritePadded = Rw11Rdma::kDimStat,//!< padded disk write
         kStatNWChkFail,                        //!< write check failed
+        kStatNIoStream,                        //!< I/O jobs overlapping Rdma
         kDimStat
       };
     
@@ -60,8 +63,18 @@ namespace Retro {
 
       void          SetupDisk(size_t size, uint32_t lba, Rw11UnitDisk* punit, 
                               Rw11RdmaDisk::func func);
-      virtual void  PreRdmaHook();
-      virtual void  PostRdmaHook(size_t nwdone);
+      size_t        SegBlocks() const;
+      void          QueueIoRead(uint32_t addr, size_t size, uint16_t mode);
+      virtual void  ChunkRdmaHook(size_t nwdone);
+      virtual bool  PostRdmaHook(size_t nwdone);
+      bool          PostIo(size_t nwdone);
+      void          PostWaitDone();
+      void          IoRead(size_t nblock);
+      void          IoReadDone(uint32_t addr, size_t size, uint16_t mode,
+                               size_t nblock);
+      void          IoWrite(size_t nblock);
+      void          IoWriteChunkDone(size_t nblock);
+      void          IoWriteDone();
 
     protected:
       std::vector<uint16_t>  fBuf;          //!< data buffer
@@ -70,6 +83,10 @@ namespace Retro {
       size_t        fNBlock;                //!< disk blocks to transfer
       size_t        fLba;                   //!< disk lba
       enum func     fFunc;                  //!< current function
+      size_t        fNBlkIo;                //!< blocks read or written
+      bool          fPostWait;              //!< finish Rdma after I/O job
+      bool          fIoRc;                  //!< I/O job: return code
+      RerrMsg       fIoEmsg;                //!< I/O job: error message
   };
   
 } // end namespace Retro
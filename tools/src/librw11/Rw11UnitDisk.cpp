@@ -1,9 +1,12 @@
 // $Id: Rw11UnitDisk.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.1  dtor: drain IoPool before CacheDetach()
+// 2026-10-18  1226   1.2    add sequential read detection and read-ahead
+// 2026-10-18  1225   1.1    use block cache; add DetachCleanup()
 // 2018-12-19  1090   1.0.4  use RosPrintf(bool)
 // 2018-12-09  1080   1.0.3  use HasVirt(); Virt() returns ref
 // 2017-04-07   868   1.0.2  Dump(): add detail arg
@@ -16,7 +19,10 @@
   \brief   Implemenation of Rw11UnitDisk.
 */
 
+#include <algorithm>
+
 #include "librtools/Rexception.hpp"
+#include "librtools/Rtools.hpp"
 #include "librtools/RosFill.hpp"
 #include "librtools/RosPrintf.hpp"
 
@@ -32,6 +38,11 @@ using namespace std;
 // all method definitions in namespace Retro
 namespace Retro {
 
+//------------------------------------------+-----------------------------------
+// constants definitions
+
+const size_t Rw11UnitDisk::kRaWindowDef;
+
 //------------------------------------------+-----------------------------------
 //! Constructor
 
@@ -44,14 +55,30 @@ Rw11UnitDisk::Rw11UnitDisk(Rw11Cntl* pcntl, size_t index)
     fNSect(0),
     fBlksize(0),
     fNBlock(),
-    fWProt(false)
-{}
+    fWProt(false),
+    fRaWindow(kRaWindowDef),
+    fRaNext(0),
+    fRaBeg(0),
+    fRaEnd(0)
+{
+  fStats.Define(kStatNRaSeq,  "NRaSeq",  "sequential reads");
+  fStats.Define(kStatNRaHit,  "NRaHit",  "seq reads within read-ahead");
+  fStats.Define(kStatNRaMiss, "NRaMiss", "seq reads not read ahead");
+  fStats.Define(kStatNRaHint, "NRaHint", "read-ahead requests");
+  fStats.Define(kStatNRaBlk,  "NRaBlk",  "blocks requested read-ahead");
+}
 
 //------------------------------------------+-----------------------------------
 //! Destructor
 
 Rw11UnitDisk::~Rw11UnitDisk()
-{}
+{
+  if (HasVirt())                            // write back while virt intact
+    Rtools::Catch2Cerr(__func__, [this](){
+        Server().IoPool().Drain();          // no I/O jobs may use the cache
+        Virt().CacheDetach();
+      } );
+}
 
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
@@ -72,7 +99,9 @@ bool Rw11UnitDisk::VirtRead(size_t lba, size_t nblk, uint8_t* data,
     emsg.Init("Rw11UnitDisk::VirtRead", "no disk attached");
     return false;
   }
-  return Virt().Read(lba, nblk, data, emsg);
+  bool rc = Virt().CachedRead(lba, nblk, data, emsg);
+  if (rc && fRaWindow > 0) ReadAheadCheck(lba, nblk);
+  return rc;
 }
 
 //------------------------------------------+-----------------------------------
@@ -85,7 +114,59 @@ bool Rw11UnitDisk::VirtWrite(size_t lba, size_t nblk, const uint8_t* data,
     emsg.Init("Rw11UnitDisk::VirtWrite", "no disk attached");
     return false;
   }
-  return Virt().Write(lba, nblk, data, emsg);
+  return Virt().CachedWrite(lba, nblk, data, emsg);
+}
+
+//------------------------------------------+-----------------------------------
+//! Write back and release cached blocks before the disk is detached
+
+void Rw11UnitDisk::DetachCleanup()
+{
+  Virt().CacheDetach();
+  fRaNext = 0;
+  fRaBeg  = 0;
+  fRaEnd  = 0;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Detect sequential reads and request read-ahead from the backend
+/*!
+  A read starting at the block following the previous read continues a
+  sequential stream. For such reads the window of fRaWindow blocks after
+  the read is requested with Rw11VirtDisk::ReadAhead(), which starts an
+  asynchronous read-in. A new request is made when less than half of the
+  window is left ahead, so a stream is prefetched in half window steps.
+  A non-sequential read ends the stream.
+ */
+
+void Rw11UnitDisk::ReadAheadCheck(size_t lba, size_t nblk)
+{
+  size_t end = lba + nblk;
+  if (lba == fRaNext) {                     // sequential read
+    fStats.Inc(kStatNRaSeq);
+    if (lba >= fRaBeg && end <= fRaEnd) {
+      fStats.Inc(kStatNRaHit);
+    } else {
+      fStats.Inc(kStatNRaMiss);
+    }
+    if (fRaEnd < end + fRaWindow/2) {       // less than half window left
+      size_t beg  = max(fRaEnd, end);
+      size_t last = min(end + fRaWindow, fNBlock);
+      if (last > beg) {
+        if (fRaEnd < end) fRaBeg = end;     // new range, else extend
+        fRaEnd = last;
+        Virt().ReadAhead(beg, last-beg);
+        fStats.Inc(kStatNRaHint);
+        fStats.Inc(kStatNRaBlk, double(last-beg));
+      }
+    }
+  } else {                                  // stream broken
+    fRaBeg = 0;
+    fRaEnd = 0;
+  }
+  fRaNext = end;
+  return;
 }
 
 //------------------------------------------+-----------------------------------
@@ -104,6 +185,10 @@ void Rw11UnitDisk::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fBlksize:        " << fBlksize << endl;
   os << bl << "  fNBlock:         " << fNBlock  << endl;
   os << bl << "  fWProt:          " << RosPrintf(fWProt) << endl;
+  os << bl << "  fRaWindow:       " << fRaWindow << endl;
+  os << bl << "  fRaNext:         " << fRaNext  << endl;
+  os << bl << "  fRaBeg:          " << fRaBeg   << endl;
+  os << bl << "  fRaEnd:          " << fRaEnd   << endl;
 
   Rw11UnitVirt<Rw11VirtDisk>::Dump(os, ind, " ^", detail);
   return;
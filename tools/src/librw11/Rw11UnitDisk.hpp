@@ -1,9 +1,11 @@
 // $Id: Rw11UnitDisk.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2017 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.2    add read-ahead (SetReadAhead(), stats)
+// 2026-10-18  1225   1.1    add DetachCleanup()
 // 2017-04-07   868   1.0.3  Dump(): add detail arg
 // 2015-03-21   659   1.0.2  add fEnabled, Enabled()
 // 2015-02-18   647   1.0.1  add Nwrd2Nblk()
@@ -48,6 +50,9 @@ namespace Retro {
       void          SetWProt(bool wprot);
       bool          WProt() const;
 
+      void          SetReadAhead(size_t nblk);
+      size_t        ReadAhead() const;
+
       bool          VirtRead(size_t lba, size_t nblk, uint8_t* data, 
                              RerrMsg& emsg);
       bool          VirtWrite(size_t lba, size_t nblk, const uint8_t* data, 
@@ -56,6 +61,23 @@ namespace Retro {
       virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
                          int detail=0) const;
 
+    // some constants (also defined in cpp)
+      static const size_t kRaWindowDef = 32; //!< default read-ahead window
+
+    // statistics counter indices
+      enum stats {
+        kStatNRaSeq = Rw11Unit::kDimStat,   //!< sequential reads
+        kStatNRaHit,                        //!< seq reads within read-ahead
+        kStatNRaMiss,                       //!< seq reads not read ahead
+        kStatNRaHint,                       //!< read-ahead requests
+        kStatNRaBlk,                        //!< blocks requested read-ahead
+        kDimStat
+      };
+
+    protected:
+      virtual void  DetachCleanup();
+      void          ReadAheadCheck(size_t lba, size_t nblk);
+
     protected:
       std::string   fType;                  //!< drive type
       bool          fEnabled;               //!< unit enabled
@@ -65,6 +87,10 @@ namespace Retro {
       size_t        fBlksize;               //!< block size (in bytes)
       size_t        fNBlock;                //!< # blocks
       bool          fWProt;                 //!< unit write protected
+      size_t        fRaWindow;              //!< read-ahead window (blocks)
+      size_t        fRaNext;                //!< next lba of sequential read
+      size_t        fRaBeg;                 //!< begin of read-ahead range
+      size_t        fRaEnd;                 //!< end of read-ahead range
   };
   
 } // end namespace Retro
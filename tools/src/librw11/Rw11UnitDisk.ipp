@@ -1,9 +1,10 @@
 // $Id: Rw11UnitDisk.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2015 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.1    add SetReadAhead(),ReadAhead()
 // 2015-03-21   659   1.0.2  add fEnabled, Enabled()
 // 2015-02-18   647   1.0.1  add Nwrd2Nblk()
 // 2013-04-19   507   1.0    Initial version
@@ -118,5 +119,22 @@ inline bool Rw11UnitDisk::WProt() const
   return fWProt;
 }
 
+//------------------------------------------+-----------------------------------
+//! Set read-ahead window in blocks, 0 disables read-ahead
+
+inline void Rw11UnitDisk::SetReadAhead(size_t nblk)
+{
+  fRaWindow = nblk;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns read-ahead window in blocks
+
+inline size_t Rw11UnitDisk::ReadAhead() const
+{
+  return fRaWindow;
+}
+
 
 } // end namespace Retro
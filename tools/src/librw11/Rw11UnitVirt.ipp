@@ -1,9 +1,10 @@
 // $Id: Rw11UnitVirt.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1214   1.4.2  Detach(): drain I/O worker pool
 // 2018-12-17  1085   1.4.1  use std::lock_guard instead of boost
 // 2018-12-09  1080   1.4    add HasVirt(); return ref for Virt()
 // 2018-12-01  1076   1.3    use unique_ptr instead of scoped_ptr
@@ -111,6 +112,7 @@ inline void Rw11UnitVirt<TV>::Detach()
   // synchronize with server thread
   std::lock_guard<RlinkConnect> lock(Connect());
   if (!fupVirt) return;
+  Server().IoPool().Drain();                // no I/O jobs may use fupVirt
   DetachCleanup();
   fupVirt.reset();
   DetachDone();
@@ -1,9 +1,12 @@
 // $Id: Rw11VirtDisk.cpp 1190 2019-07-13 17:05:39Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.7    add ReadAhead()
+// 2026-10-18  1225   1.6    add block cache support (url opt cache=)
+// 2026-10-18  1224   1.5    add Rw11VirtDiskMmap (scheme mmap:)
 // 2019-06-21  1167   1.4.1  remove dtor
 // 2018-12-02  1076   1.4    use unique_ptr for New()
 // 2018-10-27  1061   1.3    add fNCyl,fNHead,fNSect; add Rw11VirtDiskRam
@@ -17,14 +20,20 @@
 /*!
   \brief   Implemenation of Rw11VirtDisk.
 */
+#include <stdlib.h>
+
 #include <memory>
 
 #include "librtools/RosFill.hpp"
+#include "librtools/RosPrintf.hpp"
+#include "librtools/RlogMsg.hpp"
 #include "librtools/RparseUrl.hpp"
 #include "librtools/Rexception.hpp"
 #include "Rw11VirtDiskFile.hpp"
+#include "Rw11VirtDiskMmap.hpp"
 #include "Rw11VirtDiskOver.hpp"
 #include "Rw11VirtDiskRam.hpp"
+#include "Rw11.hpp"
 
 #include "Rw11VirtDisk.hpp"
 
@@ -52,12 +61,146 @@ Rw11VirtDisk::Rw11VirtDisk(Rw11Unit* punit)
     fNBlock(0),
     fNCyl(0),
     fNHead(0),
-    fNSect(0)
+    fNSect(0),
+    fspCache(),
+    fCacheWB(false)
 {
   fStats.Define(kStatNVDRead,    "NVDRead",     "Read() calls");
   fStats.Define(kStatNVDReadBlk, "NVDReadBlk",  "blocks read");
   fStats.Define(kStatNVDWrite,   "NVDWrite",    "Write() calls");
   fStats.Define(kStatNVDWriteBlk,"NVDWriteBlk", "blocks written");
+  fStats.Define(kStatNVDCHit,    "NVDCHit",     "blocks read from cache");
+  fStats.Define(kStatNVDCMiss,   "NVDCMiss",    "blocks missed in cache");
+}
+
+//------------------------------------------+-----------------------------------
+//! Destructor, drops the blocks still held by the cache
+
+Rw11VirtDisk::~Rw11VirtDisk()
+{
+  if (fspCache) fspCache->Drop(this);
+}
+
+//------------------------------------------+-----------------------------------
+//! Hint that blocks \a lba to \a lba+nblk-1 will be read soon
+/*!
+  Must not block. The default does nothing, backends which can start an
+  asynchronous read-in of the blocks override it.
+ */
+
+void Rw11VirtDisk::ReadAhead(size_t /*lba*/, size_t /*nblk*/)
+{}
+
+//------------------------------------------+-----------------------------------
+//! Use block cache \a spcache, in write-back mode if \a wb is \c true
+
+void Rw11VirtDisk::SetCache(const std::shared_ptr<Rw11VirtDiskCache>& spcache,
+                            bool wb)
+{
+  if (fspCache && fspCache != spcache) CacheDetach();
+  fspCache = spcache;
+  fCacheWB = wb;
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Setup cache from url option value \a val
+/*!
+  The value has the form \c size[,mode], \c size is given in bytes with
+  an optional \c k, \c M or \c G suffix, \c mode is \c wt for
+  write-through (default) or \c wb for write-back. The cache is shared by
+  all disks of the system, its capacity is raised to \c size when needed.
+ */
+
+bool Rw11VirtDisk::SetupCache(const std::string& val, RerrMsg& emsg)
+{
+  string ssize = val;
+  string smode = "wt";
+  size_t pdel  = val.find(',');
+  if (pdel != string::npos) {
+    ssize = val.substr(0, pdel);
+    smode = val.substr(pdel+1);
+  }
+  if (smode != "wt" && smode != "wb") {
+    emsg.Init("Rw11VirtDisk::SetupCache()",
+              string("invalid cache mode '") + smode + "', use 'wt' or 'wb'");
+    return false;
+  }
+
+  char* pend = nullptr;
+  size_t size = ::strtoul(ssize.c_str(), &pend, 10);
+  if (pend != ssize.c_str()) {
+    switch (*pend) {
+      case 'k': case 'K': size <<= 10; pend += 1; break;
+      case 'M':           size <<= 20; pend += 1; break;
+      case 'G':           size <<= 30; pend += 1; break;
+      default: break;
+    }
+  }
+  if (pend == ssize.c_str() || *pend != 0 || size == 0) {
+    emsg.Init("Rw11VirtDisk::SetupCache()",
+              string("invalid cache size '") + ssize + "'");
+    return false;
+  }
+
+  Rw11VirtDiskCache& cache = W11().DiskCache();
+  if (cache.Size() < size) cache.SetSize(size);
+  SetCache(W11().DiskCacheSPtr(), smode == "wb");
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Read blocks, through the cache if one is used
+
+bool Rw11VirtDisk::CachedRead(size_t lba, size_t nblk, uint8_t* data, 
+                              RerrMsg& emsg)
+{
+  if (!fspCache) return Read(lba, nblk, data, emsg);
+  size_t nhit = 0;
+  bool rc = fspCache->Read(*this, lba, nblk, data, nhit, emsg);
+  fStats.Inc(kStatNVDCHit,  double(nhit));
+  if (rc) fStats.Inc(kStatNVDCMiss, double(nblk-nhit));
+  return rc;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write blocks, through the cache if one is used
+
+bool Rw11VirtDisk::CachedWrite(size_t lba, size_t nblk, const uint8_t* data, 
+                               RerrMsg& emsg)
+{
+  if (!fspCache) return Write(lba, nblk, data, emsg);
+  return fspCache->Write(*this, lba, nblk, data, fCacheWB, emsg);
+}
+
+//------------------------------------------+-----------------------------------
+//! Write all dirty cache blocks of this disk to the backend
+
+bool Rw11VirtDisk::CacheFlush(RerrMsg& emsg)
+{
+  if (!fspCache) return true;
+  return fspCache->Flush(this, emsg);
+}
+
+//------------------------------------------+-----------------------------------
+//! Flush and drop all cache blocks of this disk and stop using the cache
+/*!
+  Called before the disk is detached. A failed flush is logged, the dirty
+  blocks are discarded in that case.
+ */
+
+void Rw11VirtDisk::CacheDetach()
+{
+  if (!fspCache) return;
+  RerrMsg emsg;
+  if (!fspCache->Flush(this, emsg)) {
+    RlogMsg lmsg(LogFile());
+    lmsg << "-E Rw11VirtDisk: cache flush failed for '" << fUrl.Url() 
+         << "': " << emsg << endl;
+  }
+  fspCache->Drop(this);
+  fspCache.reset();
+  return;
 }
 
 //------------------------------------------+-----------------------------------
@@ -74,6 +217,8 @@ void Rw11VirtDisk::Dump(std::ostream& os, int ind, const char* text,
   os << bl << "  fNCyl:           " << fNCyl   << endl;
   os << bl << "  fNHead:          " << fNHead  << endl;
   os << bl << "  fNSect:          " << fNSect  << endl;
+  os << bl << "  fspCache:        " << fspCache.get() << endl;
+  os << bl << "  fCacheWB:        " << RosPrintf(fCacheWB) << endl;
   Rw11Virt::Dump(os, ind, " ^", detail);
   return;
 }
@@ -96,6 +241,10 @@ std::unique_ptr<Rw11VirtDisk> Rw11VirtDisk::New(const std::string& url,
     up.reset(new Rw11VirtDiskOver(punit));
     if (!up->Open(url, emsg)) up.reset();
 
+  } else if (scheme == "mmap") {            // scheme -> mmap:
+    up.reset(new Rw11VirtDiskMmap(punit));
+    if (!up->Open(url, emsg)) up.reset();
+
   } else if (scheme == "ram") {             // scheme -> ram:
     up.reset(new Rw11VirtDiskRam(punit));
     if (!up->Open(url, emsg)) up.reset();
@@ -105,6 +254,11 @@ std::unique_ptr<Rw11VirtDisk> Rw11VirtDisk::New(const std::string& url,
               "' is not supported");
   }
 
+  string cval;
+  if (up && up->Url().FindOpt("cache", cval)) { // setup block cache
+    if (!up->SetupCache(cval, emsg)) up.reset();
+  }
+
   return up;
 }
 
@@ -120,9 +274,9 @@ const std::string& Rw11VirtDisk::DefaultScheme()
 
 void Rw11VirtDisk::SetDefaultScheme(const std::string& scheme)
 {
-  if (scheme != "file" && scheme != "over")
+  if (scheme != "file" && scheme != "over" && scheme != "mmap")
     throw Rexception("Rw11VirtDisk::SetDefaultScheme",
-                     "only 'file' or 'over' allowed");
+                     "only 'file', 'over' or 'mmap' allowed");
     
   sDefaultScheme = scheme;
   return;
@@ -1,9 +1,11 @@
 // $Id: Rw11VirtDisk.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.5    add ReadAhead()
+// 2026-10-18  1225   1.4    add block cache support; add dtor
 // 2019-06-21  1167   1.3.1  remove dtor
 // 2018-12-02  1076   1.3    use unique_ptr for New()
 // 2018-10-27  1061   1.2    add fNCyl,fNHead,fNSect,NCylinder(),...
@@ -25,12 +27,14 @@
 #include <memory>
 
 #include "Rw11Virt.hpp"
+#include "Rw11VirtDiskCache.hpp"
 
 namespace Retro {
 
   class Rw11VirtDisk : public Rw11Virt {
     public:
       explicit      Rw11VirtDisk(Rw11Unit* punit);
+                   ~Rw11VirtDisk();
 
       void          Setup(size_t blksize, size_t nblock,
                           size_t ncyl, size_t nhead, size_t nsect);
@@ -44,6 +48,19 @@ namespace Retro {
                          RerrMsg& emsg) = 0;
       virtual bool  Write(size_t lba, size_t nblk, const uint8_t* data, 
                           RerrMsg& emsg) = 0;
+      virtual void  ReadAhead(size_t lba, size_t nblk);
+
+      void          SetCache(const std::shared_ptr<Rw11VirtDiskCache>& spcache,
+                             bool wb);
+      Rw11VirtDiskCache* Cache() const;
+      bool          CacheWB() const;
+      bool          SetupCache(const std::string& val, RerrMsg& emsg);
+      bool          CachedRead(size_t lba, size_t nblk, uint8_t* data, 
+                               RerrMsg& emsg);
+      bool          CachedWrite(size_t lba, size_t nblk, const uint8_t* data, 
+                                RerrMsg& emsg);
+      bool          CacheFlush(RerrMsg& emsg);
+      void          CacheDetach();
 
       virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
                          int detail=0) const;
@@ -60,6 +77,8 @@ namespace Retro {
         kStatNVDReadBlk,
         kStatNVDWrite,
         kStatNVDWriteBlk,
+        kStatNVDCHit,
+        kStatNVDCMiss,
         kDimStat
       };    
 
@@ -69,6 +88,8 @@ namespace Retro {
       size_t        fNCyl;                  //!< # cylinder
       size_t        fNHead;                 //!< # heads (aka surfaces)
       size_t        fNSect;                 //!< # sectors
+      std::shared_ptr<Rw11VirtDiskCache> fspCache; //!< block cache (or null)
+      bool          fCacheWB;               //!< cache in write-back mode
 
     protected:
       static std::string sDefaultScheme;     //!< default scheme
@@ -1,9 +1,10 @@
 // $Id: Rw11VirtDisk.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.2    add Cache(),CacheWB()
 // 2018-10-27  1061   1.1    add NCylinder(),NHead(),NSector()
 // 2013-03-03   494   1.0    Initial version
 // 2013-02-19   490   0.1    First draft
@@ -70,4 +71,20 @@ inline size_t Rw11VirtDisk::NSector() const
   return fNSect;
 }
 
+//------------------------------------------+-----------------------------------
+//! Returns block cache, \c nullptr if none used
+
+inline Rw11VirtDiskCache* Rw11VirtDisk::Cache() const
+{
+  return fspCache.get();
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns true if cache is used in write-back mode
+
+inline bool Rw11VirtDisk::CacheWB() const
+{
+  return fCacheWB;
+}
+
 } // end namespace Retro
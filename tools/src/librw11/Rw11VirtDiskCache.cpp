@@ -0,0 +1,389 @@
+// $Id: Rw11VirtDiskCache.cpp 1225 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1225   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of Rw11VirtDiskCache.
+*/
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "librtools/RosFill.hpp"
+#include "librtools/Rexception.hpp"
+#include "Rw11VirtDisk.hpp"
+
+#include "Rw11VirtDiskCache.hpp"
+
+using namespace std;
+
+/*!
+  \class Retro::Rw11VirtDiskCache
+  \brief Block cache shared by the virtual disks of a system.
+
+  Holds blocks of any number of Rw11VirtDisk backends, keyed by backend
+  and block number, up to a capacity given in bytes. Replacement uses
+  the CLOCK algorithm: each access sets a reference bit, the clock hand
+  clears it and evicts the first entry found without it.
+
+  Write() either writes through to the backend, or in write-back mode
+  only marks the blocks dirty. Dirty blocks are written by Flush() and
+  when evicted. Runs of consecutive blocks are read from and written to
+  the backend in one call.
+
+  All methods are thread safe. The lock is also held during backend I/O,
+  so all I/O of the backends using the cache is serialized. With a
+  capacity below the block size of a backend Read() and Write() go
+  directly to the backend.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+// constants definitions
+
+const size_t Rw11VirtDiskCache::kNoEntry;
+
+//------------------------------------------+-----------------------------------
+//! Constructor, \a size is capacity in bytes
+
+Rw11VirtDiskCache::Rw11VirtDiskCache(size_t size)
+  : fMutex(),
+    fSize(size),
+    fUsed(0),
+    fNDirty(0),
+    fHand(0),
+    fEntries(),
+    fFree(),
+    fMap(),
+    fStats()
+{
+  fStats.Define(kStatNRead ,  "NRead"  , "Read() calls");
+  fStats.Define(kStatNWrite,  "NWrite" , "Write() calls");
+  fStats.Define(kStatNHit  ,  "NHit"   , "blocks found in cache");
+  fStats.Define(kStatNMiss ,  "NMiss"  , "blocks read from backend");
+  fStats.Define(kStatNEvict,  "NEvict" , "blocks evicted");
+  fStats.Define(kStatNWBack,  "NWBack" , "dirty blocks written back");
+  fStats.Define(kStatNFlush,  "NFlush" , "Flush() calls");
+  fStats.Define(kStatNBlock,  "NBlock" , "blocks in cache");
+  fStats.Define(kStatNDirty,  "NDirty" , "dirty blocks");
+}
+
+//------------------------------------------+-----------------------------------
+//! Destructor
+
+Rw11VirtDiskCache::~Rw11VirtDiskCache()
+{}
+
+//------------------------------------------+-----------------------------------
+//! Set capacity in bytes, evicts entries when shrinking
+
+void Rw11VirtDiskCache::SetSize(size_t size)
+{
+  lock_guard<mutex> lock(fMutex);
+  fSize = size;
+  RerrMsg emsg;
+  while (fUsed > fSize) {
+    if (!Evict(emsg)) throw Rexception(emsg);
+  }
+  UpdateGauges();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Read \a nblk blocks starting at \a lba from \a virt through the cache
+/*!
+  \param virt  backend
+  \param lba   first block
+  \param nblk  number of blocks
+  \param data  buffer for \a nblk blocks
+  \param nhit  returns number of blocks found in cache
+  \param emsg  error message in case of failure
+
+  \returns \c true on success, \c false otherwise
+ */
+
+bool Rw11VirtDiskCache::Read(Rw11VirtDisk& virt, size_t lba, size_t nblk,
+                             uint8_t* data, size_t& nhit, RerrMsg& emsg)
+{
+  lock_guard<mutex> lock(fMutex);
+  fStats.Inc(kStatNRead);
+  nhit = 0;
+
+  size_t bsize = virt.BlockSize();
+  if (fSize < bsize) return virt.Read(lba, nblk, data, emsg);
+
+  vector<bool> miss(nblk, false);
+  for (size_t i=0; i<nblk; i++) {
+    size_t ind = Find(virt, lba+i);
+    if (ind == kNoEntry) {
+      miss[i] = true;
+    } else {
+      Entry& e = fEntries[ind];
+      ::memcpy(data+i*bsize, e.fData.data(), bsize);
+      e.fRef = true;
+      nhit += 1;
+    }
+  }
+  fStats.Inc(kStatNHit, double(nhit));
+
+  size_t i = 0;
+  while (i < nblk) {                        // read runs of missing blocks
+    if (!miss[i]) {
+      i += 1;
+      continue;
+    }
+    size_t ibeg = i;
+    while (i < nblk && miss[i]) i += 1;
+    uint8_t* pbeg = data + ibeg*bsize;
+    if (!virt.Read(lba+ibeg, i-ibeg, pbeg, emsg)) return false;
+    fStats.Inc(kStatNMiss, double(i-ibeg));
+    for (size_t j=ibeg; j<i; j++) {
+      if (!Insert(virt, lba+j, data+j*bsize, false, emsg)) return false;
+    }
+  }
+
+  UpdateGauges();
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write \a nblk blocks starting at \a lba to \a virt through the cache
+/*!
+  \param virt  backend
+  \param lba   first block
+  \param nblk  number of blocks
+  \param data  buffer with \a nblk blocks
+  \param wb    if \c true write-back, blocks are only marked dirty
+  \param emsg  error message in case of failure
+
+  \returns \c true on success, \c false otherwise
+ */
+
+bool Rw11VirtDiskCache::Write(Rw11VirtDisk& virt, size_t lba, size_t nblk,
+                              const uint8_t* data, bool wb, RerrMsg& emsg)
+{
+  lock_guard<mutex> lock(fMutex);
+  fStats.Inc(kStatNWrite);
+
+  size_t bsize = virt.BlockSize();
+  if (fSize < bsize) return virt.Write(lba, nblk, data, emsg);
+
+  if (!wb && !virt.Write(lba, nblk, data, emsg)) return false;
+
+  for (size_t i=0; i<nblk; i++) {
+    size_t ind = Find(virt, lba+i);
+    if (ind == kNoEntry) {
+      if (!Insert(virt, lba+i, data+i*bsize, wb, emsg)) return false;
+    } else {
+      Entry& e = fEntries[ind];
+      ::memcpy(e.fData.data(), data+i*bsize, bsize);
+      e.fRef = true;
+      if (wb != e.fDirty) {
+        e.fDirty = wb;
+        if (wb) fNDirty += 1; else fNDirty -= 1;
+      }
+    }
+  }
+
+  UpdateGauges();
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write dirty blocks of \a pvirt, or of all backends if \c nullptr
+
+bool Rw11VirtDiskCache::Flush(Rw11VirtDisk* pvirt, RerrMsg& emsg)
+{
+  lock_guard<mutex> lock(fMutex);
+  fStats.Inc(kStatNFlush);
+  bool rc = FlushLocked(pvirt, emsg);
+  UpdateGauges();
+  return rc;
+}
+
+//------------------------------------------+-----------------------------------
+//! Remove all blocks of \a pvirt, dirty blocks are discarded
+
+void Rw11VirtDiskCache::Drop(Rw11VirtDisk* pvirt)
+{
+  lock_guard<mutex> lock(fMutex);
+  for (size_t i=0; i<fEntries.size(); i++) {
+    Entry& e = fEntries[i];
+    if (e.fpVirt != pvirt) continue;
+    Free(i);
+    vector<uint8_t>().swap(e.fData);        // release buffer
+  }
+  UpdateGauges();
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void Rw11VirtDiskCache::Dump(std::ostream& os, int ind, const char* text,
+                             int detail) const
+{
+  lock_guard<mutex> lock(fMutex);
+  RosFill bl(ind);
+  os << bl << (text?text:"--") << "Rw11VirtDiskCache @ " << this << endl;
+  os << bl << "  fSize:           " << fSize << endl;
+  os << bl << "  fUsed:           " << fUsed << endl;
+  os << bl << "  fNDirty:         " << fNDirty << endl;
+  os << bl << "  fHand:           " << fHand << endl;
+  os << bl << "  fEntries.size:   " << fEntries.size() << endl;
+  os << bl << "  fFree.size:      " << fFree.size() << endl;
+  os << bl << "  fMap.size:       " << fMap.size() << endl;
+  fStats.Dump(os, ind+2, "fStats: ", detail-1);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns entry index of block \a lba of \a virt, or kNoEntry
+
+size_t Rw11VirtDiskCache::Find(const Rw11VirtDisk& virt, size_t lba) const
+{
+  auto it = fMap.find(Key{&virt, lba});
+  return it != fMap.end() ? it->second : kNoEntry;
+}
+
+//------------------------------------------+-----------------------------------
+//! Add block \a lba of \a virt, evicts entries to make room
+
+bool Rw11VirtDiskCache::Insert(Rw11VirtDisk& virt, size_t lba,
+                               const uint8_t* data, bool dirty, RerrMsg& emsg)
+{
+  size_t bsize = virt.BlockSize();
+  while (fUsed + bsize > fSize) {
+    if (!Evict(emsg)) return false;
+  }
+
+  size_t ind;
+  if (fFree.size()) {
+    ind = fFree.back();
+    fFree.pop_back();
+  } else {
+    ind = fEntries.size();
+    fEntries.push_back(Entry{nullptr, 0, false, false, {}});
+  }
+
+  Entry& e = fEntries[ind];
+  e.fpVirt = &virt;
+  e.fLba   = lba;
+  e.fRef   = false;
+  e.fDirty = dirty;
+  e.fData.assign(data, data+bsize);
+  fMap.emplace(Key{&virt, lba}, ind);
+  fUsed += bsize;
+  if (dirty) fNDirty += 1;
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Evict one entry, writes it back when dirty
+/*!
+  The clock hand skips and clears referenced entries, so after at most
+  two sweeps an entry is found. Must only be called with entries in use.
+ */
+
+bool Rw11VirtDiskCache::Evict(RerrMsg& emsg)
+{
+  size_t nent = fEntries.size();
+  for (size_t n=0; n<2*nent; n++) {
+    size_t ind = fHand;
+    fHand = (fHand+1 < nent) ? fHand+1 : 0;
+    Entry& e = fEntries[ind];
+    if (e.fpVirt == nullptr) continue;
+    if (e.fRef) {
+      e.fRef = false;
+      continue;
+    }
+    if (e.fDirty) {
+      if (!e.fpVirt->Write(e.fLba, 1, e.fData.data(), emsg)) return false;
+      fStats.Inc(kStatNWBack);
+    }
+    Free(ind);
+    fStats.Inc(kStatNEvict);
+    return true;
+  }
+  throw Rexception("Rw11VirtDiskCache::Evict()", "Bad state: no entry found");
+}
+
+//------------------------------------------+-----------------------------------
+//! Release entry \a ind, keeps the data buffer for reuse
+
+void Rw11VirtDiskCache::Free(size_t ind)
+{
+  Entry& e = fEntries[ind];
+  fMap.erase(Key{e.fpVirt, e.fLba});
+  fUsed -= e.fData.size();
+  if (e.fDirty) fNDirty -= 1;
+  e.fpVirt = nullptr;
+  e.fRef   = false;
+  e.fDirty = false;
+  fFree.push_back(ind);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write dirty blocks, must be called with fMutex held
+/*!
+  The dirty blocks are sorted by backend and block number and runs of
+  consecutive blocks are written with one backend call.
+ */
+
+bool Rw11VirtDiskCache::FlushLocked(Rw11VirtDisk* pvirt, RerrMsg& emsg)
+{
+  vector<size_t> dirty;
+  for (size_t i=0; i<fEntries.size(); i++) {
+    const Entry& e = fEntries[i];
+    if (e.fDirty && (pvirt == nullptr || e.fpVirt == pvirt)) dirty.push_back(i);
+  }
+  sort(dirty.begin(), dirty.end(),
+       [this](size_t lhs, size_t rhs) {
+         const Entry& l = fEntries[lhs];
+         const Entry& r = fEntries[rhs];
+         return (l.fpVirt != r.fpVirt) ? (l.fpVirt < r.fpVirt)
+                                       : (l.fLba < r.fLba);
+       });
+
+  vector<uint8_t> buf;
+  size_t i = 0;
+  while (i < dirty.size()) {
+    Entry& ebeg = fEntries[dirty[i]];
+    size_t bsize = ebeg.fData.size();
+    size_t ibeg = i;
+    buf.clear();
+    while (i < dirty.size()) {
+      const Entry& e = fEntries[dirty[i]];
+      if (e.fpVirt != ebeg.fpVirt || e.fLba != ebeg.fLba + (i-ibeg)) break;
+      buf.insert(buf.end(), e.fData.begin(), e.fData.end());
+      i += 1;
+    }
+    if (!ebeg.fpVirt->Write(ebeg.fLba, buf.size()/bsize, buf.data(), emsg))
+      return false;
+    for (size_t j=ibeg; j<i; j++) fEntries[dirty[j]].fDirty = false;
+    fNDirty -= i-ibeg;
+    fStats.Inc(kStatNWBack, double(i-ibeg));
+  }
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Update gauge counters
+
+void Rw11VirtDiskCache::UpdateGauges()
+{
+  fStats.Set(kStatNBlock, double(fMap.size()));
+  fStats.Set(kStatNDirty, double(fNDirty));
+  return;
+}
+
+} // end namespace Retro
@@ -0,0 +1,118 @@
+// $Id: Rw11VirtDiskCache.hpp 1225 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1225   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class Rw11VirtDiskCache.
+*/
+
+#ifndef included_Retro_Rw11VirtDiskCache
+#define included_Retro_Rw11VirtDiskCache 1
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+#include <ostream>
+
+#include "librtools/RerrMsg.hpp"
+#include "librtools/Rstats.hpp"
+
+namespace Retro {
+
+  class Rw11VirtDisk;                       // forw decl to avoid circular incl
+
+  class Rw11VirtDiskCache {
+    public:
+
+      explicit      Rw11VirtDiskCache(size_t size=0);
+                   ~Rw11VirtDiskCache();
+
+                    Rw11VirtDiskCache(const Rw11VirtDiskCache&) = delete;
+      Rw11VirtDiskCache& operator=(const Rw11VirtDiskCache&) = delete;
+
+      void          SetSize(size_t size);
+      size_t        Size() const;
+      size_t        NBlock() const;
+      size_t        NDirty() const;
+
+      bool          Read(Rw11VirtDisk& virt, size_t lba, size_t nblk,
+                         uint8_t* data, size_t& nhit, RerrMsg& emsg);
+      bool          Write(Rw11VirtDisk& virt, size_t lba, size_t nblk,
+                          const uint8_t* data, bool wb, RerrMsg& emsg);
+      bool          Flush(Rw11VirtDisk* pvirt, RerrMsg& emsg);
+      void          Drop(Rw11VirtDisk* pvirt);
+
+      Rstats&       Stats();
+      void          Dump(std::ostream& os, int ind=0, const char* text=0,
+                         int detail=0) const;
+
+    // statistics counter indices
+      enum stats {
+        kStatNRead = 0,                     //!< Read() calls
+        kStatNWrite,                        //!< Write() calls
+        kStatNHit,                          //!< blocks found in cache
+        kStatNMiss,                         //!< blocks read from backend
+        kStatNEvict,                        //!< blocks evicted
+        kStatNWBack,                        //!< dirty blocks written back
+        kStatNFlush,                        //!< Flush() calls
+        kStatNBlock,                        //!< blocks in cache (gauge)
+        kStatNDirty,                        //!< dirty blocks (gauge)
+        kDimStat
+      };
+
+    protected:
+      static const size_t kNoEntry = size_t(-1);  //!< Find() miss return
+
+      struct Key {
+        const Rw11VirtDisk* fpVirt;         //!< backend
+        size_t      fLba;                   //!< block number
+        bool        operator==(const Key& rhs) const;
+      };
+
+      struct KeyHash {
+        size_t      operator()(const Key& key) const;
+      };
+
+      struct Entry {
+        Rw11VirtDisk* fpVirt;               //!< backend, nullptr if free
+        size_t      fLba;                   //!< block number
+        bool        fRef;                   //!< referenced since last sweep
+        bool        fDirty;                 //!< modified, not yet written
+        std::vector<uint8_t> fData;         //!< block data
+      };
+
+      typedef std::unordered_map<Key,size_t,KeyHash> map_t;
+
+      size_t        Find(const Rw11VirtDisk& virt, size_t lba) const;
+      bool          Insert(Rw11VirtDisk& virt, size_t lba, const uint8_t* data,
+                           bool dirty, RerrMsg& emsg);
+      bool          Evict(RerrMsg& emsg);
+      void          Free(size_t ind);
+      bool          FlushLocked(Rw11VirtDisk* pvirt, RerrMsg& emsg);
+      void          UpdateGauges();
+
+    protected:
+      mutable std::mutex fMutex;            //!< protects all state
+      size_t        fSize;                  //!< capacity in bytes
+      size_t        fUsed;                  //!< bytes held by entries
+      size_t        fNDirty;                //!< number of dirty entries
+      size_t        fHand;                  //!< clock hand
+      std::vector<Entry> fEntries;          //!< cache entries
+      std::vector<size_t> fFree;            //!< indices of free entries
+      map_t         fMap;                   //!< (virt,lba) -> entry index
+      Rstats        fStats;                 //!< statistics
+  };
+
+} // end namespace Retro
+
+#include "Rw11VirtDiskCache.ipp"
+
+#endif
@@ -0,0 +1,68 @@
+// $Id: Rw11VirtDiskCache.ipp 1225 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+//
+// Revision History:
+// Date         Rev Version  Comment
+// 2026-10-18  1225   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation (inline) of Rw11VirtDiskCache.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Returns cache capacity in bytes
+
+inline size_t Rw11VirtDiskCache::Size() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fSize;
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of cached blocks
+
+inline size_t Rw11VirtDiskCache::NBlock() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fMap.size();
+}
+
+//------------------------------------------+-----------------------------------
+//! Returns number of dirty blocks
+
+inline size_t Rw11VirtDiskCache::NDirty() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fNDirty;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline Rstats& Rw11VirtDiskCache::Stats()
+{
+  return fStats;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline bool Rw11VirtDiskCache::Key::operator==(const Key& rhs) const
+{
+  return fpVirt == rhs.fpVirt && fLba == rhs.fLba;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+inline size_t Rw11VirtDiskCache::KeyHash::operator()(const Key& key) const
+{
+  return std::hash<const void*>()(key.fpVirt) ^ (key.fLba * 0x9e3779b1u);
+}
+
+} // end namespace Retro
@@ -1,9 +1,11 @@
 // $Id: Rw11VirtDiskFile.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.3    add ReadAhead() (posix_fadvise)
+// 2026-10-18  1225   1.2.1  Open(): allow cache= option
 // 2019-06-21  1167   1.2    use RfileFd; remove dtor
 // 2018-09-22  1048   1.1.4  BUGFIX: coverity (resource leak)
 // 2018-09-16  1047   1.1.3  coverity fixup (uninitialized scalar)
@@ -18,6 +20,8 @@
   \brief   Implemenation of Rw11VirtDiskFile.
 */
 
+#include <fcntl.h>
+
 #include "librtools/RosFill.hpp"
 
 #include "Rw11VirtDiskFile.hpp"
@@ -55,7 +59,7 @@ bool Rw11VirtDiskFile::Open(const std::string& url, RerrMsg& emsg)
 bool Rw11VirtDiskFile::Open(const std::string& url, const std::string& scheme,
                             RerrMsg& emsg)
 {
-  if (!fUrl.Set(url, "|wpro|", scheme, emsg)) return false;
+  if (!fUrl.Set(url, "|wpro|cache=|", scheme, emsg)) return false;
   
   fWProt = fUrl.FindOpt("wpro");
 
@@ -122,6 +126,18 @@ bool Rw11VirtDiskFile::Write(size_t lba, size_t nblk, const uint8_t* data,
   return true;
 }
 
+//------------------------------------------+-----------------------------------
+//! Start asynchronous read-in of blocks into the page cache
+
+void Rw11VirtDiskFile::ReadAhead(size_t lba, size_t nblk)
+{
+  size_t pos  = fBlkSize * lba;
+  size_t nbyt = fBlkSize * nblk;
+  if (pos >= fSize) return;
+  ::posix_fadvise(fFd.Fd(), pos, nbyt, POSIX_FADV_WILLNEED);
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -1,9 +1,10 @@
 // $Id: Rw11VirtDiskFile.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.2    add ReadAhead()
 // 2019-06-21  1167   1.1    use RfileFd; remove dtor
 // 2017-04-15   875   1.0.2  Open(): add overload with scheme handling
 // 2017-04-07   868   1.0.1  Dump(): add detail arg
@@ -38,6 +39,7 @@ namespace Retro {
                          RerrMsg& emsg);
       virtual bool  Write(size_t lba, size_t nblk, const uint8_t* data, 
                           RerrMsg& emsg);
+      virtual void  ReadAhead(size_t lba, size_t nblk);
 
       virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
                          int detail=0) const;
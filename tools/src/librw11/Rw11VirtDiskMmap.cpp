@@ -0,0 +1,223 @@
+// $Id: Rw11VirtDiskMmap.cpp 1224 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// 
+// Revision History: 
+// Date         Rev Version  Comment
+// 2026-10-18  1226   1.1    add ReadAhead() (madvise)
+// 2026-10-18  1225   1.0.1  Open(): allow cache= option; Flush(): flush cache
+// 2026-10-18  1224   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of Rw11VirtDiskMmap.
+*/
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "librtools/RosFill.hpp"
+#include "Rw11UnitDisk.hpp"
+
+#include "Rw11VirtDiskMmap.hpp"
+
+using namespace std;
+
+/*!
+  \class Retro::Rw11VirtDiskMmap
+  \brief Disk image file accessed via a shared memory mapping.
+
+  The image file is mapped with its full disk size, a shorter file is
+  extended with ftruncate(), so the added part is sparse and reads as
+  zero. Read() and Write() copy directly from or to the mapping, without
+  any system call. A write protected file is mapped read-only with its
+  actual size, blocks beyond are read as zero.
+
+  The mapping is synchronized with msync() by Flush() and on detach.
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Default constructor
+
+Rw11VirtDiskMmap::Rw11VirtDiskMmap(Rw11Unit* punit)
+  : Rw11VirtDisk(punit),
+    fFd("Rw11VirtDiskMmap::fFd."),
+    fSize(0),
+    fMapSize(0),
+    fpMap(nullptr)
+{
+  fStats.Define(kStatNVDMFlush,    "NVDMFlush",    "mmap: Flush() calls");
+}
+
+//------------------------------------------+-----------------------------------
+//! Destructor
+
+Rw11VirtDiskMmap::~Rw11VirtDiskMmap()
+{
+  Unmap();
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+bool Rw11VirtDiskMmap::Open(const std::string& url, RerrMsg& emsg)
+{
+  if (!fUrl.Set(url, "|wpro|cache=|", "mmap", emsg)) return false;
+
+  // the disk size is known from the unit type, Setup() is called later
+  Rw11UnitDisk* punit = dynamic_cast<Rw11UnitDisk*>(fpUnit);
+  if (!punit) {
+    emsg.Init("Rw11VirtDiskMmap::Open()", "unit is not a disk");
+    return false;
+  }
+  size_t dsize = punit->BlockSize() * punit->NBlock();
+  
+  fWProt = fUrl.FindOpt("wpro");
+
+  if (!fFd.Open(fUrl.Path().c_str(),
+                fWProt ? O_RDONLY : O_RDWR, emsg)) return false;
+
+  struct stat sbuf;
+  if (!fFd.Stat(&sbuf, emsg)) {
+    fFd.Close();
+    return false;
+  }
+  
+  if ((sbuf.st_mode & S_IWUSR) == 0) fWProt = true;
+  fSize = sbuf.st_size;
+
+  if (!fWProt && fSize < dsize) {           // extend sparse to disk size
+    if (!fFd.Truncate(dsize, emsg)) {
+      fFd.Close();
+      return false;
+    }
+    fSize = dsize;
+  }
+
+  fMapSize = min(fSize, dsize);
+  if (fMapSize > 0) {
+    void* pmap = ::mmap(nullptr, fMapSize,
+                        fWProt ? PROT_READ : PROT_READ|PROT_WRITE,
+                        MAP_SHARED, fFd.Fd(), 0);
+    if (pmap == MAP_FAILED) {
+      emsg.InitErrno("Rw11VirtDiskMmap::Open()", "mmap() failed: ", errno);
+      fMapSize = 0;
+      fFd.Close();
+      return false;
+    }
+    fpMap = static_cast<uint8_t*>(pmap);
+    ::madvise(fpMap, fMapSize, MADV_WILLNEED); // start read-in of image
+  }
+
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+bool Rw11VirtDiskMmap::Read(size_t lba, size_t nblk, uint8_t* data, 
+                            RerrMsg& /*emsg*/)
+{
+  fStats.Inc(kStatNVDRead);
+  fStats.Inc(kStatNVDReadBlk, double(nblk));
+
+  size_t pos  = fBlkSize * lba;
+  size_t nbyt = fBlkSize * nblk;
+  size_t nmap = (pos < fMapSize) ? min(nbyt, fMapSize-pos) : 0;
+
+  if (nmap > 0)    ::memcpy(data, fpMap+pos, nmap);
+  if (nmap < nbyt) ::memset(data+nmap, 0, nbyt-nmap);
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+bool Rw11VirtDiskMmap::Write(size_t lba, size_t nblk, const uint8_t* data, 
+                             RerrMsg& emsg)
+{
+  fStats.Inc(kStatNVDWrite);
+  fStats.Inc(kStatNVDWriteBlk, double(nblk));
+
+  size_t pos  = fBlkSize * lba;
+  size_t nbyt = fBlkSize * nblk;
+
+  if (fWProt) {
+    emsg.Init("Rw11VirtDiskMmap::Write()", "file write protected");
+    return false;
+  }
+  if (pos+nbyt > fMapSize) {
+    emsg.Init("Rw11VirtDiskMmap::Write()", "write beyond end of mapping");
+    return false;
+  }
+
+  ::memcpy(fpMap+pos, data, nbyt);
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! Start asynchronous read-in of the mapped pages holding the blocks
+
+void Rw11VirtDiskMmap::ReadAhead(size_t lba, size_t nblk)
+{
+  size_t pos  = fBlkSize * lba;
+  if (pos >= fMapSize) return;
+  size_t pend = min(pos + fBlkSize*nblk, fMapSize);
+  size_t pmsk = size_t(::sysconf(_SC_PAGESIZE)) - 1;
+  pos &= ~pmsk;                             // madvise needs page alignment
+  ::madvise(fpMap+pos, pend-pos, MADV_WILLNEED);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write modified pages of the mapping back to the image file
+
+bool Rw11VirtDiskMmap::Flush(RerrMsg& emsg)
+{
+  fStats.Inc(kStatNVDMFlush);
+  if (!CacheFlush(emsg)) return false;      // dirty cache blocks to mapping
+  if (fpMap && !fWProt && ::msync(fpMap, fMapSize, MS_SYNC) < 0) {
+    emsg.InitErrno("Rw11VirtDiskMmap::Flush()", "msync() failed: ", errno);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+void Rw11VirtDiskMmap::Dump(std::ostream& os, int ind, const char* text,
+                            int detail) const
+{
+  RosFill bl(ind);
+  os << bl << (text?text:"--") << "Rw11VirtDiskMmap @ " << this << endl;
+
+  os << bl << "  fFd:             " << fFd.Fd() << endl;
+  os << bl << "  fSize:           " << fSize << endl;
+  os << bl << "  fMapSize:        " << fMapSize << endl;
+  os << bl << "  fpMap:           " << static_cast<void*>(fpMap) << endl;
+  Rw11VirtDisk::Dump(os, ind, " ^", detail);
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Synchronize and remove mapping
+
+void Rw11VirtDiskMmap::Unmap()
+{
+  if (!fpMap) return;
+  if (!fWProt) ::msync(fpMap, fMapSize, MS_SYNC);
+  ::munmap(fpMap, fMapSize);
+  fpMap    = nullptr;
+  fMapSize = 0;
+  return;
+}
+
+} // end namespace Retro
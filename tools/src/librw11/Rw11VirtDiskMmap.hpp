@@ -0,0 +1,64 @@
+// $Id: Rw11VirtDiskMmap.hpp 1224 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// 
+// Revision History: 
+// Date         Rev Version  Comment
+// 2026-10-18  1226   1.1    add ReadAhead()
+// 2026-10-18  1224   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class Rw11VirtDiskMmap.
+*/
+
+#ifndef included_Retro_Rw11VirtDiskMmap
+#define included_Retro_Rw11VirtDiskMmap 1
+
+#include "librtools/RfileFd.hpp"
+
+#include "Rw11VirtDisk.hpp"
+
+namespace Retro {
+
+  class Rw11VirtDiskMmap : public Rw11VirtDisk {
+    public:
+
+      explicit      Rw11VirtDiskMmap(Rw11Unit* punit);
+                   ~Rw11VirtDiskMmap();
+
+      virtual bool  Open(const std::string& url, RerrMsg& emsg);
+
+      virtual bool  Read(size_t lba, size_t nblk, uint8_t* data, 
+                         RerrMsg& emsg);
+      virtual bool  Write(size_t lba, size_t nblk, const uint8_t* data, 
+                          RerrMsg& emsg);
+      virtual void  ReadAhead(size_t lba, size_t nblk);
+
+      bool          Flush(RerrMsg& emsg);
+
+      virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
+                         int detail=0) const;
+
+    // statistics counter indices
+      enum stats {
+        kStatNVDMFlush = Rw11VirtDisk::kDimStat,
+        kDimStat
+      };
+
+    protected:
+      void          Unmap();
+
+    protected:
+      RfileFd       fFd;                    //!< image file
+      size_t        fSize;                  //!< image file size
+      size_t        fMapSize;               //!< size of mapping
+      uint8_t*      fpMap;                  //!< mapped image
+  };
+  
+} // end namespace Retro
+
+//#include "Rw11VirtDiskMmap.ipp"
+
+#endif
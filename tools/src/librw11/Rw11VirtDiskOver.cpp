@@ -1,9 +1,10 @@
 // $Id: Rw11VirtDiskOver.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2017-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2017-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.0.7  Flush(): flush block cache first
 // 2018-12-22  1091   1.0.6  Read(): it->it1 (-Wshadow fix)
 // 2017-06-05   907   1.0.5  more detailed stats
 // 2017-06-03   903   1.0.4  Read(): BUGFIX: fix index error in blockwise read
@@ -133,6 +134,7 @@ bool Rw11VirtDiskOver::Flush(RerrMsg& emsg)
   }
   
   fStats.Inc(kStatNVDOFlush);
+  if (!CacheFlush(emsg)) return false;      // dirty cache blocks to overlay
   for (auto& kv: fBlkMap) {
     bool rc = Rw11VirtDiskFile::Write(kv.first, 1, kv.second.Data(), emsg);
     if (!rc) return rc;
@@ -1,9 +1,10 @@
 // $Id: Rw11VirtDiskRam.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2018-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2018-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.1.1  Open(): allow cache= option
 // 2019-05-01  1143   1.1    add noboot option 
 // 2018-10-28  1063   1.0    Initial version
 // 2018-10-27  1061   0.1    First draft
@@ -68,7 +69,7 @@ bool Rw11VirtDiskRam::Open(const std::string& url, RerrMsg& emsg)
 bool Rw11VirtDiskRam::Open(const std::string& url, const std::string& scheme,
                             RerrMsg& emsg)
 {
-  if (!fUrl.Set(url, "|wpro|noboot|pat=|", scheme, emsg)) return false;
+  if (!fUrl.Set(url, "|wpro|noboot|pat=|cache=|", scheme, emsg)) return false;
   fWProt  = fUrl.FindOpt("wpro");
   fNoBoot = fUrl.FindOpt("noboot");
 
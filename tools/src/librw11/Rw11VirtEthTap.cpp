@@ -1,9 +1,10 @@
 // $Id: Rw11VirtEthTap.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2014-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2014-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.0.5  name poll handler call profile
 // 2019-02-23  1114   1.0.4  use std::bind instead of lambda
 // 2018-12-15  1082   1.0.3  use lambda instead of boost::bind
 // 2018-11-30  1075   1.0.2  use list-init
@@ -100,7 +101,7 @@ bool Rw11VirtEthTap::Open(const std::string& url, RerrMsg& emsg)
   fFd = fd;
 
   Server().AddPollHandler(bind(&Rw11VirtEthTap::RcvPollHandler, this, _1), 
-                          fFd, POLLIN);
+                          fFd, POLLIN, Unit().Name() + ".rcv");
   return true;
 }
 
@@ -1,9 +1,10 @@
 // $Id: Rw11VirtStream.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1214   1.2    Write(): use I/O worker pool
 // 2019-04-14  1131   1.1.2  add Error(),Eof()
 // 2018-12-19  1090   1.1.1  use RosPrintf(bool)
 // 2018-12-02  1076   1.1    use unique_ptr for New()
@@ -18,6 +19,7 @@
   \brief   Implemenation of Rw11VirtStream.
 */
 #include <memory>
+#include <functional>
 
 #include "librtools/Rtools.hpp"
 #include "librtools/Rexception.hpp"
@@ -44,7 +46,12 @@ Rw11VirtStream::Rw11VirtStream(Rw11Unit* punit)
   : Rw11Virt(punit),
     fIStream(false),
     fOStream(false),
-    fFile(0)
+    fFile(0),
+    fIoMutex(),
+    fIoCond(),
+    fIoBuf(),
+    fIoPending(false),
+    fIoErrno(0)
 {
   fStats.Define(kStatNVSRead,    "NVSRead",     "Read() calls");
   fStats.Define(kStatNVSReadByt, "NVSReadByt",  "bytes read");
@@ -53,6 +60,7 @@ Rw11VirtStream::Rw11VirtStream(Rw11Unit* punit)
   fStats.Define(kStatNVSFlush,   "NVSFlush",    "Flush() calls");
   fStats.Define(kStatNVSTell,    "NVSTell",     "Tell() calls");
   fStats.Define(kStatNVSSeek,    "NVSSeek",     "Seek() calls");
+  fStats.Define(kStatNVSIoJob,   "NVSIoJob",    "write jobs queued");
 }
 
 //------------------------------------------+-----------------------------------
@@ -60,6 +68,7 @@ Rw11VirtStream::Rw11VirtStream(Rw11Unit* punit)
 
 Rw11VirtStream::~Rw11VirtStream()
 {
+  WaitIo();
   if (fFile) ::fclose(fFile);
 }
 
@@ -121,7 +130,12 @@ int Rw11VirtStream::Read(uint8_t* data, size_t count, RerrMsg& emsg)
 }
 
 //------------------------------------------+-----------------------------------
-//! FIXME_docs
+//! Write data to stream.
+/*!
+  The data is buffered and written by a job of the server I/O worker pool,
+  at most one job is pending per stream, so the write order is kept. An
+  error of a write job is returned by the next Write() or Flush() call.
+ */
 
 bool Rw11VirtStream::Write(const uint8_t* data, size_t count, RerrMsg& emsg)
 {
@@ -132,13 +146,22 @@ bool Rw11VirtStream::Write(const uint8_t* data, size_t count, RerrMsg& emsg)
     throw Rexception("Rw11VirtStream::Write", "Bad state: file not open");
 
   fStats.Inc(kStatNVSWrite);
-  size_t irc = ::fwrite(data, 1, count, fFile);
-  if (irc != count) {
-    emsg.InitErrno("Rw11VirtStream::Write()", "fwrite() failed: ", errno);
-    return false;
+  {
+    lock_guard<mutex> lock(fIoMutex);
+    if (fIoErrno) {
+      emsg.InitErrno("Rw11VirtStream::Write()", "fwrite() failed: ", fIoErrno);
+      fIoErrno = 0;
+      return false;
+    }
+    fIoBuf.insert(fIoBuf.end(), data, data+count);
+    fStats.Inc(kStatNVSWriteByt, double(count));
+    if (fIoPending) return true;            // pending job will write it
+    fIoPending = true;
   }
 
-  fStats.Inc(kStatNVSWriteByt, double(count));
+  fStats.Inc(kStatNVSIoJob);
+  Server().IoPool().Submit(bind(&Rw11VirtStream::IoWrite, this),
+                           RworkerPool::done_t());
   return true;
 }
 
@@ -152,6 +175,12 @@ bool Rw11VirtStream::Flush(RerrMsg& emsg)
     throw Rexception("Rw11VirtStream::Write", "Bad state: file not open");
 
   fStats.Inc(kStatNVSFlush);
+  WaitIo();
+  if (fIoErrno) {
+    emsg.InitErrno("Rw11VirtStream::Flush()", "fwrite() failed: ", fIoErrno);
+    fIoErrno = 0;
+    return false;
+  }
   size_t irc = ::fflush(fFile);
   if (irc != 0) {
     emsg.InitErrno("Rw11VirtStream::Flush()", "fflush() failed: ", errno);
@@ -170,6 +199,7 @@ int Rw11VirtStream::Tell(RerrMsg& emsg)
     throw Rexception("Rw11VirtStream::Tell", "Bad state: file not open");
 
   fStats.Inc(kStatNVSTell);
+  WaitIo();
   long irc = ::ftell(fFile);
   if (irc < 0) {
     emsg.InitErrno("Rw11VirtStream::Tell()", "ftell() failed: ", errno);
@@ -188,6 +218,7 @@ bool Rw11VirtStream::Seek(int pos, RerrMsg& emsg)
     throw Rexception("Rw11VirtStream::Seek", "Bad state: file not open");
 
   fStats.Inc(kStatNVSSeek);
+  WaitIo();
   int whence = SEEK_SET;
   if (pos < 0) {
     pos = 0;
@@ -241,6 +272,37 @@ void Rw11VirtStream::Dump(std::ostream& os, int ind, const char* text,
   return;
 }
 
+//------------------------------------------+-----------------------------------
+//! Wait until the pending write job is done
+
+void Rw11VirtStream::WaitIo()
+{
+  unique_lock<mutex> lock(fIoMutex);
+  fIoCond.wait(lock, [this](){ return !fIoPending; });
+  return;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write job, called in I/O worker thread, writes until fIoBuf is empty
+
+void Rw11VirtStream::IoWrite()
+{
+  vector<uint8_t> buf;
+  unique_lock<mutex> lock(fIoMutex);
+  while (!fIoBuf.empty()) {
+    buf.swap(fIoBuf);
+    lock.unlock();
+    size_t irc = ::fwrite(buf.data(), 1, buf.size(), fFile);
+    int ierr = (irc != buf.size()) ? errno : 0;
+    buf.clear();
+    lock.lock();
+    if (ierr) fIoErrno = ierr;
+  }
+  fIoPending = false;
+  fIoCond.notify_all();
+  return;
+}
+
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
@@ -1,9 +1,10 @@
 // $Id: Rw11VirtStream.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1214   1.2    Write(): use I/O worker pool
 // 2019-04-14  1131   1.1.1  add Error(),Eof()
 // 2018-12-02  1076   1.1    use unique_ptr for New()
 // 2017-04-07   868   1.0.1  Dump(): add detail arg
@@ -21,6 +22,9 @@
 #include <stdio.h>
 
 #include <memory>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
 
 #include "Rw11Virt.hpp"
 
@@ -44,6 +48,8 @@ namespace Retro {
       virtual void  Dump(std::ostream& os, int ind=0, const char* text=0,
                          int detail=0) const;
 
+      void          WaitIo();
+
       static std::unique_ptr<Rw11VirtStream> New(const std::string& url,
                                                  Rw11Unit* punit,
                                                  RerrMsg& emsg);
@@ -57,13 +63,22 @@ namespace Retro {
         kStatNVSFlush,
         kStatNVSTell,
         kStatNVSSeek,
+        kStatNVSIoJob,
         kDimStat
       };    
 
+    protected:
+      void          IoWrite();
+
     protected:
       bool          fIStream;               //!< is input (read only) stream
       bool          fOStream;               //!< is output (write only) stream
       FILE*         fFile;                  //!< file ptr
+      std::mutex    fIoMutex;               //!< protects fIo* state
+      std::condition_variable fIoCond;      //!< signals fIoPending=false
+      std::vector<uint8_t> fIoBuf;          //!< data not yet written
+      bool          fIoPending;             //!< write job pending
+      int           fIoErrno;               //!< errno of failed write job
   };
   
 } // end namespace Retro
@@ -1,9 +1,10 @@
 // $Id: Rw11VirtTermPty.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.0.6  name poll handler call profile
 // 2019-02-23  1114   1.0.5  use std::bind instead of lambda
 // 2018-12-15  1082   1.0.4  use lambda instead of boost::bind
 // 2018-10-27  1059   1.0.3  coverity fixup (uncaught exception in dtor)
@@ -97,7 +98,7 @@ bool Rw11VirtTermPty::Open(const std::string& url, RerrMsg& emsg)
   fChannelId = pname;
 
   Server().AddPollHandler(bind(&Rw11VirtTermPty::RcvPollHandler, this, _1), 
-                          fFd, POLLIN);
+                          fFd, POLLIN, Unit().Name() + ".rcv");
 
   return true;
 }
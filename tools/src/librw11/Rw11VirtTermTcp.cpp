@@ -1,9 +1,10 @@
 // $Id: Rw11VirtTermTcp.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1220   1.0.15 name poll handler call profiles
 // 2019-02-23  1114   1.0.14 use std::bind instead of lambda
 // 2018-12-22  1091   1.0.13 pfd->pfd1 (-Wshadow fix)
 // 2018-12-19  1090   1.0.12 use RosPrintf(bool)
@@ -182,7 +183,7 @@ bool Rw11VirtTermTcp::Open(const std::string& url, RerrMsg& emsg)
   }
 
   Server().AddPollHandler(bind(&Rw11VirtTermTcp::ListenPollHandler, this, _1), 
-                          fFdListen, POLLIN);
+                          fFdListen, POLLIN, Unit().Name() + ".listen");
 
   return true;
 }
@@ -339,7 +340,7 @@ int Rw11VirtTermTcp::ListenPollHandler(const pollfd& pfd)
 
   Server().RemovePollHandler(fFdListen);
   Server().AddPollHandler(bind(&Rw11VirtTermTcp::RcvPollHandler, this, _1), 
-                          fFd, POLLIN);
+                          fFd, POLLIN, Unit().Name() + ".rcv");
   return 0;
 }
   
@@ -426,7 +427,7 @@ int Rw11VirtTermTcp::RcvPollHandler(const pollfd& pfd)
     ::close(fFd);
     fFd = -1;
     Server().AddPollHandler(bind(&Rw11VirtTermTcp::ListenPollHandler, this, _1), 
-                            fFdListen, POLLIN);    
+                            fFdListen, POLLIN, Unit().Name() + ".listen");
     fState = ts_Listen;
     return -1;
   }
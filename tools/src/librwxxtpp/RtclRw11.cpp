@@ -1,9 +1,10 @@
 // $Id: RtclRw11.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.1.1  add cachesize, M_cachestats,M_cacheflush
 // 2019-02-23  1114   1.0.7  use std::bind instead of lambda
 // 2018-12-17  1087   1.0.6  use std::lock_guard instead of boost
 // 2018-12-15  1082   1.0.5  use lambda instead of boost::bind
@@ -28,6 +29,7 @@
 
 #include "librtools/RosPrintf.hpp"
 #include "librtcltools/RtclContext.hpp"
+#include "librtcltools/RtclStats.hpp"
 #include "librlinktpp/RtclRlinkServer.hpp"
 #include "RtclRw11CpuW11a.hpp"
 #include "librw11/Rw11Cpu.hpp"
@@ -60,6 +62,8 @@ RtclRw11::RtclRw11(Tcl_Interp* interp, const char* name)
   AddMeth("set",      bind(&RtclRw11::M_set,     this, _1));
   AddMeth("start",    bind(&RtclRw11::M_start,   this, _1));
   AddMeth("dump",     bind(&RtclRw11::M_dump,    this, _1));
+  AddMeth("cachestats", bind(&RtclRw11::M_cachestats, this, _1));
+  AddMeth("cacheflush", bind(&RtclRw11::M_cacheflush, this, _1));
   AddMeth("$default", bind(&RtclRw11::M_default, this, _1));
 
   Rw11* pobj = &Obj();
@@ -70,6 +74,12 @@ RtclRw11::RtclRw11(Tcl_Interp* interp, const char* name)
                                bind(&Rw11VirtDisk::SetDefaultScheme, _1));
   fGets.Add<Tcl_Obj*>       ("cpus",
                                bind(&RtclRw11::CpuCommands, this));  
+
+  Rw11VirtDiskCache* pcache = &Obj().DiskCache();
+  fGets.Add<size_t>         ("cachesize",
+                               bind(&Rw11VirtDiskCache::Size, pcache));
+  fSets.Add<size_t>         ("cachesize",
+                               bind(&Rw11VirtDiskCache::SetSize, pcache, _1));
 }
 
 //------------------------------------------+-----------------------------------
@@ -156,6 +166,31 @@ int RtclRw11::M_start(RtclArgs& args)
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
 
+int RtclRw11::M_cachestats(RtclArgs& args)
+{
+  RtclStats::Context cntx;
+  if (!RtclStats::GetArgs(args, cntx)) return kERR;
+  if (!RtclStats::Exec(args, cntx, Obj().DiskCache().Stats())) return kERR;
+  return kOK;
+}
+
+//------------------------------------------+-----------------------------------
+//! Write all dirty blocks of the disk cache to the disk backends
+
+int RtclRw11::M_cacheflush(RtclArgs& args)
+{
+  if (!args.AllDone()) return kERR;
+
+  // synchronize with server thread
+  lock_guard<RlinkConnect> lock(Obj().Connect());
+  RerrMsg emsg;
+  if (!Obj().DiskCache().Flush(nullptr, emsg)) return args.Quit(emsg);
+  return kOK;
+}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
 int RtclRw11::M_dump(RtclArgs& args)
 {
   int detail=0;
@@ -1,9 +1,10 @@
 // $Id: RtclRw11.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1225   1.2    add M_cachestats,M_cacheflush
 // 2018-12-07  1078   1.1    use std::shared_ptr instead of boost
 // 2017-04-16   876   1.0.3  add CpuCommands()
 // 2017-04-02   866   1.0.2  add M_set
@@ -43,6 +44,8 @@ namespace Retro {
       int           M_get(RtclArgs& args);
       int           M_set(RtclArgs& args);
       int           M_start(RtclArgs& args);
+      int           M_cachestats(RtclArgs& args);
+      int           M_cacheflush(RtclArgs& args);
       int           M_dump(RtclArgs& args);
       int           M_default(RtclArgs& args);
 
@@ -1,9 +1,10 @@
 // $Id: RtclRw11CntlDiskBase.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2017- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2017-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1222   1.1    add get/set stream
 // 2017-04-16   878   1.0    Initial version
 // ---------------------------------------------------------------------------
 
@@ -17,6 +18,7 @@
 */
 
 #include <sstream>
+#include <functional>
 
 #include "librtools/RosPrintf.hpp"
 
@@ -32,7 +34,14 @@ template <class TC>
 inline RtclRw11CntlDiskBase<TC>::RtclRw11CntlDiskBase(const std::string& type,
                                                       const std::string& cclass)
   : RtclRw11CntlRdmaBase<TC>(type,cclass)
-{}
+{
+  TC* pobj = &this->Obj();
+  RtclGetList& gets = this->fGets;
+  RtclSetList& sets = this->fSets;
+  gets.Add<bool>    ("stream", std::bind(&TC::Stream,    pobj));
+  sets.Add<bool>    ("stream", std::bind(&TC::SetStream, pobj,
+                                         std::placeholders::_1));
+}
 
 //------------------------------------------+-----------------------------------
 //! FIXME_docs
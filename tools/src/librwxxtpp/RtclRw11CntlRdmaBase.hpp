@@ -1,9 +1,11 @@
 // $Id: RtclRw11CntlRdmaBase.hpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2017- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2017-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.1.1  add GetChunkSize()
+// 2026-10-18  1208   1.1    add SetChunkSize(string); support 'auto'
 // 2017-04-16   878   1.0    Initial version
 // ---------------------------------------------------------------------------
 
@@ -27,6 +29,8 @@ namespace Retro {
                    ~RtclRw11CntlRdmaBase();
 
     protected:
+      std::string   GetChunkSize() const;
+      void          SetChunkSize(const std::string& val);
   };
   
 } // end namespace Retro
@@ -1,9 +1,11 @@
 // $Id: RtclRw11CntlRdmaBase.ipp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2017-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2017-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.3.1  chunksize: range check, get returns 'auto'
+// 2026-10-18  1208   1.3    chunksize: accept 'auto'; add get chunkauto
 // 2019-02-23  1114   1.2.2  use std::bind instead of lambda
 // 2018-12-15  1082   1.2.1  use lambda instead of boost::bind
 // 2017-04-16   877   1.2    add class in ctor
@@ -21,10 +23,14 @@
   \brief FIXME_docs
 */
 
+#include <cstdlib>
+#include <cerrno>
+#include <string>
 #include <functional>
 
 #include "librtcltools/Rtcl.hpp"
 #include "librtcltools/RtclOPtr.hpp"
+#include "librtools/Rexception.hpp"
 
 // all method definitions in namespace Retro
 namespace Retro {
@@ -40,9 +46,12 @@ inline RtclRw11CntlRdmaBase<TC>::RtclRw11CntlRdmaBase(const std::string& type,
   TC* pobj = &this->Obj();
   RtclGetList& gets = this->fGets;
   RtclSetList& sets = this->fSets;
-  gets.Add<size_t>  ("chunksize", std::bind(&TC::ChunkSize,    pobj));
-  sets.Add<size_t>  ("chunksize", std::bind(&TC::SetChunkSize, pobj,
-                                            std::placeholders::_1));
+  gets.Add<std::string> ("chunksize", 
+                     std::bind(&RtclRw11CntlRdmaBase<TC>::GetChunkSize, this));
+  gets.Add<bool>    ("chunkauto", std::bind(&TC::ChunkAuto,    pobj));
+  sets.Add<const std::string&> ("chunksize", 
+                     std::bind(&RtclRw11CntlRdmaBase<TC>::SetChunkSize, this,
+                               std::placeholders::_1));
 }
 
 //------------------------------------------+-----------------------------------
@@ -52,5 +61,52 @@ template <class TC>
 inline RtclRw11CntlRdmaBase<TC>::~RtclRw11CntlRdmaBase()
 {}
 
+//------------------------------------------+-----------------------------------
+//! Get chunk size, returns \c auto when adaptive chunk size is enabled.
+
+template <class TC>
+inline std::string RtclRw11CntlRdmaBase<TC>::GetChunkSize() const
+{
+  TC& cntl = const_cast<RtclRw11CntlRdmaBase<TC>*>(this)->Obj();
+  if (cntl.ChunkAuto()) return "auto";
+  return std::to_string(cntl.ChunkSize());
+}
+
+//------------------------------------------+-----------------------------------
+//! Set chunk size, either a number or \c auto for adaptive chunk size.
+/*!
+  The number must be in the range 0 to the prudent block size of the
+  connection (0 selects the maximum), or 0 to 65535 before the controller
+  is started.
+ */
+
+template <class TC>
+inline void RtclRw11CntlRdmaBase<TC>::SetChunkSize(const std::string& val)
+{
+  TC& cntl = this->Obj();
+  if (val == "auto") {
+    cntl.SetChunkAuto(true);
+    return;
+  }
+
+  char* endptr;
+  errno = 0;
+  unsigned long chunk = ::strtoul(val.c_str(), &endptr, 0);
+  if (val.empty() || *endptr != 0 ||
+      val.find('-') != std::string::npos)   // strtoul accepts '-1'
+    throw Rexception("RtclRw11CntlRdmaBase::SetChunkSize()",
+                     std::string("Bad args: expect number or 'auto', got '") +
+                     val + "'");
+  unsigned long cmax = cntl.IsStarted() ? cntl.Connect().BlockSizePrudent() :
+                                          65535;
+  if (errno == ERANGE || chunk > cmax)
+    throw Rexception("RtclRw11CntlRdmaBase::SetChunkSize()",
+                     std::string("Bad args: chunk size '") + val +
+                     "' out of range 0..." + std::to_string(cmax));
+  cntl.SetChunkAuto(false);
+  cntl.SetChunkSize(size_t(chunk));
+  return;
+}
+
 
 } // end namespace Retro
@@ -1,9 +1,10 @@
 // $Id: RtclRw11Cpu.cpp 1175 2019-06-30 06:13:17Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1227   1.2.34 add memblkauto getter and setter
 // 2019-06-29  1175   1.2.33 M_ldabs(): add missing OptValid() call
 // 2019-06-07  1160   1.2.32 use RtclStats::Exec()
 // 2019-04-30  1143   1.2.31 add HasM9312() getter
@@ -1552,6 +1553,9 @@ void RtclRw11Cpu::SetupGetSet()
   fGets.Add<bool>         ("haskw11l", bind(&Rw11Cpu::HasKw11l, pobj));
   fGets.Add<bool>         ("haskw11p", bind(&Rw11Cpu::HasKw11p, pobj));
   fGets.Add<bool>         ("hasiist",  bind(&Rw11Cpu::HasIist,  pobj));
+  fGets.Add<bool>         ("memblkauto", bind(&Rw11Cpu::MemBlkAuto, pobj));
+  fSets.Add<bool>         ("memblkauto", 
+                           bind(&Rw11Cpu::SetMemBlkAuto, pobj, _1));
   return;
 }
 
@@ -1,9 +1,10 @@
 // $Id: RtclRw11UnitDisk.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2013-2019 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2013-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1226   1.3    add readahead get/set
 // 2019-02-23  1114   1.2.3  use std::bind instead of lambda
 // 2018-12-15  1082   1.2.2  use lambda instead of boost::bind
 // 2018-10-06  1053   1.2.1  move using after includes (clang warning)
@@ -64,8 +65,11 @@ void RtclRw11UnitDisk::SetupGetSet()
   fGets.Add<size_t>        ("blocksize", bind(&Rw11UnitDisk::BlockSize,  pobj));
   fGets.Add<size_t>        ("nblock",    bind(&Rw11UnitDisk::NBlock,  pobj));
   fGets.Add<bool>          ("wprot",     bind(&Rw11UnitDisk::WProt, pobj));
+  fGets.Add<size_t>        ("readahead", bind(&Rw11UnitDisk::ReadAhead, pobj));
 
   fSets.Add<const string&> ("type", bind(&Rw11UnitDisk::SetType,pobj, _1));
+  fSets.Add<size_t>        ("readahead",
+                            bind(&Rw11UnitDisk::SetReadAhead,pobj, _1));
   
   return;
 }
@@ -0,0 +1,58 @@
+// $Id: RtclRw11VirtDiskMmap.cpp 1224 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// 
+// Revision History: 
+// Date         Rev Version  Comment
+// 2026-10-18  1224   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+/*!
+  \brief   Implemenation of RtclRw11VirtDiskMmap.
+*/
+
+#include <functional>
+
+#include "RtclRw11VirtDiskMmap.hpp"
+
+using namespace std;
+using namespace std::placeholders;
+
+/*!
+  \class Retro::RtclRw11VirtDiskMmap
+  \brief FIXME_docs
+*/
+
+// all method definitions in namespace Retro
+namespace Retro {
+
+//------------------------------------------+-----------------------------------
+//! Constructor
+
+RtclRw11VirtDiskMmap::RtclRw11VirtDiskMmap(Rw11VirtDiskMmap* pobj)
+  : RtclRw11VirtBase<Rw11VirtDiskMmap>(pobj)
+{
+  AddMeth("flush", bind(&RtclRw11VirtDiskMmap::M_flush,  this, _1));
+}
+
+//------------------------------------------+-----------------------------------
+//! Destructor
+
+RtclRw11VirtDiskMmap::~RtclRw11VirtDiskMmap()
+{}
+
+//------------------------------------------+-----------------------------------
+//! FIXME_docs
+
+int RtclRw11VirtDiskMmap::M_flush(RtclArgs& args)
+{
+  if (!args.AllDone()) return kERR;
+
+  // synchronize with server thread
+  lock_guard<RlinkConnect> lock(Obj().Cpu().Connect());
+  RerrMsg emsg;
+  if (!Obj().Flush(emsg)) return args.Quit(emsg);
+  return kOK;
+}
+
+} // end namespace Retro
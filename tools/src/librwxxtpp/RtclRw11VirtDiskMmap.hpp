@@ -0,0 +1,37 @@
+// $Id: RtclRw11VirtDiskMmap.hpp 1224 2026-10-18 12:00:00Z mueller $
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// 
+// Revision History: 
+// Date         Rev Version  Comment
+// 2026-10-18  1224   1.0    Initial version
+// ---------------------------------------------------------------------------
+
+
+/*!
+  \brief   Declaration of class RtclRw11VirtDiskMmap.
+*/
+
+#ifndef included_Retro_RtclRw11VirtDiskMmap
+#define included_Retro_RtclRw11VirtDiskMmap 1
+
+#include "librw11/Rw11VirtDiskMmap.hpp"
+
+#include "RtclRw11VirtBase.hpp"
+
+namespace Retro {
+
+  class RtclRw11VirtDiskMmap : public RtclRw11VirtBase<Rw11VirtDiskMmap> {
+    public:
+                    RtclRw11VirtDiskMmap(Rw11VirtDiskMmap* pobj);
+                   ~RtclRw11VirtDiskMmap();
+
+    protected:
+      int           M_flush(RtclArgs& args);
+  };
+  
+} // end namespace Retro
+
+//#include "RtclRw11VirtDiskMmap.ipp"
+
+#endif
@@ -1,9 +1,10 @@
 // $Id: RtclRw11VirtFactory.cpp 1186 2019-07-12 17:49:59Z mueller $
 // SPDX-License-Identifier: GPL-3.0-or-later
-// Copyright 2017-2018 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+// Copyright 2017-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 // 
 // Revision History: 
 // Date         Rev Version  Comment
+// 2026-10-18  1224   2.1    add RtclRw11VirtDiskMmap
 // 2018-12-02  1076   2.0    use unique_ptr
 // 2017-03-11   589   1.0    Initial version
 // ---------------------------------------------------------------------------
@@ -13,9 +14,11 @@
 */
 
 #include "librw11/Rw11VirtDiskOver.hpp"
+#include "librw11/Rw11VirtDiskMmap.hpp"
 #include "librw11/Rw11VirtDiskRam.hpp"
 
 #include "RtclRw11VirtDiskOver.hpp"
+#include "RtclRw11VirtDiskMmap.hpp"
 #include "RtclRw11VirtDiskRam.hpp"
 
 #include "RtclRw11VirtFactory.hpp"
@@ -37,6 +40,10 @@ std::unique_ptr<RtclRw11Virt> RtclRw11VirtFactory(Rw11Virt* pobj)
   if (pdiskover) {
     return virt_uptr_t(new RtclRw11VirtDiskOver(pdiskover));
   }  
+  Rw11VirtDiskMmap* pdiskmmap = dynamic_cast<Rw11VirtDiskMmap*>(pobj);
+  if (pdiskmmap) {
+    return virt_uptr_t(new RtclRw11VirtDiskMmap(pdiskmmap));
+  }  
   Rw11VirtDiskRam* pdiskram = dynamic_cast<Rw11VirtDiskRam*>(pobj);
   if (pdiskram) {
     return virt_uptr_t(new RtclRw11VirtDiskRam(pdiskram));
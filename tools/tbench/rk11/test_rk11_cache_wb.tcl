@@ -0,0 +1,101 @@
+# $Id: test_rk11_cache_wb.tcl 1227 2026-10-18 12:00:00Z mueller $
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+#
+# Revision History:
+# Date         Rev Version  Comment
+# 2026-10-18  1227   1.0    Initial version
+#
+# Test disk write through write-back block cache (url option cache=..,wb)
+#  A: write two blocks, read them back via the cache, check data
+#  B: detach, which writes back the dirty blocks, check image file content
+#  C: attach again without cache, read blocks back, check data
+#
+# Note: needs the rlink server, which is started for this test and stopped
+#       again at the end.
+
+# ----------------------------------------------------------------------------
+rlc log "test_rk11_cache_wb: disk write via write-back block cache -----------"
+rlc log "  setup: unit 0 attached to scratch image with cache=64k,wb"
+package require ibd_rk11
+if {![rw11::setup_cntl "cpu0" "rk11" "rka"]} {
+  rlc log "  test_rk11_cache_wb-W: device not found, test aborted"
+  return
+}
+
+rlc set statmask  $rw11::STAT_DEFMASK
+rlc set statvalue 0
+
+# create empty scratch image and attach unit 0 with write-back cache
+set fname "/tmp/test_rk11_cache_wb_[pid].dsk"
+close [open $fname w]
+cpu0rka0 att "${fname}?cache=64k,wb"
+
+rls server -start
+
+# wait for rdy after function start, return final cs
+proc tmpproc_waitrdy {} {
+  for {set i 0} {$i < 100} {incr i} {
+    $::cpu cp -rma rka.cs cs
+    if {$cs & [regbld ibd_rk11::CS rdy]} {return $cs}
+    after 10
+  }
+  rlc log "  test_rk11_cache_wb-E: timeout waiting for rdy"
+  rlc errcnt -increment
+  return $cs
+}
+
+# read 2 blocks from disk address 0 into 004000 and check against wbuf
+proc tmpproc_readchk {wbuf} {
+  set zbuf {}
+  for {set i 0} {$i < 512} {incr i} { lappend zbuf 0 }
+  $::cpu cp -wal 004000 -bwm $zbuf
+  $::cpu cp -wma  rka.wc [expr {0200000 - 512}] \
+            -wma  rka.ba 004000 \
+            -wma  rka.da 0 \
+            -wma  rka.cs [regbld ibd_rk11::CS {func 2} go]
+  tmpproc_waitrdy
+  $::cpu cp -rma  rka.er -edata 0 \
+            -wal 004000 \
+            -brm 512 -edata $wbuf
+}
+
+# setup buffer
+set wbuf {}
+for {set i 0} {$i < 512} {incr i} { lappend wbuf [expr {0140000 + 5*$i}] }
+
+rlc log "  A1: write blocks 0,1 from 002000 --------------------------"
+$cpu cp -wal 002000 -bwm $wbuf
+$cpu cp -wma  rka.wc [expr {0200000 - 512}] \
+        -wma  rka.ba 002000 \
+        -wma  rka.da 0 \
+        -wma  rka.cs [regbld ibd_rk11::CS {func 1} go]
+tmpproc_waitrdy
+$cpu cp -rma  rka.er -edata 0 \
+        -rma  rka.wc -edata 0
+
+rlc log "  A2: read blocks 0,1 back via cache and check data ---------"
+tmpproc_readchk $wbuf
+
+rlc log "  B: detach, check image file content -----------------------"
+cpu0rka0 det
+set fd [open $fname r]
+fconfigure $fd -translation binary
+set data [read $fd 1024]
+close $fd
+binary scan $data su* fbuf
+if {$fbuf ne $wbuf} {
+  rlc log "  test_rk11_cache_wb-E: image content differs after detach"
+  rlc errcnt -increment
+}
+
+rlc log "  C: attach without cache, read blocks 0,1 and check data ---"
+cpu0rka0 att $fname
+tmpproc_readchk $wbuf
+
+# restore setup
+rls server -stop
+cpu0rka0 det
+file delete $fname
+rename tmpproc_waitrdy {}
+rename tmpproc_readchk {}
@@ -0,0 +1,80 @@
+# $Id: test_rk11_iothreads.tcl 1227 2026-10-18 12:00:00Z mueller $
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+#
+# Revision History:
+# Date         Rev Version  Comment
+# 2026-10-18  1227   1.0    Initial version
+#
+# Test disk write/read via backend with inline I/O (rls set iothreads 0)
+#  A: write one block, read it back, check data and error status
+#
+# Note: needs the rlink server, which is started for this test and stopped
+#       again at the end. With iothreads 0 the disk I/O and the completion
+#       of the Rdma run inline in the server thread.
+
+# ----------------------------------------------------------------------------
+rlc log "test_rk11_iothreads: disk write/read with iothreads 0 ---------------"
+rlc log "  setup: unit 0 attached to scratch image"
+package require ibd_rk11
+if {![rw11::setup_cntl "cpu0" "rk11" "rka"]} {
+  rlc log "  test_rk11_iothreads-W: device not found, test aborted"
+  return
+}
+
+rlc set statmask  $rw11::STAT_DEFMASK
+rlc set statvalue 0
+
+# create empty scratch image and attach unit 0
+set fname "/tmp/test_rk11_iothreads_[pid].dsk"
+close [open $fname w]
+cpu0rka0 att $fname
+
+set iothreads [rls get iothreads]
+rls set iothreads 0
+rls server -start
+
+# wait for rdy after function start, return final cs
+proc tmpproc_waitrdy {} {
+  for {set i 0} {$i < 100} {incr i} {
+    $::cpu cp -rma rka.cs cs
+    if {$cs & [regbld ibd_rk11::CS rdy]} {return $cs}
+    after 10
+  }
+  rlc log "  test_rk11_iothreads-E: timeout waiting for rdy"
+  rlc errcnt -increment
+  return $cs
+}
+
+# setup buffers
+set wbuf {}
+for {set i 0} {$i < 256} {incr i} { lappend wbuf [expr {0100000 + 3*$i}] }
+set zbuf {}
+for {set i 0} {$i < 256} {incr i} { lappend zbuf 0 }
+
+rlc log "  A1: write block 0 from 002000 -----------------------------"
+$cpu cp -wal 002000 -bwm $wbuf
+$cpu cp -wma  rka.wc [expr {0200000 - 256}] \
+        -wma  rka.ba 002000 \
+        -wma  rka.da 0 \
+        -wma  rka.cs [regbld ibd_rk11::CS {func 1} go]
+set cs [tmpproc_waitrdy]
+$cpu cp -rma  rka.er -edata 0 \
+        -rma  rka.wc -edata 0
+
+rlc log "  A2: read block 0 into 004000 and check data ---------------"
+$cpu cp -wal 004000 -bwm $zbuf
+$cpu cp -wma  rka.wc [expr {0200000 - 256}] \
+        -wma  rka.ba 004000 \
+        -wma  rka.da 0 \
+        -wma  rka.cs [regbld ibd_rk11::CS {func 2} go]
+set cs [tmpproc_waitrdy]
+$cpu cp -rma  rka.er -edata 0 \
+        -wal 004000 \
+        -brm 256 -edata $wbuf
+
+# restore setup
+rls server -stop
+rls set iothreads $iothreads
+cpu0rka0 det
+file delete $fname
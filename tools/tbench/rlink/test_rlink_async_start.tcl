@@ -0,0 +1,92 @@
+# $Id: test_rlink_async_start.tcl 1227 2026-10-18 12:00:00Z mueller $
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+#
+# Revision History:
+# Date         Rev Version  Comment
+# 2026-10-18  1227   1.0    Initial version
+#
+# Test ExecAsync() lists sent while the server is not active
+#  A: send lists via 'exec -async' with server stopped, they stay in flight
+#  B: start server, all lists must complete without timeout
+#  C: send lists with server active, must complete
+#  D: send lists with response latency above timeout and server active,
+#     the server deadline timer must abort them
+#
+# Note: uses an additional sim: connection with 20 ms response latency.
+
+# ----------------------------------------------------------------------------
+rlc log "test_rlink_async_start: ExecAsync lists sent before server start ----"
+package require rlink
+
+# get value of connection statistics counter
+proc tmpproc_stat {rlc name} {
+  foreach pair [$rlc stats -lpair] {
+    lassign $pair val key
+    if {$key eq $name} { return $val }
+  }
+  return -1
+}
+
+# wait till all ExecAsync lists completed, return remaining count
+proc tmpproc_waitpend {rlc} {
+  for {set i 0} {$i < 200} {incr i} {
+    if {[$rlc get asyncpend] == 0} break
+    after 10
+  }
+  return [$rlc get asyncpend]
+}
+
+rlinkconnect rlcsa
+rlcsa open "sim:?lat=20000"
+rlinkserver rlssa rlcsa
+rlcsa set timeout 2.
+
+rlc log "  A: send 3 lists with server stopped"
+for {set i 0} {$i < 3} {incr i} { rlcsa exec -async -rreg 0xffe4 }
+set npend [rlcsa get asyncpend]
+if {$npend != 3} {
+  rlc log "  test_rlink_async_start-E: A: asyncpend $npend, expected 3"
+  rlc errcnt -inc
+}
+
+rlc log "  B: start server, lists must complete"
+rlssa server -start
+set npend [tmpproc_waitpend rlcsa]
+if {$npend != 0} {
+  rlc log "  test_rlink_async_start-E: B: asyncpend $npend after start"
+  rlc errcnt -inc
+}
+
+rlc log "  C: send 3 lists with server active"
+for {set i 0} {$i < 3} {incr i} { rlcsa exec -async -rreg 0xffe4 }
+set npend [tmpproc_waitpend rlcsa]
+if {$npend != 0} {
+  rlc log "  test_rlink_async_start-E: C: asyncpend $npend"
+  rlc errcnt -inc
+}
+set ntout [tmpproc_stat rlcsa NExecAsyncTout]
+if {$ntout != 0} {
+  rlc log "  test_rlink_async_start-E: C: NExecAsyncTout $ntout, expected 0"
+  rlc errcnt -inc
+}
+
+rlc log "  D: latency above timeout, server timer must abort lists"
+rlcsa set timeout 0.005
+rlcsa exec -async -rreg 0xffe4
+rlcsa exec -async -rreg 0xffe4
+set npend [tmpproc_waitpend rlcsa]
+set ntout [tmpproc_stat rlcsa NExecAsyncTout]
+if {$npend != 0 || $ntout < 1} {
+  rlc log "  test_rlink_async_start-E: D: asyncpend $npend, NExecAsyncTout\
+           $ntout"
+  rlc errcnt -inc
+}
+
+rlssa server -stop
+
+# cleanup; server first, it refers to the connection
+rename rlssa {}
+rename rlcsa {}
+rename tmpproc_stat {}
+rename tmpproc_waitpend {}
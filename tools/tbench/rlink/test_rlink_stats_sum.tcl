@@ -0,0 +1,72 @@
+# $Id: test_rlink_stats_sum.tcl 1227 2026-10-18 12:00:00Z mueller $
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright 2026- by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+#
+# Revision History:
+# Date         Rev Version  Comment
+# 2026-10-18  1227   1.0    Initial version
+#
+# Test rlink::stats_sum with two additional sim: connections
+#  A: run some commands via the servers of two sim: connections
+#  B: check stats_sum against the sum of the per server statistics
+#
+# Note: all servers must be stopped while the statistics are compared.
+
+# ----------------------------------------------------------------------------
+rlc log "test_rlink_stats_sum: rlink::stats_sum over two sim: connections ----"
+package require rlink
+
+rlc log "  A: run commands via two sim: servers"
+rlinkconnect rlcsa
+rlinkconnect rlcsb
+rlcsa open sim:
+rlcsb open sim:
+rlinkserver rlssa rlcsa
+rlinkserver rlssb rlcsb
+rlssa server -start
+rlssb server -start
+rlcsa exec -rreg 0xffe4 d
+for {set i 0} {$i < 3} {incr i} { rlcsb exec -rreg 0xffe4 d }
+rlssa server -stop
+rlssb server -stop
+
+rlc log "  B: check stats_sum"
+array set exp {}
+foreach srv [rlinkserver] {
+  foreach pair [$srv stats -lpair] {
+    lassign $pair val name
+    if {![info exists exp($name)]} {
+      set exp($name) $val
+    } elseif {[string match "TActnMax*" $name]} {
+      if {$val > $exp($name)} { set exp($name) $val }
+    } else {
+      set exp($name) [expr {$exp($name) + $val}]
+    }
+  }
+}
+
+set sum [rlink::stats_sum]
+if {[llength $sum] != [array size exp]} {
+  rlc log "  test_rlink_stats_sum-E: got [llength $sum] entries,\
+           expected [array size exp]"
+  rlc errcnt -inc
+}
+foreach pair $sum {
+  lassign $pair val name
+  if {![info exists exp($name)] || ![string is double -strict $val] ||
+      $val != $exp($name)} {
+    rlc log "  test_rlink_stats_sum-E: bad entry '$pair'"
+    rlc errcnt -inc
+  }
+}
+# each sim: server saw at least one rlink data event
+if {$exp(NRlinkEvt) < 2} {
+  rlc log "  test_rlink_stats_sum-E: NRlinkEvt $exp(NRlinkEvt) < 2"
+  rlc errcnt -inc
+}
+
+# cleanup; server first, it refers to the connection
+rename rlssa {}
+rename rlssb {}
+rename rlcsa {}
+rename rlcsb {}
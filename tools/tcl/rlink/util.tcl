@@ -1,9 +1,11 @@
 # $Id: util.tcl 1177 2019-06-30 12:34:07Z mueller $
 # SPDX-License-Identifier: GPL-3.0-or-later
-# Copyright 2011-2017 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
+# Copyright 2011-2026 by Walter F.J. Mueller <W.F.J.Mueller@gsi.de>
 #
 #  Revision History:
 # Date         Rev Version  Comment
+# 2026-10-18  1227   2.2.1  stats_sum: BUGFIX: -lpair gives value/name pairs
+# 2026-10-18  1219   2.2    add servers, stats_sum (multi-board setups)
 # 2017-04-22   883   2.1.1  add amap_reg2addr
 # 2016-04-02   758   2.1    add USR_ACCESS register support (RLUA0/RLUA1)
 # 2014-12-21   617   2.0.1  add rbtout definition in STAT
@@ -132,4 +134,41 @@ namespace eval rlink {
     }
   }
 
+  #
+  # servers: returns list of {server connect} for all rlinkserver objects ----
+  # 
+  proc servers {} {
+    set rval {}
+    foreach srv [lsort [rlinkserver]] {
+      lappend rval [list $srv [$srv get conn]]
+    }
+    return $rval
+  }
+
+  #
+  # stats_sum: sum of statistics of all rlinkserver objects ------------------
+  #   returns value/name list like 'rls stats -lpair'; counters are summed
+  #   up, the TActnMax* values give the maximum over all servers.
+  # 
+  proc stats_sum {} {
+    set names {}
+    array set sum {}
+    foreach srv [rlinkserver] {
+      foreach pair [$srv stats -lpair] {
+        lassign $pair val name
+        if {![info exists sum($name)]} {
+          lappend names $name
+          set sum($name) $val
+        } elseif {[string match "TActnMax*" $name]} {
+          if {$val > $sum($name)} { set sum($name) $val }
+        } else {
+          set sum($name) [expr {$sum($name) + $val}]
+        }
+      }
+    }
+    set rval {}
+    foreach name $names { lappend rval [list $sum($name) $name] }
+    return $rval
+  }
+
 }